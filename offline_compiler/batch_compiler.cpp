@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "offline_compiler/batch_compiler.h"
+#include "runtime/helpers/file_io.h"
+#include "runtime/os_interface/os_library.h"
+#include <CL/cl.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace OCLRT {
+
+bool stringsAreEqual(const char *string1, const char *string2);
+
+////////////////////////////////////////////////////////////////////////////////
+// ctor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// dtor
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler::~BatchCompiler() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// Create
+////////////////////////////////////////////////////////////////////////////////
+BatchCompiler *BatchCompiler::create(uint32_t numArgs, const char **argv, int &retVal) {
+    retVal = CL_SUCCESS;
+    auto pBatchCompiler = new BatchCompiler();
+
+    if (pBatchCompiler) {
+        retVal = pBatchCompiler->initialize(numArgs, argv);
+    }
+
+    if (retVal != CL_SUCCESS) {
+        delete pBatchCompiler;
+        pBatchCompiler = nullptr;
+    }
+
+    return pBatchCompiler;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// IsBatchCommandLine
+////////////////////////////////////////////////////////////////////////////////
+bool BatchCompiler::isBatchCommandLine(uint32_t numArgs, const char **argv) {
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if (stringsAreEqual("-batch", argv[argIndex])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Initialize
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::initialize(uint32_t numArgs, const char **argv) {
+    int retVal = parseCommandLine(numArgs, argv);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    void *pManifest = nullptr;
+    size_t manifestSize = loadDataFromFile(manifestFile.c_str(), pManifest);
+    std::string manifest = (manifestSize > 0) ? std::string(static_cast<char *>(pManifest), manifestSize) : "";
+    deleteDataReadFromFile(pManifest);
+    if (manifestSize == 0) {
+        printf("Error: Cannot read batch manifest %s.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+
+    retVal = parseManifest(manifest);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    return loadLibraries();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseCommandLine
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
+    int retVal = CL_SUCCESS;
+
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if ((stringsAreEqual(argv[argIndex], "-batch")) &&
+            (argIndex + 1 < numArgs)) {
+            manifestFile = argv[argIndex + 1];
+            argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-summary")) &&
+                   (argIndex + 1 < numArgs)) {
+            summaryFile = argv[argIndex + 1];
+            argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-threads")) &&
+                   (argIndex + 1 < numArgs)) {
+            numThreads = static_cast<uint32_t>(atoi(argv[argIndex + 1]));
+            argIndex++;
+        } else if (stringsAreEqual(argv[argIndex], "-file") ||
+                   stringsAreEqual(argv[argIndex], "-device") ||
+                   stringsAreEqual(argv[argIndex], "-options")) {
+            printf("Error: %s is given per job in the batch manifest.\n", argv[argIndex]);
+            retVal = INVALID_COMMAND_LINE;
+            break;
+        } else if (stringsAreEqual(argv[argIndex], "-?")) {
+            printUsage();
+            retVal = PRINT_USAGE;
+            break;
+        } else {
+            // everything else is forwarded to each job's compiler
+            if (stringsAreEqual(argv[argIndex], "-q")) {
+                quiet = true;
+            } else if (stringsAreEqual(argv[argIndex], "-out_dir") && (argIndex + 1 < numArgs)) {
+                outputDirectory = argv[argIndex + 1];
+            } else if (stringsAreEqual(argv[argIndex], "-output") && (argIndex + 1 < numArgs)) {
+                outputFile = argv[argIndex + 1];
+            } else if (stringsAreEqual(argv[argIndex], "-options_name")) {
+                useOptionsSuffix = true;
+            }
+            commonArgs.push_back(argv[argIndex]);
+        }
+    }
+
+    if (retVal == CL_SUCCESS) {
+        if (manifestFile.empty()) {
+            printf("Error: Batch manifest file name missing.\n");
+            retVal = INVALID_COMMAND_LINE;
+        } else if (!fileExists(manifestFile)) {
+            printf("Error: Batch manifest %s missing.\n", manifestFile.c_str());
+            retVal = INVALID_FILE;
+        }
+    }
+
+    if (numThreads == 0) {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    if (summaryFile.empty()) {
+        summaryFile = (outputDirectory.empty() ? "" : outputDirectory + "/") + "batch_summary.txt";
+    }
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseManifest
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::parseManifest(const std::string &manifest) {
+    std::istringstream manifestStream(manifest);
+    std::string line;
+    uint32_t lineNumber = 0;
+    jobs.clear();
+
+    // each line: <device> <file> [options...]; empty lines and lines starting with '#' are skipped
+    while (std::getline(manifestStream, line)) {
+        lineNumber++;
+        auto end = line.find_last_not_of(" \t\r");
+        line = (end == std::string::npos) ? "" : line.substr(0, end + 1);
+        auto begin = line.find_first_not_of(" \t");
+        if (begin == std::string::npos || line[begin] == '#') {
+            continue;
+        }
+
+        std::istringstream lineStream(line.substr(begin));
+        BatchJob job;
+        job.manifestLine = lineNumber;
+        lineStream >> job.deviceName >> job.inputFile;
+        if (job.inputFile.empty()) {
+            printf("Error: Batch manifest line %u must name a device and an input file.\n", lineNumber);
+            return INVALID_FILE;
+        }
+        std::getline(lineStream, job.options);
+        auto optionsBegin = job.options.find_first_not_of(" \t");
+        job.options = (optionsBegin == std::string::npos) ? "" : job.options.substr(optionsBegin);
+
+        jobs.push_back(job);
+    }
+
+    if (jobs.empty()) {
+        printf("Error: Batch manifest %s contains no jobs.\n", manifestFile.c_str());
+        return INVALID_FILE;
+    }
+
+    // jobs run in parallel, two of them writing the same output files would overwrite each other
+    std::map<std::string, uint32_t> outputsByLine;
+    for (auto &job : jobs) {
+        auto output = outputsByLine.insert(std::make_pair(getOutputFileBase(job), job.manifestLine));
+        if (!output.second) {
+            printf("Error: Batch manifest lines %u and %u write the same output %s, use -options_name with different options.\n",
+                   output.first->second, job.manifestLine, output.first->first.c_str());
+            jobs.clear();
+            return INVALID_FILE;
+        }
+    }
+
+    results.resize(jobs.size());
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// GetOutputFileBase
+////////////////////////////////////////////////////////////////////////////////
+std::string BatchCompiler::getOutputFileBase(const BatchJob &job) const {
+    // mirrors the names given by OfflineCompiler::writeOutAllFiles
+    std::string fileBase = (outputFile.empty() ? OfflineCompiler::getFileNameTrunk(job.inputFile) : outputFile) + "_" + job.deviceName;
+    if (useOptionsSuffix) {
+        std::string opts(job.options);
+        std::replace(opts.begin(), opts.end(), ' ', '_');
+        fileBase.append(opts);
+    }
+    return fileBase;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// LoadLibraries
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::loadLibraries() {
+    libraries.reset(new OfflineCompilerLibraries());
+    int retVal = libraries->load();
+    if (retVal != CL_SUCCESS) {
+        printf("Error: Cannot load compiler libraries.\n");
+        libraries.reset();
+    }
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BuildJob
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::buildJob(const BatchJob &job, BatchJobResult &result) {
+    std::vector<const char *> argv = {"cloc", "-file", job.inputFile.c_str(), "-device", job.deviceName.c_str(), "-q"};
+    if (!job.options.empty()) {
+        argv.push_back("-options");
+        argv.push_back(job.options.c_str());
+    }
+    for (auto &arg : commonArgs) {
+        argv.push_back(arg.c_str());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        std::unique_ptr<OfflineCompiler> pCompiler(OfflineCompiler::create(static_cast<uint32_t>(argv.size()), argv.data(), libraries, result.retVal));
+        if (result.retVal == CL_SUCCESS) {
+            result.retVal = pCompiler->build();
+            result.buildLog = pCompiler->getBuildLog();
+        }
+    } catch (...) {
+        result.retVal = CL_OUT_OF_HOST_MEMORY;
+    }
+    result.buildTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build
+////////////////////////////////////////////////////////////////////////////////
+int BatchCompiler::build() {
+    std::atomic<size_t> nextJob{0};
+    auto worker = [&]() {
+        for (size_t jobId = nextJob++; jobId < jobs.size(); jobId = nextJob++) {
+            buildJob(jobs[jobId], results[jobId]);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    size_t threadsToStart = std::min(static_cast<size_t>(numThreads), jobs.size());
+    for (size_t i = 1; i < threadsToStart; i++) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    totalTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    int retVal = CL_SUCCESS;
+    for (size_t jobId = 0; jobId < jobs.size(); jobId++) {
+        if (!results[jobId].buildLog.empty()) {
+            printf("%s (%s):\n%s\n", jobs[jobId].inputFile.c_str(), jobs[jobId].deviceName.c_str(), results[jobId].buildLog.c_str());
+        }
+        if (results[jobId].retVal != CL_SUCCESS) {
+            printf("Build of %s for %s failed with error code: %d\n", jobs[jobId].inputFile.c_str(), jobs[jobId].deviceName.c_str(), results[jobId].retVal);
+            retVal = CL_BUILD_PROGRAM_FAILURE;
+        }
+    }
+
+    std::string summary = createSummary();
+    auto slashPos = summaryFile.find_last_of("/\\");
+    if (slashPos != std::string::npos) {
+        createDirectoryTree(summaryFile.substr(0, slashPos));
+    }
+    if (writeDataToFile(summaryFile.c_str(), summary.c_str(), summary.size()) == 0) {
+        printf("Error: Cannot write batch summary %s.\n", summaryFile.c_str());
+        retVal = (retVal == CL_SUCCESS) ? INVALID_FILE : retVal;
+    }
+    if (!isQuiet()) {
+        printf("%s", summary.c_str());
+    }
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// CreateSummary
+////////////////////////////////////////////////////////////////////////////////
+std::string BatchCompiler::createSummary() const {
+    std::ostringstream out;
+    size_t failedJobs = 0;
+
+    out << std::fixed << std::setprecision(3);
+    out << "line\tdevice\tfile\tstatus\terror\ttime_ms\toptions\n";
+    for (size_t jobId = 0; jobId < jobs.size(); jobId++) {
+        auto &job = jobs[jobId];
+        auto &result = results[jobId];
+        bool succeeded = (result.retVal == CL_SUCCESS);
+        failedJobs += succeeded ? 0 : 1;
+        out << job.manifestLine << "\t" << job.deviceName << "\t" << job.inputFile << "\t"
+            << (succeeded ? "ok" : "failed") << "\t" << result.retVal << "\t"
+            << result.buildTimeMs << "\t" << job.options << "\n";
+    }
+    out << "# jobs: " << jobs.size() << ", failed: " << failedJobs << ", threads: "
+        << std::min(static_cast<size_t>(numThreads), jobs.size()) << ", total_ms: " << totalTimeMs << "\n";
+
+    return out.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PrintUsage
+////////////////////////////////////////////////////////////////////////////////
+void BatchCompiler::printUsage() {
+    printf("Compiles every job listed in a manifest, sharing one set of loaded compiler libraries\n\n");
+    printf("cloc -batch <manifest> [-threads <count>] [-summary <filename>] [OPTIONS]\n\n");
+    printf("  -batch <manifest>            Manifest with one job per line: <device_type> <filename> [options].\n");
+    printf("                               Empty lines and lines starting with # are ignored.\n");
+    printf("                               Jobs building the same file for the same device need\n");
+    printf("                               -options_name and different options.\n");
+    printf("  -threads <count>             Number of jobs compiled in parallel, defaults to hardware threads.\n");
+    printf("  -summary <filename>          Per-job status and timing report, defaults to\n");
+    printf("                               <output_dir>/batch_summary.txt.\n");
+    printf("\n");
+    printf("  Remaining cloc options (e.g. -out_dir, -64, -internal_options) apply to every job.\n");
+}
+} // namespace OCLRT
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "offline_compiler/offline_compiler.h"
+#include <CL/cl.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+struct BatchJob {
+    std::string deviceName;
+    std::string inputFile;
+    std::string options;
+    uint32_t manifestLine = 0;
+};
+
+struct BatchJobResult {
+    int retVal = CL_SUCCESS;
+    double buildTimeMs = 0.0;
+    std::string buildLog;
+};
+
+class BatchCompiler {
+  public:
+    static BatchCompiler *create(uint32_t numArgs, const char **argv, int &retVal);
+    static bool isBatchCommandLine(uint32_t numArgs, const char **argv);
+    int build();
+    void printUsage();
+
+    BatchCompiler &operator=(const BatchCompiler &) = delete;
+    BatchCompiler(const BatchCompiler &) = delete;
+    ~BatchCompiler();
+
+    bool isQuiet() const {
+        return quiet;
+    }
+
+    const std::vector<BatchJob> &getJobs() const {
+        return jobs;
+    }
+
+    const std::vector<BatchJobResult> &getResults() const {
+        return results;
+    }
+
+  protected:
+    BatchCompiler();
+
+    int initialize(uint32_t numArgs, const char **argv);
+    int parseCommandLine(uint32_t numArgs, const char **argv);
+    int parseManifest(const std::string &manifest);
+    int loadLibraries();
+    void buildJob(const BatchJob &job, BatchJobResult &result);
+    std::string getOutputFileBase(const BatchJob &job) const;
+    std::string createSummary() const;
+
+    std::string manifestFile;
+    std::string summaryFile;
+    std::string outputDirectory;
+    std::string outputFile;
+    bool useOptionsSuffix = false;
+    std::vector<std::string> commonArgs;
+    uint32_t numThreads = 0;
+    bool quiet = false;
+
+    std::vector<BatchJob> jobs;
+    std::vector<BatchJobResult> results;
+    double totalTimeMs = 0.0;
+
+    std::shared_ptr<OfflineCompilerLibraries> libraries = nullptr;
+};
+} // namespace OCLRT
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "offline_compiler/cache_verifier.h"
+#include "offline_compiler/offline_compiler.h"
+#include "runtime/utilities/directory.h"
+#include <CL/cl.h>
+#include <cstdio>
+
+namespace OCLRT {
+
+bool stringsAreEqual(const char *string1, const char *string2);
+std::string getDevicesTypes();
+
+////////////////////////////////////////////////////////////////////////////////
+// ctor
+////////////////////////////////////////////////////////////////////////////////
+CacheVerifier::CacheVerifier() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// dtor
+////////////////////////////////////////////////////////////////////////////////
+CacheVerifier::~CacheVerifier() = default;
+
+////////////////////////////////////////////////////////////////////////////////
+// Create
+////////////////////////////////////////////////////////////////////////////////
+CacheVerifier *CacheVerifier::create(uint32_t numArgs, const char **argv, int &retVal) {
+    retVal = CL_SUCCESS;
+    auto pCacheVerifier = new CacheVerifier();
+
+    if (pCacheVerifier) {
+        retVal = pCacheVerifier->parseCommandLine(numArgs, argv);
+    }
+
+    if (retVal != CL_SUCCESS) {
+        delete pCacheVerifier;
+        pCacheVerifier = nullptr;
+    }
+
+    return pCacheVerifier;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// IsVerifyCommandLine
+////////////////////////////////////////////////////////////////////////////////
+bool CacheVerifier::isVerifyCommandLine(uint32_t numArgs, const char **argv) {
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if (stringsAreEqual("-verify_cache", argv[argIndex])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ParseCommandLine
+////////////////////////////////////////////////////////////////////////////////
+int CacheVerifier::parseCommandLine(uint32_t numArgs, const char **argv) {
+    int retVal = CL_SUCCESS;
+
+    for (uint32_t argIndex = 1; argIndex < numArgs; argIndex++) {
+        if ((stringsAreEqual(argv[argIndex], "-verify_cache")) &&
+            (argIndex + 1 < numArgs)) {
+            cacheDirectory = argv[argIndex + 1];
+            argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-device")) &&
+                   (argIndex + 1 < numArgs)) {
+            deviceName = argv[argIndex + 1];
+            argIndex++;
+        } else if (stringsAreEqual(argv[argIndex], "-prune")) {
+            prune = true;
+        } else if (stringsAreEqual(argv[argIndex], "-q")) {
+            quiet = true;
+        } else if (stringsAreEqual(argv[argIndex], "-?")) {
+            printUsage();
+            retVal = PRINT_USAGE;
+            break;
+        } else {
+            printf("Invalid option (arg %d): %s\n", argIndex, argv[argIndex]);
+            retVal = INVALID_COMMAND_LINE;
+            break;
+        }
+    }
+
+    if (retVal == CL_SUCCESS) {
+        if (cacheDirectory.empty()) {
+            printf("Error: Cache directory missing.\n");
+            retVal = INVALID_COMMAND_LINE;
+        } else if (!deviceName.empty()) {
+            hwInfo = OfflineCompiler::findHardwareInfo(deviceName.c_str());
+            if (hwInfo == nullptr) {
+                printf("Error: Cannot get HW Info for device %s.\n", deviceName.c_str());
+                retVal = CL_INVALID_DEVICE;
+            }
+        }
+    }
+
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Verify
+////////////////////////////////////////////////////////////////////////////////
+int CacheVerifier::verify() {
+    static const std::string cacheFileExtension = ".cl_cache";
+    size_t numVerified = 0;
+    size_t numInvalid = 0;
+
+    for (auto &path : Directory::getFiles(cacheDirectory)) {
+        if (path.size() < cacheFileExtension.size() ||
+            path.compare(path.size() - cacheFileExtension.size(), cacheFileExtension.size(), cacheFileExtension) != 0) {
+            continue;
+        }
+
+        auto status = BinaryCache::verifyCacheFile(path, hwInfo);
+        numEntries[static_cast<size_t>(status)]++;
+        numVerified++;
+        if (status == CacheFileStatus::Valid) {
+            continue;
+        }
+        // another device may share the directory and load the entry, it is reported but never pruned
+        if (status == CacheFileStatus::OtherDevice) {
+            if (!isQuiet()) {
+                printf("%s: %s\n", path.c_str(), BinaryCache::getCacheFileStatusName(status));
+            }
+            continue;
+        }
+
+        numInvalid++;
+        bool removed = prune && (std::remove(path.c_str()) == 0);
+        numRemoved += removed ? 1 : 0;
+        printf("%s: %s%s\n", path.c_str(), BinaryCache::getCacheFileStatusName(status), removed ? ", removed" : "");
+    }
+
+    if (!isQuiet()) {
+        printf("Verified %zu cache entries: %zu valid, %zu other device, %zu stale key, %zu corrupted, %zu unloadable, %zu removed\n",
+               numVerified,
+               getNumEntries(CacheFileStatus::Valid),
+               getNumEntries(CacheFileStatus::OtherDevice),
+               getNumEntries(CacheFileStatus::StaleKey),
+               getNumEntries(CacheFileStatus::Corrupted),
+               getNumEntries(CacheFileStatus::Unloadable),
+               numRemoved);
+    }
+
+    return (numInvalid == numRemoved) ? CL_SUCCESS : INVALID_FILE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PrintUsage
+////////////////////////////////////////////////////////////////////////////////
+void CacheVerifier::printUsage() {
+    printf("Checks a binary cache directory for entries the runtime would not load\n\n");
+    printf("cloc -verify_cache <cache_dir> [-device <device_type>] [-prune] [-q]\n\n");
+    printf("  -verify_cache <cache_dir>    Indicates the binary cache directory to be checked.\n");
+    printf("  -device <device_type>        Also reports entries built for another device, they are never removed.\n");
+    printf("                               <device_type> can be: %s\n", getDevicesTypes().c_str());
+    printf("  -prune                       Removes stale, corrupted and unloadable entries.\n");
+    printf("  -q                           Be more quiet. print only invalid entries.\n");
+}
+} // namespace OCLRT
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/compiler_interface/binary_cache.h"
+#include <cstdint>
+#include <string>
+
+namespace OCLRT {
+
+struct HardwareInfo;
+
+class CacheVerifier {
+  public:
+    static CacheVerifier *create(uint32_t numArgs, const char **argv, int &retVal);
+    static bool isVerifyCommandLine(uint32_t numArgs, const char **argv);
+    int verify();
+    void printUsage();
+
+    CacheVerifier &operator=(const CacheVerifier &) = delete;
+    CacheVerifier(const CacheVerifier &) = delete;
+    ~CacheVerifier();
+
+    bool isQuiet() const {
+        return quiet;
+    }
+
+    size_t getNumEntries(CacheFileStatus status) const {
+        return numEntries[static_cast<size_t>(status)];
+    }
+
+  protected:
+    CacheVerifier();
+
+    int parseCommandLine(uint32_t numArgs, const char **argv);
+
+    std::string cacheDirectory;
+    std::string deviceName;
+    const HardwareInfo *hwInfo = nullptr;
+    bool prune = false;
+    bool quiet = false;
+
+    size_t numEntries[static_cast<size_t>(CacheFileStatus::OtherDevice) + 1] = {};
+    size_t numRemoved = 0;
+};
+} // namespace OCLRT
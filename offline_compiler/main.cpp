@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -22,6 +22,8 @@
 
 #include "config.h"
 
+#include "offline_compiler/batch_compiler.h"
+#include "offline_compiler/cache_verifier.h"
 #include "offline_compiler/offline_compiler.h"
 #include "runtime/os_interface/os_library.h"
 
@@ -31,6 +33,25 @@ using namespace OCLRT;
 
 int main(int numArgs, const char *argv[]) {
     int retVal = CL_SUCCESS;
+
+    if (CacheVerifier::isVerifyCommandLine(numArgs, argv)) {
+        CacheVerifier *pCacheVerifier = CacheVerifier::create(numArgs, argv, retVal);
+        if (retVal == CL_SUCCESS) {
+            retVal = pCacheVerifier->verify();
+        }
+        delete pCacheVerifier;
+        return retVal;
+    }
+
+    if (BatchCompiler::isBatchCommandLine(numArgs, argv)) {
+        BatchCompiler *pBatchCompiler = BatchCompiler::create(numArgs, argv, retVal);
+        if (retVal == CL_SUCCESS) {
+            retVal = pBatchCompiler->build();
+        }
+        delete pBatchCompiler;
+        return retVal;
+    }
+
     OfflineCompiler *pCompiler = OfflineCompiler::create(numArgs, argv, retVal);
 
     if (retVal == CL_SUCCESS) {
@@ -29,6 +29,7 @@
 #include "ocl_igc_interface/platform_helper.h"
 #include "offline_compiler.h"
 #include "igfxfmid.h"
+#include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc_base.h"
@@ -105,11 +106,15 @@ OfflineCompiler::~OfflineCompiler() {
 // Create
 ////////////////////////////////////////////////////////////////////////////////
 OfflineCompiler *OfflineCompiler::create(uint32_t numArgs, const char **argv, int &retVal) {
+    return create(numArgs, argv, nullptr, retVal);
+}
+
+OfflineCompiler *OfflineCompiler::create(uint32_t numArgs, const char **argv, const std::shared_ptr<OfflineCompilerLibraries> &sharedLibraries, int &retVal) {
     retVal = CL_SUCCESS;
     auto pOffCompiler = new OfflineCompiler();
 
     if (pOffCompiler) {
-        retVal = pOffCompiler->initialize(numArgs, argv);
+        retVal = pOffCompiler->initialize(numArgs, argv, sharedLibraries);
     }
 
     if (retVal != CL_SUCCESS) {
@@ -138,9 +143,13 @@ int OfflineCompiler::buildSourceCode() {
 
         if (!inputFileLlvm) {
             IGC::CodeType::CodeType_t intermediateRepresentation = useLlvmText ? IGC::CodeType::llvmLl : IGC::CodeType::llvmBc;
-            auto fclSrc = CIF::Builtins::CreateConstBuffer(fclMain.get(), sourceCode.c_str(), sourceCode.size());
-            auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), options.c_str(), options.size());
-            auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), internalOptions.c_str(), internalOptions.size());
+            CIF::RAII::UPtr_t<CIF::Builtins::BufferSimple> fclSrc, fclOptions, fclInternalOptions;
+            {
+                std::lock_guard<std::mutex> lock(libraries->mainMutex);
+                fclSrc = CIF::Builtins::CreateConstBuffer(libraries->fclMain.get(), sourceCode.c_str(), sourceCode.size());
+                fclOptions = CIF::Builtins::CreateConstBuffer(libraries->fclMain.get(), options.c_str(), options.size());
+                fclInternalOptions = CIF::Builtins::CreateConstBuffer(libraries->fclMain.get(), internalOptions.c_str(), internalOptions.size());
+            }
 
             auto fclTranslationCtx = fclDeviceCtx->CreateTranslationCtx(IGC::CodeType::oclC, intermediateRepresentation);
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(intermediateRepresentation, IGC::CodeType::oclGenBin);
@@ -176,9 +185,13 @@ int OfflineCompiler::buildSourceCode() {
                                                      nullptr, 0);
 
         } else {
-            auto igcSrc = CIF::Builtins::CreateConstBuffer(igcMain.get(), sourceCode.c_str(), sourceCode.size());
-            auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), nullptr, 0);
-            auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), internalOptions.c_str(), internalOptions.size());
+            CIF::RAII::UPtr_t<CIF::Builtins::BufferSimple> igcSrc, igcOptions, igcInternalOptions;
+            {
+                std::lock_guard<std::mutex> lock(libraries->mainMutex);
+                igcSrc = CIF::Builtins::CreateConstBuffer(libraries->igcMain.get(), sourceCode.c_str(), sourceCode.size());
+                igcOptions = CIF::Builtins::CreateConstBuffer(libraries->igcMain.get(), nullptr, 0);
+                igcInternalOptions = CIF::Builtins::CreateConstBuffer(libraries->igcMain.get(), internalOptions.c_str(), internalOptions.size());
+            }
             auto igcTranslationCtx = igcDeviceCtx->CreateTranslationCtx(IGC::CodeType::llvmLl, IGC::CodeType::oclGenBin);
             igcOutput = igcTranslationCtx->Translate(igcSrc.get(), igcOptions.get(), igcInternalOptions.get(), nullptr, 0);
         }
@@ -207,6 +220,11 @@ int OfflineCompiler::build() {
     if (retVal == CL_SUCCESS) {
         generateElfBinary();
         writeOutAllFiles();
+
+        if (!cacheDirectory.empty() && !writeCacheEntry()) {
+            printf("Error: Cannot write binary cache entry to %s.\n", cacheDirectory.c_str());
+            retVal = INVALID_FILE;
+        }
     }
 
     return retVal;
@@ -237,19 +255,23 @@ std::string &OfflineCompiler::getBuildLog() {
 // getHardwareInfo
 ////////////////////////////////////////////////////////////////////////////////
 int OfflineCompiler::getHardwareInfo(const char *pDeviceName) {
-    int retVal = CL_INVALID_DEVICE;
+    hwInfo = findHardwareInfo(pDeviceName);
+    return (hwInfo != nullptr) ? CL_SUCCESS : CL_INVALID_DEVICE;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+// findHardwareInfo
+////////////////////////////////////////////////////////////////////////////////
+const HardwareInfo *OfflineCompiler::findHardwareInfo(const char *pDeviceName) {
     for (unsigned int productId = 0; productId < IGFX_MAX_PRODUCT; ++productId) {
         if (stringsAreEqual(pDeviceName, hardwarePrefix[productId])) {
             if (hardwareInfoTable[productId]) {
-                hwInfo = hardwareInfoTable[productId];
-                retVal = CL_SUCCESS;
-                break;
+                return hardwareInfoTable[productId];
             }
         }
     }
 
-    return retVal;
+    return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -274,7 +296,7 @@ std::string OfflineCompiler::getStringWithinDelimiters(const std::string &src) {
 ////////////////////////////////////////////////////////////////////////////////
 // Initialize
 ////////////////////////////////////////////////////////////////////////////////
-int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
+int OfflineCompiler::initialize(uint32_t numArgs, const char **argv, const std::shared_ptr<OfflineCompilerLibraries> &sharedLibraries) {
     int retVal = CL_SUCCESS;
     const char *pSource = nullptr;
     void *pSourceFromFile = nullptr;
@@ -331,6 +353,27 @@ int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
     pSource = strstr((const char *)pSourceFromFile, "R\"===(");
     sourceCode = (pSource != nullptr) ? getStringWithinDelimiters((char *)pSourceFromFile) : (char *)pSourceFromFile;
 
+    if (sharedLibraries != nullptr) {
+        libraries = sharedLibraries;
+    } else {
+        libraries.reset(new OfflineCompilerLibraries());
+        retVal = libraries->load();
+        if (retVal != CL_SUCCESS) {
+            return retVal;
+        }
+    }
+
+    return createDeviceContexts();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// OfflineCompilerLibraries
+////////////////////////////////////////////////////////////////////////////////
+OfflineCompilerLibraries::OfflineCompilerLibraries() = default;
+
+OfflineCompilerLibraries::~OfflineCompilerLibraries() = default;
+
+int OfflineCompilerLibraries::load() {
     this->fclLib.reset(OsLibrary::load(Os::frontEndDllName));
     if (this->fclLib == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
@@ -352,13 +395,6 @@ int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
         return CL_OUT_OF_HOST_MEMORY;
     }
 
-    this->fclDeviceCtx = this->fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
-    if (this->fclDeviceCtx == nullptr) {
-        return CL_OUT_OF_HOST_MEMORY;
-    }
-
-    fclDeviceCtx->SetOclApiVersion(hwInfo->capabilityTable.clVersionSupport * 10);
-
     this->igcLib.reset(OsLibrary::load(Os::igcDllName));
     if (this->igcLib == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
@@ -380,7 +416,24 @@ int OfflineCompiler::initialize(uint32_t numArgs, const char **argv) {
         return CL_OUT_OF_HOST_MEMORY;
     }
 
-    this->igcDeviceCtx = this->igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
+    return CL_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// CreateDeviceContexts
+////////////////////////////////////////////////////////////////////////////////
+int OfflineCompiler::createDeviceContexts() {
+    int retVal = CL_SUCCESS;
+    std::lock_guard<std::mutex> lock(libraries->mainMutex);
+
+    this->fclDeviceCtx = libraries->fclMain->CreateInterface<IGC::FclOclDeviceCtxTagOCL>();
+    if (this->fclDeviceCtx == nullptr) {
+        return CL_OUT_OF_HOST_MEMORY;
+    }
+
+    fclDeviceCtx->SetOclApiVersion(hwInfo->capabilityTable.clVersionSupport * 10);
+
+    this->igcDeviceCtx = libraries->igcMain->CreateInterface<IGC::IgcOclDeviceCtxTagOCL>();
     if (this->igcDeviceCtx == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
     }
@@ -452,10 +505,8 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
             argIndex++;
         } else if (stringsAreEqual(argv[argIndex], "-32")) {
             compile32 = true;
-            internalOptions.append(" -m32 ");
         } else if (stringsAreEqual(argv[argIndex], "-64")) {
             compile64 = true;
-            internalOptions.append(" -m64 ");
         } else if (stringsAreEqual(argv[argIndex], "-cl-intel-greater-than-4GB-buffer-required")) {
             internalOptions.append(" -cl-intel-greater-than-4GB-buffer-required ");
         } else if ((stringsAreEqual(argv[argIndex], "-device")) &&
@@ -482,6 +533,14 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
                    (argIndex + 1 < numArgs)) {
             outputDirectory = argv[argIndex + 1];
             argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-cache_dir")) &&
+                   (argIndex + 1 < numArgs)) {
+            cacheDirectory = argv[argIndex + 1];
+            argIndex++;
+        } else if ((stringsAreEqual(argv[argIndex], "-sharing_extensions")) &&
+                   (argIndex + 1 < numArgs)) {
+            sharingExtensions = argv[argIndex + 1];
+            argIndex++;
         } else if (stringsAreEqual(argv[argIndex], "-q")) {
             quiet = true;
         } else if (stringsAreEqual(argv[argIndex], "-?")) {
@@ -498,6 +557,9 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
         if (compile32 && compile64) {
             printf("Error: Cannot compile for 32-bit and 64-bit, please choose one.\n");
             retVal = INVALID_COMMAND_LINE;
+        } else if (!cacheDirectory.empty() && useLlvmText) {
+            printf("Error: Binary cache entries are keyed with llvm bitcode, -llvm_text cannot be used with -cache_dir.\n");
+            retVal = INVALID_COMMAND_LINE;
         } else if (inputFile.empty()) {
             printf("Error: Input file name missing.\n");
             retVal = INVALID_COMMAND_LINE;
@@ -511,9 +573,22 @@ int OfflineCompiler::parseCommandLine(uint32_t numArgs, const char **argv) {
             retVal = getHardwareInfo(deviceName.c_str());
             if (retVal != CL_SUCCESS) {
                 printf("Error: Cannot get HW Info for device %s.\n", deviceName.c_str());
+            } else {
+                std::string extensionsList = getExtensionsList(*hwInfo);
+                if (!sharingExtensions.empty()) {
+                    // the runtime appends them space separated, the same as the ones of the device
+                    extensionsList += sharingExtensions + (*sharingExtensions.rbegin() == ' ' ? "" : " ");
+                }
+                if (!cacheDirectory.empty()) {
+                    // cache entries are looked up with the internal options Program passes to the compiler
+                    internalOptions = BinaryCache::getProgramInternalOptions(*hwInfo, compile32, internalOptions, extensionsList);
+                } else {
+                    if (compile32 || compile64) {
+                        internalOptions.append(compile32 ? " -m32 " : " -m64 ");
+                    }
+                    internalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
+                }
             }
-            std::string extensionsList = getExtensionsList(*hwInfo);
-            internalOptions.append(convertEnabledExtensionsToCompilerInternalOptions(extensionsList.c_str()));
         }
     }
 
@@ -587,7 +662,7 @@ std::string OfflineCompiler::parseBinAsCharArray(uint8_t *binary, size_t size, s
 ////////////////////////////////////////////////////////////////////////////////
 // GetFileNameTrunk
 ////////////////////////////////////////////////////////////////////////////////
-std::string OfflineCompiler::getFileNameTrunk(std::string &filePath) {
+std::string OfflineCompiler::getFileNameTrunk(const std::string &filePath) {
     size_t slashPos = filePath.find_last_of("\\/", filePath.size()) + 1;
     size_t extPos = filePath.find_last_of(".", filePath.size());
     if (extPos == std::string::npos) {
@@ -631,6 +706,11 @@ void OfflineCompiler::printUsage() {
     printf("  -output <filename>           Indicates output files core name.\n");
     printf("  -out_dir <output_dir>        Indicates the directory into which the compiled files\n");
     printf("                               will be placed.\n");
+    printf("  -cache_dir <cache_dir>       Additionally stores the binary as a runtime binary cache entry\n");
+    printf("                               (see CL_CACHE_LOCATION) in the given directory.\n");
+    printf("  -sharing_extensions <list>   Extensions of API sharings the runtime enables on the target\n");
+    printf("                               host, e.g. cl_intel_va_api_media_sharing when libva is installed.\n");
+    printf("                               Cache entries are found only if these match the runtime's.\n");
     printf("  -cpp_file                    Cpp file with scheduler program binary will be generated.\n");
     printf("\n");
     printf("  -32                          Force compile to 32-bit binary.\n");
@@ -643,6 +723,14 @@ void OfflineCompiler::printUsage() {
     printf("  -options_name                Add suffix with compile options to filename\n");
     printf("  -q                           Be more quiet. print only warnings and errors.\n");
     printf("  -?                           Print this usage message.\n");
+    printf("\n");
+    printf("cloc -batch <manifest> [OPTIONS]\n\n");
+    printf("  -batch <manifest>            Compiles all jobs listed in the manifest in parallel,\n");
+    printf("                               see cloc -batch <manifest> -? for details.\n");
+    printf("\n");
+    printf("cloc -verify_cache <cache_dir> [-device <device_type>] [-prune] [-q]\n\n");
+    printf("  -verify_cache <cache_dir>    Reports binary cache entries which are stale or cannot be loaded,\n");
+    printf("                               -prune removes them.\n");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -728,6 +816,26 @@ bool OfflineCompiler::generateElfBinary() {
     return retVal;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// CreateDirectoryTree
+////////////////////////////////////////////////////////////////////////////////
+void createDirectoryTree(const std::string &directory) {
+    std::list<std::string> dirList;
+    std::string tmp = directory;
+    size_t pos = directory.size() + 1;
+
+    do {
+        dirList.push_back(tmp);
+        pos = tmp.find_last_of("/\\", pos);
+        tmp = tmp.substr(0, pos);
+    } while (pos != std::string::npos);
+
+    while (!dirList.empty()) {
+        MakeDirectory(dirList.back().c_str());
+        dirList.pop_back();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // WriteOutAllFiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -741,20 +849,7 @@ void OfflineCompiler::writeOutAllFiles() {
     }
 
     if (outputDirectory != "") {
-        std::list<std::string> dirList;
-        std::string tmp = outputDirectory;
-        size_t pos = outputDirectory.size() + 1;
-
-        do {
-            dirList.push_back(tmp);
-            pos = tmp.find_last_of("/\\", pos);
-            tmp = tmp.substr(0, pos);
-        } while (pos != std::string::npos);
-
-        while (!dirList.empty()) {
-            MakeDirectory(dirList.back().c_str());
-            dirList.pop_back();
-        }
+        createDirectoryTree(outputDirectory);
     }
 
     if (llvmBinary) {
@@ -813,4 +908,28 @@ void OfflineCompiler::writeOutAllFiles() {
             elfBinarySize);
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// WriteCacheEntry
+////////////////////////////////////////////////////////////////////////////////
+bool OfflineCompiler::writeCacheEntry() {
+    if (!genBinary || !genBinarySize) {
+        return false;
+    }
+
+    // the runtime keys entries with the intermediate representation it passes to IGC
+    ArrayRef<const char> input = inputFileLlvm ? ArrayRef<const char>(sourceCode.c_str(), sourceCode.size())
+                                               : ArrayRef<const char>(llvmBinary, llvmBinarySize);
+    auto kernelFileHash = BinaryCache::getCachedFileName(*hwInfo, input,
+                                                         ArrayRef<const char>(options.c_str(), options.size()),
+                                                         ArrayRef<const char>(internalOptions.c_str(), internalOptions.size()));
+    auto filePath = BinaryCache::getCacheFilePath(cacheDirectory, kernelFileHash);
+    auto file = BinaryCache::createCacheFile(genBinary, genBinarySize);
+
+    createDirectoryTree(cacheDirectory);
+    if (!isQuiet()) {
+        printf("Binary cache entry: %s\n", filePath.c_str());
+    }
+    return BinaryCache::publishFile(filePath, file.data(), file.size());
+}
 } // namespace OCLRT
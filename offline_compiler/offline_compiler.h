@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace OCLRT {
 
@@ -34,6 +35,7 @@ struct HardwareInfo;
 class OsLibrary;
 
 std::string convertToPascalCase(const std::string &inString);
+void createDirectoryTree(const std::string &directory);
 
 enum ErrorCode {
     INVALID_COMMAND_LINE = -5150,
@@ -41,9 +43,25 @@ enum ErrorCode {
     PRINT_USAGE = -5152,
 };
 
+struct OfflineCompilerLibraries {
+    OfflineCompilerLibraries();
+    ~OfflineCompilerLibraries();
+    int load();
+
+    std::unique_ptr<OsLibrary> igcLib;
+    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain;
+
+    std::unique_ptr<OsLibrary> fclLib;
+    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain;
+
+    // CIF mains are not thread safe, serializes interface and buffer creation when libraries are shared between compilers
+    std::mutex mainMutex;
+};
+
 class OfflineCompiler {
   public:
     static OfflineCompiler *create(uint32_t numArgs, const char **argv, int &retVal);
+    static OfflineCompiler *create(uint32_t numArgs, const char **argv, const std::shared_ptr<OfflineCompilerLibraries> &sharedLibraries, int &retVal);
     int build();
     std::string &getBuildLog();
     void printUsage();
@@ -58,13 +76,16 @@ class OfflineCompiler {
 
     std::string parseBinAsCharArray(uint8_t *binary, size_t size, std::string &deviceName, std::string &fileName);
 
+    static const HardwareInfo *findHardwareInfo(const char *pDeviceName);
+    static std::string getFileNameTrunk(const std::string &filePath);
+
   protected:
     OfflineCompiler();
 
     int getHardwareInfo(const char *pDeviceName);
-    std::string getFileNameTrunk(std::string &filePath);
     std::string getStringWithinDelimiters(const std::string &src);
-    int initialize(uint32_t numArgs, const char **argv);
+    int initialize(uint32_t numArgs, const char **argv, const std::shared_ptr<OfflineCompilerLibraries> &sharedLibraries = nullptr);
+    int createDeviceContexts();
     int parseCommandLine(uint32_t numArgs, const char **argv);
     void parseDebugSettings();
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
@@ -72,12 +93,15 @@ class OfflineCompiler {
     void updateBuildLog(const char *pErrorString, const size_t errorStringSize);
     bool generateElfBinary();
     void writeOutAllFiles();
+    bool writeCacheEntry();
     const HardwareInfo *hwInfo = nullptr;
 
     std::string deviceName;
     std::string inputFile;
     std::string outputFile;
     std::string outputDirectory;
+    std::string cacheDirectory;
+    std::string sharingExtensions;
     std::string options;
     std::string internalOptions;
     std::string sourceCode;
@@ -96,12 +120,8 @@ class OfflineCompiler {
     char *llvmBinary = nullptr;
     size_t llvmBinarySize = 0;
 
-    std::unique_ptr<OsLibrary> igcLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> igcMain = nullptr;
+    std::shared_ptr<OfflineCompilerLibraries> libraries = nullptr;
     CIF::RAII::UPtr_t<IGC::IgcOclDeviceCtxTagOCL> igcDeviceCtx = nullptr;
-
-    std::unique_ptr<OsLibrary> fclLib = nullptr;
-    CIF::RAII::UPtr_t<CIF::CIFMain> fclMain = nullptr;
     CIF::RAII::UPtr_t<IGC::FclOclDeviceCtxTagOCL> fclDeviceCtx = nullptr;
 };
 } // namespace OCLRT
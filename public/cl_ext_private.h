@@ -29,6 +29,45 @@
 
 #define CL_DEVICE_DRIVER_VERSION_INTEL_NEO1 0x454E4831 // Driver version is ENH1
 
+/***************************************
+ * * Internal only memory usage query *
+ * ****************************************/
+// New query for clGetDeviceInfo, returns cl_device_memory_usage_intel
+#define CL_DEVICE_MEMORY_USAGE_INTEL 0x10011
+
+// Indices of cl_device_memory_usage_intel::per_type
+#define CL_MEMORY_USAGE_TYPE_BUFFER_INTEL 0
+#define CL_MEMORY_USAGE_TYPE_IMAGE_INTEL 1
+#define CL_MEMORY_USAGE_TYPE_COMMAND_BUFFER_INTEL 2
+#define CL_MEMORY_USAGE_TYPE_HEAP_INTEL 3
+#define CL_MEMORY_USAGE_TYPE_TIMESTAMP_TAG_INTEL 4
+#define CL_MEMORY_USAGE_TYPE_HOST_PTR_INTEL 5
+#define CL_MEMORY_USAGE_TYPE_SVM_INTEL 6
+#define CL_MEMORY_USAGE_TYPE_INTERNAL_INTEL 7
+#define CL_MEMORY_USAGE_TYPE_COUNT_INTEL 8
+
+typedef struct _cl_memory_usage_counters_intel {
+    cl_ulong bytes;
+    cl_ulong allocations;
+    cl_ulong peak_bytes;
+} cl_memory_usage_counters_intel;
+
+typedef struct _cl_device_memory_usage_intel {
+    cl_memory_usage_counters_intel total;
+    cl_memory_usage_counters_intel per_type[CL_MEMORY_USAGE_TYPE_COUNT_INTEL];
+    cl_ulong os_handles; // buffer objects on Linux
+    cl_ulong reuse_list_allocations;
+    cl_ulong reuse_list_bytes;
+    cl_ulong host_ptr_fragments;
+} cl_device_memory_usage_intel;
+
+/***************************************
+ * * Internal only context properties *
+ * ****************************************/
+// 0: no warm-up, 1: preallocate heaps, command buffers and timestamp tags,
+// 2: additionally build copy and fill builtin kernels
+#define CL_CONTEXT_WARM_UP_RESOURCES_INTEL 0x10012
+
 /***************************************
  * * cl_intel_debug_info extension *
  * ****************************************/
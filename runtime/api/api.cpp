@@ -36,6 +36,7 @@
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/options.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/queue_helpers.h"
 #include "runtime/helpers/validators.h"
 #include "runtime/kernel/kernel.h"
@@ -1304,9 +1305,14 @@ cl_kernel CL_API_CALL clCreateKernel(cl_program clProgram,
             break;
         }
 
+        if (pProgram->getBuildStatus() == CL_BUILD_IN_PROGRESS) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
+
         const KernelInfo *pKernelInfo = pProgram->getKernelInfo(kernelName);
         if (!pKernelInfo) {
-            retVal = CL_INVALID_KERNEL_NAME;
+            retVal = pProgram->hasKernelInfoParsingFailed() ? CL_INVALID_PROGRAM_EXECUTABLE : CL_INVALID_KERNEL_NAME;
             break;
         }
 
@@ -1339,16 +1345,25 @@ cl_int CL_API_CALL clCreateKernelsInProgram(cl_program clProgram,
     API_ENTER(0);
     auto program = castToObject<Program>(clProgram);
     if (program) {
+        if (program->getBuildStatus() == CL_BUILD_IN_PROGRESS) {
+            return CL_INVALID_PROGRAM_EXECUTABLE;
+        }
         auto numKernels = program->getNumKernels();
-        for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
-            const auto kernelInfo = program->getKernelInfo(ordinal);
-            DEBUG_BREAK_IF(kernelInfo == nullptr);
-            DEBUG_BREAK_IF(!kernelInfo->isValid);
+        if (kernels) {
+            // patch lists parsed on demand are checked before any kernel is handed out
+            std::vector<const KernelInfo *> kernelInfos(numKernels);
+            for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
+                kernelInfos[ordinal] = program->getKernelInfo(ordinal);
+                if (kernelInfos[ordinal] == nullptr) {
+                    return CL_INVALID_PROGRAM_EXECUTABLE;
+                }
+                DEBUG_BREAK_IF(!kernelInfos[ordinal]->isValid);
+            }
 
-            if (kernels) {
+            for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
                 kernels[ordinal] = Kernel::create(
                     program,
-                    *kernelInfo,
+                    *kernelInfos[ordinal],
                     nullptr);
                 if (kernels[ordinal] != nullptr) {
                     gtpinNotifyKernelCreate(kernels[ordinal]);
@@ -3741,13 +3756,12 @@ cl_int CL_API_CALL clEnqueueSVMMigrateMem(cl_command_queue commandQueue,
 
     for (uint32_t i = 0; i < numSvmPointers; i++) {
         SVMAllocsManager *pSvmAllocMgr = pCommandQueue->getContext().getSVMAllocsManager();
-        GraphicsAllocation *pSvmAlloc = pSvmAllocMgr->getSVMAlloc(svmPointers[i]);
-        if (pSvmAlloc == nullptr) {
+        SVMAllocsManager::MapBasedAllocationTracker::AllocationRange svmRange;
+        if (!pSvmAllocMgr->getSVMAllocRange(svmPointers[i], svmRange)) {
             return CL_INVALID_VALUE;
         }
         if (sizes != nullptr && sizes[i] != 0) {
-            pSvmAlloc = pSvmAllocMgr->getSVMAlloc(reinterpret_cast<void *>((size_t)svmPointers[i] + sizes[i] - 1));
-            if (pSvmAlloc == nullptr) {
+            if (ptrDiff(svmPointers[i], svmRange.basePtr) + sizes[i] > svmRange.size) {
                 return CL_INVALID_VALUE;
             }
         }
@@ -25,8 +25,10 @@
 #include "runtime/built_ins/vme_dispatch_builder.h"
 #include "runtime/built_ins/sip.h"
 #include "runtime/compiler_interface/compiler_interface.h"
+#include "runtime/device/device.h"
 #include "runtime/program/program.h"
 #include "runtime/mem_obj/image.h"
+#include "runtime/memory_manager/memory_manager.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/convert_color.h"
@@ -97,7 +99,7 @@ SchedulerKernel &BuiltIns::getSchedulerKernel(Context &context) {
         schedulerBuiltIn.pProgram = program;
 
         auto kernelInfo = schedulerBuiltIn.pProgram->getKernelInfo(SchedulerKernel::schedulerName);
-        DEBUG_BREAK_IF(!kernelInfo);
+        UNRECOVERABLE_IF(kernelInfo == nullptr);
 
         schedulerBuiltIn.pKernel = Kernel::create<SchedulerKernel>(
             schedulerBuiltIn.pProgram,
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/built_ins/sip.h"
+#include "runtime/helpers/debug_helpers.h"
 #include "runtime/scheduler/scheduler_kernel.h"
 #include "runtime/program/program.h"
 #include "runtime/utilities/vec.h"
@@ -283,6 +284,7 @@ class BuiltinDispatchInfoBuilder {
     template <typename KernelNameT, typename... KernelsDescArgsT>
     void grabKernels(KernelNameT &&kernelName, Kernel *&kernelDst, KernelsDescArgsT &&... kernelsDesc) {
         const KernelInfo *ki = prog->getKernelInfo(kernelName);
+        UNRECOVERABLE_IF(ki == nullptr);
         cl_int err = 0;
         kernelDst = Kernel::create(prog.get(), *ki, &err);
         kernelDst->isBuiltIn = true;
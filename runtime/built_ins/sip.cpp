@@ -83,15 +83,19 @@ SipKernel::SipKernel(SipKernelType type, Program *sipProgram)
 }
 
 GraphicsAllocation *SipKernel::getSipAllocation() const {
-    return program->getKernelInfo(size_t{0})->getGraphicsAllocation();
+    auto kernelInfo = program->getKernelInfo(size_t{0});
+    UNRECOVERABLE_IF(kernelInfo == nullptr);
+    return kernelInfo->getGraphicsAllocation();
 }
 
 const char *SipKernel::getBinary() const {
     auto kernelInfo = program->getKernelInfo(size_t{0});
+    UNRECOVERABLE_IF(kernelInfo == nullptr);
     return reinterpret_cast<const char *>(ptrOffset(kernelInfo->heapInfo.pKernelHeap, kernelInfo->systemKernelOffset));
 }
 size_t SipKernel::getBinarySize() const {
     auto kernelInfo = program->getKernelInfo(size_t{0});
+    UNRECOVERABLE_IF(kernelInfo == nullptr);
     return kernelInfo->heapInfo.pKernelHeader->KernelHeapSize - kernelInfo->systemKernelOffset;
 }
 }
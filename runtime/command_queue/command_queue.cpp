@@ -38,9 +38,11 @@
 #include "runtime/mem_obj/image.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/helpers/string.h"
 #include "CL/cl_ext.h"
 #include "runtime/utilities/api_intercept.h"
+#include "runtime/utilities/tag_allocator.h"
 #include "runtime/helpers/convert_color.h"
 #include "runtime/helpers/queue_helpers.h"
 #include <map>
@@ -89,6 +91,11 @@ CommandQueue::CommandQueue(Context *context,
     }
     commandQueueProperties = getCmdQueueProperties<cl_command_queue_properties>(properties);
     flushStamp.reset(new FlushStampTracker(true));
+
+    auto tagPoolsToPreallocate = DebugManager.flags.ProfilingTagPoolsToPreallocate.get();
+    if (device && device->getMemoryManager() && isProfilingEnabled() && tagPoolsToPreallocate > 0) {
+        device->getMemoryManager()->getEventTsAllocator()->preallocateTagPools(static_cast<size_t>(tagPoolsToPreallocate));
+    }
 }
 
 CommandQueue::~CommandQueue() {
@@ -258,6 +265,7 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
         } else {
             finalHeapSize = std::max(heapMemory->getUnderlyingBufferSize(), finalHeapSize);
         }
+        memoryManager->getMemoryUsageTracker().registerAllocation(*heapMemory, MemoryUsageType::Heap);
 
         if (IndirectHeap::SURFACE_STATE == heapType) {
             DEBUG_BREAK_IF(minRequiredSize > maxSshSize);
@@ -322,6 +330,7 @@ LinearStream &CommandQueue::getCS(size_t minRequiredSize) {
         if (!allocation) {
             allocation = memoryManager->allocateGraphicsMemory(requiredSize, MemoryConstants::pageSize);
         }
+        memoryManager->getMemoryUsageTracker().registerAllocation(*allocation, MemoryUsageType::CommandBuffer);
 
         // Deallocate the old block, if not null
         auto oldAllocation = commandStream->getGraphicsAllocation();
@@ -445,6 +454,11 @@ bool CommandQueue::setPerfCountersEnabled(bool perfCountersEnabled, cl_uint conf
     this->perfCountersConfig = configuration;
     this->perfCountersEnabled = perfCountersEnabled;
 
+    auto tagPoolsToPreallocate = DebugManager.flags.ProfilingTagPoolsToPreallocate.get();
+    if (perfCountersEnabled && tagPoolsToPreallocate > 0) {
+        device->getMemoryManager()->getEventPerfCountAllocator()->preallocateTagPools(static_cast<size_t>(tagPoolsToPreallocate));
+    }
+
     return true;
 }
 
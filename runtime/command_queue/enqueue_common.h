@@ -715,6 +715,7 @@ bool CommandQueueHw<GfxFamily>::createAllocationForHostSurface(HostPtrSurface &s
         return false;
     }
     allocation->taskCount = Event::eventNotReady;
+    memoryManager->getMemoryUsageTracker().registerAllocation(*allocation, MemoryUsageType::HostPtr);
     surface.setAllocation(allocation);
     memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), TEMPORARY_ALLOCATION);
     return true;
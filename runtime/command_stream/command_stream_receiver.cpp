@@ -53,6 +53,10 @@ void CommandStreamReceiver::makeResident(GraphicsAllocation &gfxAllocation) {
     if (gfxAllocation.residencyTaskCount < (int)submissionTaskCount) {
         getMemoryManager()->pushAllocationForResidency(&gfxAllocation);
         gfxAllocation.taskCount = submissionTaskCount;
+        auto &lruResidencyManager = getMemoryManager()->getLruResidencyManager();
+        if (lruResidencyManager.isEnabled()) {
+            lruResidencyManager.markUsed(gfxAllocation, submissionTaskCount);
+        }
         if (gfxAllocation.residencyTaskCount == ObjectNotResident) {
             this->totalMemoryUsed += gfxAllocation.getUnderlyingBufferSize();
         }
@@ -88,6 +92,7 @@ void CommandStreamReceiver::makeSurfacePackNonResident(ResidencyContainer *alloc
 
 GraphicsAllocation *CommandStreamReceiver::createAllocationAndHandleResidency(const void *address, size_t size, bool addToDefferedDeleteList) {
     GraphicsAllocation *graphicsAllocation = getMemoryManager()->allocateGraphicsMemory(size, address);
+    getMemoryManager()->getMemoryUsageTracker().registerAllocation(*graphicsAllocation, MemoryUsageType::HostPtr);
     makeResident(*graphicsAllocation);
     if (addToDefferedDeleteList) {
         getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(graphicsAllocation), TEMPORARY_ALLOCATION);
@@ -143,6 +148,7 @@ LinearStream &CommandStreamReceiver::getCS(size_t minRequiredSize) {
         if (!allocation) {
             allocation = memoryManager->allocateGraphicsMemory(requiredSize, MemoryConstants::pageSize);
         }
+        memoryManager->getMemoryUsageTracker().registerAllocation(*allocation, MemoryUsageType::CommandBuffer);
 
         //pass current allocation to reusable list
         if (commandStream.getCpuBase()) {
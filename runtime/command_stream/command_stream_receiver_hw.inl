@@ -381,6 +381,9 @@ CompletionStamp CommandStreamReceiverHw<GfxFamily>::flushTask(
         this->makeSurfacePackNonResident(nullptr);
     }
 
+    //release cold allocations when working sets of recent submissions exceed residency budget
+    getMemoryManager()->evictColdAllocations();
+
     //check if we are not over the budget, if we are do implicit flush
     if (getMemoryManager()->isMemoryBudgetExhausted()) {
         if (this->totalMemoryUsed >= device->getDeviceInfo().globalMemSize / 4) {
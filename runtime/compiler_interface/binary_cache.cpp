@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,47 +23,37 @@
 #include "config.h"
 
 #include <runtime/compiler_interface/binary_cache.h>
-#include <runtime/helpers/aligned_memory.h>
 #include <runtime/helpers/file_io.h>
-#include <runtime/helpers/hash.h>
-#include <runtime/helpers/hw_info.h>
-#include <runtime/os_interface/os_inc_base.h>
+#include <runtime/memory_manager/memory_constants.h>
+#include <runtime/os_interface/debug_settings_manager.h>
+#include <runtime/program/kernel_info_index.h>
 #include <runtime/program/program.h>
+#include <runtime/utilities/directory.h>
+#include <runtime/utilities/mapped_file.h>
 
-#include <cstring>
+#include <atomic>
+#include <cstdio>
 #include <string>
-#include <sstream>
-#include <iomanip>
-#include <mutex>
 
 namespace OCLRT {
-std::mutex BinaryCache::cacheAccessMtx;
-
-const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
-                                                 const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
-    Hash hash;
-
-    hash.update("----", 4);
-    hash.update(&*input.begin(), input.size());
-    hash.update("----", 4);
-    hash.update(&*options.begin(), options.size());
-    hash.update("----", 4);
-    hash.update(&*internalOptions.begin(), internalOptions.size());
-
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pSkuTable), sizeof(*hwInfo.pSkuTable));
-    hash.update("----", 4);
-    hash.update(reinterpret_cast<const char *>(hwInfo.pWaTable), sizeof(*hwInfo.pWaTable));
-
-    auto res = hash.finish();
-    std::stringstream stream;
-    stream << std::setfill('0')
-           << std::setw(sizeof(res) * 2)
-           << std::hex
-           << res;
-    return stream.str();
+namespace {
+std::atomic<uint64_t> bytesWrittenSinceEviction(0);
+
+void restoreKernelInfoIndex(const char *pKernelInfoIndex, size_t kernelInfoIndexSize, Program &program) {
+    std::vector<KernelInfoIndexEntry> kernelInfoIndex;
+    if (KernelInfoIndex::deserialize(pKernelInfoIndex, kernelInfoIndexSize, kernelInfoIndex)) {
+        program.setKernelInfoIndex(std::move(kernelInfoIndex));
+    }
+}
+} // namespace
+
+BinaryCache::BinaryCache() {
+    getMemoryTier().setBudget(static_cast<size_t>(DebugManager.flags.BinaryCacheMemoryTierSizeInMegabytes.get() * MemoryConstants::megaByte));
+}
+
+BinaryCacheMemoryTier &BinaryCache::getMemoryTier() {
+    static BinaryCacheMemoryTier memoryTier;
+    return memoryTier;
 }
 
 bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
@@ -71,41 +61,76 @@ bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBin
         return false;
     }
 
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    getMemoryTier().insert(kernelFileHash, pBinary, binarySize);
 
-    std::lock_guard<std::mutex> lock(cacheAccessMtx);
-    if (writeDataToFile(
-            hashFilePath.c_str(),
-            pBinary,
-            binarySize) == 0) {
+    auto file = createCacheFile(pBinary, binarySize);
+    if (!publishFile(getCacheFilePath(kernelFileHash), file.data(), file.size())) {
         return false;
     }
 
+    auto sizeLimit = static_cast<uint64_t>(DebugManager.flags.BinaryCacheMaxSizeInMegabytes.get()) * MemoryConstants::megaByte;
+    if (sizeLimit > 0) {
+        // the directory is scanned once enough data was written to possibly exceed the limit noticeably
+        auto bytesWritten = bytesWrittenSinceEviction.fetch_add(file.size()) + file.size();
+        if (bytesWritten >= sizeLimit / 16) {
+            bytesWrittenSinceEviction = 0;
+            evictFiles(CL_CACHE_LOCATION, sizeLimit);
+        }
+    }
+
     return true;
 }
 
 bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
-    void *pBinary = nullptr;
-    size_t binarySize = 0;
-
-    std::string hashFilePath = CL_CACHE_LOCATION;
-    hashFilePath.append(Os::fileSeparator);
-    hashFilePath.append(kernelFileHash + ".cl_cache");
+    auto cachedBinary = getMemoryTier().find(kernelFileHash);
+    if (cachedBinary != nullptr) {
+        program.storeGenBinary(cachedBinary->data(), cachedBinary->size());
+        return true;
+    }
 
-    {
-        std::lock_guard<std::mutex> lock(cacheAccessMtx);
-        binarySize = loadDataFromFile(hashFilePath.c_str(), pBinary);
+    auto filePath = getCacheFilePath(kernelFileHash);
+    if (DebugManager.flags.EnableMappedBinaryCacheLoad.get()) {
+        std::shared_ptr<MappedFile> mappedFile = MappedFile::open(filePath);
+        if (mappedFile) {
+            const char *pBinary = nullptr;
+            size_t binarySize = 0;
+            const char *pKernelInfoIndex = nullptr;
+            size_t kernelInfoIndexSize = 0;
+            if (!unpackCacheFile(mappedFile->data(), mappedFile->size(), pBinary, binarySize, pKernelInfoIndex, kernelInfoIndexSize)) {
+                mappedFile.reset();
+                std::remove(filePath.c_str());
+                return false;
+            }
+            getMemoryTier().insert(kernelFileHash, pBinary, binarySize);
+            Directory::touchFile(filePath);
+            // kernel heaps reference the private mapping directly, without copying the binary
+            program.storeGenBinary(mappedFile, const_cast<char *>(pBinary), binarySize);
+            restoreKernelInfoIndex(pKernelInfoIndex, kernelInfoIndexSize, program);
+            return true;
+        }
     }
 
-    if ((pBinary == nullptr) || (binarySize == 0)) {
-        deleteDataReadFromFile(pBinary);
+    void *pFile = nullptr;
+    size_t fileSize = loadDataFromFile(filePath.c_str(), pFile);
+
+    const char *pBinary = nullptr;
+    size_t binarySize = 0;
+    const char *pKernelInfoIndex = nullptr;
+    size_t kernelInfoIndexSize = 0;
+    if (!unpackCacheFile(static_cast<const char *>(pFile), fileSize, pBinary, binarySize, pKernelInfoIndex, kernelInfoIndexSize)) {
+        deleteDataReadFromFile(pFile);
+        if (fileSize > 0) {
+            // truncated, corrupted or written in an older format, it is rebuilt and cached again
+            std::remove(filePath.c_str());
+        }
         return false;
     }
     program.storeGenBinary(pBinary, binarySize);
+    restoreKernelInfoIndex(pKernelInfoIndex, kernelInfoIndexSize, program);
+    getMemoryTier().insert(kernelFileHash, pBinary, binarySize);
+    Directory::touchFile(filePath);
 
-    deleteDataReadFromFile(pBinary);
+    deleteDataReadFromFile(pFile);
 
     return true;
 }
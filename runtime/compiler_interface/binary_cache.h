@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -26,23 +26,72 @@
 #include <cstring>
 #include <string>
 #include <mutex>
+#include <vector>
 
+#include "runtime/compiler_interface/binary_cache_memory_tier.h"
 #include "runtime/utilities/arrayref.h"
 
 namespace OCLRT {
 
 struct HardwareInfo;
 class Program;
+
+// Every .cl_cache file starts with this header, the checksum covers the binary which follows it.
+// The binary may be followed by a serialized kernel info index, which carries its own checksum.
+struct BinaryCacheFileHeader {
+    static const uint32_t magicValue = 0x43424c43; // "CLBC"
+    static const uint32_t currentVersion = 3;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t binarySize;
+    uint64_t checksum;
+};
+static_assert(sizeof(BinaryCacheFileHeader) == 24, "BinaryCacheFileHeader is part of the on-disk format");
+
+enum class CacheFileStatus {
+    Valid,
+    StaleKey,   // not named by the current key derivation, the runtime never looks it up
+    Corrupted,  // damaged header, binary or kernel info index, the runtime discards it on load
+    Unloadable,  // intact, but the gen binary is rejected by the runtime
+    OtherDevice, // loadable, but built for a device other than the one verified against
+};
+
 class BinaryCache {
   public:
-    const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
-                                        ArrayRef<const char> options, ArrayRef<const char> internalOptions);
+    // Bumped whenever the key derivation changes, entries written under an older key are never looked up again
+    static const uint32_t cacheKeyVersion = 3;
+
+    BinaryCache();
+
+    static const std::string getCachedFileName(const HardwareInfo &hwInfo, ArrayRef<const char> input,
+                                               ArrayRef<const char> options, ArrayRef<const char> internalOptions);
+    // internal options Program passes to the compiler when building from source, entries written offline
+    // have to be keyed with them to be found by the runtime
+    static std::string getProgramInternalOptions(const HardwareInfo &hwInfo, bool force32Bit, const std::string &additionalOptions,
+                                                 const std::string &deviceExtensions);
 
     virtual ~BinaryCache(){};
 
     virtual bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize);
     virtual bool loadCachedBinary(const std::string kernelFileHash, Program &program);
 
+    static BinaryCacheMemoryTier &getMemoryTier();
+
+    static std::string getCacheFilePath(const std::string &kernelFileHash);
+    static std::string getCacheFilePath(const std::string &directory, const std::string &kernelFileHash);
+    static uint64_t computeChecksum(const char *pBinary, size_t binarySize);
+    static std::vector<char> packCacheFile(const char *pBinary, size_t binarySize,
+                                           const char *pKernelInfoIndex = nullptr, size_t kernelInfoIndexSize = 0);
+    static std::vector<char> createCacheFile(const char *pBinary, size_t binarySize);
+    static bool unpackCacheFile(const char *pFile, size_t fileSize, const char *&pBinary, size_t &binarySize);
+    static bool unpackCacheFile(const char *pFile, size_t fileSize, const char *&pBinary, size_t &binarySize,
+                                const char *&pKernelInfoIndex, size_t &kernelInfoIndexSize);
+    static bool publishFile(const std::string &filePath, const char *pData, size_t dataSize);
+    static size_t evictFiles(std::string directory, uint64_t sizeLimit);
+    static CacheFileStatus verifyCacheFile(const std::string &filePath, const HardwareInfo *hwInfo = nullptr);
+    static const char *getCacheFileStatusName(CacheFileStatus status);
+
   protected:
     static std::mutex cacheAccessMtx;
 };
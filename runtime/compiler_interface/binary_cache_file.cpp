@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "config.h"
+
+#include <runtime/compiler_interface/binary_cache.h>
+#include <runtime/compiler_interface/options_canonicalizer.h>
+#include <runtime/helpers/file_io.h>
+#include <runtime/helpers/fast_hash.h>
+#include <runtime/helpers/hw_info.h>
+#include <runtime/os_interface/debug_settings_manager.h>
+#include <runtime/os_interface/os_inc_base.h>
+#include <runtime/platform/extensions.h>
+#include <runtime/program/kernel_info_index.h>
+#include <runtime/utilities/directory.h>
+#include "patch_shared.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <random>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace OCLRT {
+std::mutex BinaryCache::cacheAccessMtx;
+
+namespace {
+const std::string cacheFileExtension = ".cl_cache";
+const std::string tempFileExtension = ".tmp";
+// temporary files left behind by a crashed writer are removed once they are this old
+const uint64_t staleTempFileAgeInSeconds = 600;
+
+std::atomic<uint32_t> tempFileCounter(0);
+
+bool endsWith(const std::string &str, const std::string &suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string getUniqueTempSuffix() {
+    static const uint64_t processTag = std::random_device()();
+    std::stringstream stream;
+    stream << "." << std::hex << processTag << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << tempFileCounter++ << tempFileExtension;
+    return stream.str();
+}
+
+uint64_t hashKeyMaterial(uint64_t seed, const HardwareInfo &hwInfo, const ArrayRef<const char> input,
+                         const std::string &options, const std::string &internalOptions) {
+    FastHash hash(seed);
+
+    hash.update("----", 4);
+    hash.update(&*input.begin(), input.size());
+    hash.update("----", 4);
+    hash.update(options.c_str(), options.size());
+    hash.update("----", 4);
+    hash.update(internalOptions.c_str(), internalOptions.size());
+
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pPlatform), sizeof(*hwInfo.pPlatform));
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pSkuTable), sizeof(*hwInfo.pSkuTable));
+    hash.update("----", 4);
+    hash.update(reinterpret_cast<const char *>(hwInfo.pWaTable), sizeof(*hwInfo.pWaTable));
+
+    return hash.finish();
+}
+
+std::string canonicalizeKeyOptions(const char *kind, const ArrayRef<const char> options) {
+    auto canonical = OptionsCanonicalizer::canonicalize(&*options.begin(), options.size());
+    if (canonical.compare(0, std::string::npos, &*options.begin(), options.size()) != 0) {
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stderr, "Binary cache key: %s \"%.*s\" normalized to \"%s\"\n",
+                         kind, static_cast<int>(options.size()), &*options.begin(), canonical.c_str());
+    }
+    return canonical;
+}
+
+void reportKeyCollision(const std::string &key, uint64_t verificationHash) {
+    static std::mutex keysMtx;
+    static std::unordered_map<std::string, uint64_t> verificationHashes;
+    std::lock_guard<std::mutex> lock(keysMtx);
+    auto it = verificationHashes.find(key);
+    if (it == verificationHashes.end()) {
+        verificationHashes[key] = verificationHash;
+    } else if (it->second != verificationHash) {
+        printDebugString(true, stderr, "Binary cache key: collision detected for key %s\n", key.c_str());
+    }
+}
+
+} // namespace
+
+const std::string BinaryCache::getCachedFileName(const HardwareInfo &hwInfo, const ArrayRef<const char> input,
+                                                 const ArrayRef<const char> options, const ArrayRef<const char> internalOptions) {
+    std::string keyOptions(options.begin(), options.end());
+    std::string keyInternalOptions(internalOptions.begin(), internalOptions.end());
+    if (DebugManager.flags.EnableBinaryCacheOptionsCanonicalization.get()) {
+        keyOptions = canonicalizeKeyOptions("options", options);
+        keyInternalOptions = canonicalizeKeyOptions("internal options", internalOptions);
+    }
+
+    auto res = hashKeyMaterial(cacheKeyVersion, hwInfo, input, keyOptions, keyInternalOptions);
+    std::stringstream stream;
+    stream << "v" << cacheKeyVersion << "-"
+           << std::setfill('0')
+           << std::setw(sizeof(res) * 2)
+           << std::hex
+           << res;
+
+    if (DebugManager.flags.PrintDebugMessages.get()) {
+        // an independently seeded hash of the same material tells a true 64-bit key collision from a repeated build
+        reportKeyCollision(stream.str(), hashKeyMaterial(~static_cast<uint64_t>(cacheKeyVersion), hwInfo, input, keyOptions, keyInternalOptions));
+    }
+    return stream.str();
+}
+
+std::string BinaryCache::getProgramInternalOptions(const HardwareInfo &hwInfo, bool force32Bit, const std::string &additionalOptions,
+                                                   const std::string &deviceExtensions) {
+    // the OpenCL version is named explicitly and -m64, the default, is left out, as in the Program constructor
+    std::string internalOptions = "-ocl-version=" + std::to_string(getClVersionToEnable(hwInfo) * 10) + " ";
+    internalOptions += force32Bit ? "-m32 " : "";
+    internalOptions += additionalOptions.empty() ? "" : additionalOptions + " ";
+    internalOptions += "-fpreserve-vec3-type ";
+    internalOptions += convertEnabledExtensionsToCompilerInternalOptions(deviceExtensions.c_str());
+    return internalOptions;
+}
+
+std::string BinaryCache::getCacheFilePath(const std::string &kernelFileHash) {
+    return getCacheFilePath(CL_CACHE_LOCATION, kernelFileHash);
+}
+
+std::string BinaryCache::getCacheFilePath(const std::string &directory, const std::string &kernelFileHash) {
+    std::string hashFilePath = directory;
+    hashFilePath.append(Os::fileSeparator);
+    hashFilePath.append(kernelFileHash + cacheFileExtension);
+    return hashFilePath;
+}
+
+uint64_t BinaryCache::computeChecksum(const char *pBinary, size_t binarySize) {
+    return FastHash::hash(pBinary, binarySize);
+}
+
+std::vector<char> BinaryCache::packCacheFile(const char *pBinary, size_t binarySize,
+                                             const char *pKernelInfoIndex, size_t kernelInfoIndexSize) {
+    BinaryCacheFileHeader header = {};
+    header.magic = BinaryCacheFileHeader::magicValue;
+    header.version = BinaryCacheFileHeader::currentVersion;
+    header.binarySize = binarySize;
+    header.checksum = computeChecksum(pBinary, binarySize);
+
+    std::vector<char> file(sizeof(header) + binarySize + kernelInfoIndexSize);
+    memcpy(file.data(), &header, sizeof(header));
+    memcpy(file.data() + sizeof(header), pBinary, binarySize);
+    if (kernelInfoIndexSize > 0) {
+        memcpy(file.data() + sizeof(header) + binarySize, pKernelInfoIndex, kernelInfoIndexSize);
+    }
+    return file;
+}
+
+std::vector<char> BinaryCache::createCacheFile(const char *pBinary, size_t binarySize) {
+    // kernel offsets are stored next to the binary, so loads can skip scanning it for kernels
+    std::vector<KernelInfoIndexEntry> kernelInfoIndex;
+    std::vector<char> serializedKernelInfoIndex;
+    if (KernelInfoIndex::build(pBinary, binarySize, kernelInfoIndex)) {
+        serializedKernelInfoIndex = KernelInfoIndex::serialize(kernelInfoIndex);
+    }
+    return packCacheFile(pBinary, binarySize, serializedKernelInfoIndex.data(), serializedKernelInfoIndex.size());
+}
+
+bool BinaryCache::unpackCacheFile(const char *pFile, size_t fileSize, const char *&pBinary, size_t &binarySize) {
+    const char *pKernelInfoIndex = nullptr;
+    size_t kernelInfoIndexSize = 0;
+    return unpackCacheFile(pFile, fileSize, pBinary, binarySize, pKernelInfoIndex, kernelInfoIndexSize);
+}
+
+bool BinaryCache::unpackCacheFile(const char *pFile, size_t fileSize, const char *&pBinary, size_t &binarySize,
+                                  const char *&pKernelInfoIndex, size_t &kernelInfoIndexSize) {
+    BinaryCacheFileHeader header;
+    if (pFile == nullptr || fileSize < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, pFile, sizeof(header));
+    if (header.magic != BinaryCacheFileHeader::magicValue ||
+        header.version != BinaryCacheFileHeader::currentVersion ||
+        header.binarySize > fileSize - sizeof(header) ||
+        header.binarySize == 0) {
+        return false;
+    }
+    auto binary = pFile + sizeof(header);
+    if (computeChecksum(binary, static_cast<size_t>(header.binarySize)) != header.checksum) {
+        return false;
+    }
+    pBinary = binary;
+    binarySize = static_cast<size_t>(header.binarySize);
+    pKernelInfoIndex = binary + binarySize;
+    kernelInfoIndexSize = fileSize - sizeof(header) - binarySize;
+    return true;
+}
+
+bool BinaryCache::publishFile(const std::string &filePath, const char *pData, size_t dataSize) {
+    // the complete file is written under a unique name and then renamed, so readers in this and
+    // other processes see either no file or a complete one, even if the writer crashes midway
+    auto tempFilePath = filePath + getUniqueTempSuffix();
+
+    FILE *fp = nullptr;
+    fopen_s(&fp, tempFilePath.c_str(), "wb");
+    if (fp == nullptr) {
+        return false;
+    }
+    bool written = fwrite(pData, sizeof(char), dataSize, fp) == dataSize;
+    written &= fflush(fp) == 0;
+    written &= fclose(fp) == 0;
+
+    if (written && std::rename(tempFilePath.c_str(), filePath.c_str()) == 0) {
+        return true;
+    }
+    std::remove(tempFilePath.c_str());
+    // entries are content addressed, a file published concurrently by another writer is as good as ours
+    return written && fileExists(filePath);
+}
+
+size_t BinaryCache::evictFiles(std::string directory, uint64_t sizeLimit) {
+    struct CacheFile {
+        std::string path;
+        size_t size;
+        uint64_t lastUseTime;
+    };
+    std::vector<CacheFile> cacheFiles;
+    uint64_t totalSize = 0;
+    auto now = static_cast<uint64_t>(time(nullptr));
+    size_t filesRemoved = 0;
+
+    std::lock_guard<std::mutex> lock(cacheAccessMtx);
+    for (auto &path : Directory::getFiles(directory)) {
+        CacheFile file = {path, 0, 0};
+        if (!Directory::getFileInfo(path, file.size, file.lastUseTime)) {
+            continue;
+        }
+        if (endsWith(path, tempFileExtension)) {
+            if (now > file.lastUseTime + staleTempFileAgeInSeconds && std::remove(path.c_str()) == 0) {
+                filesRemoved++;
+            }
+        } else if (endsWith(path, cacheFileExtension)) {
+            totalSize += file.size;
+            cacheFiles.push_back(file);
+        }
+    }
+    if (totalSize <= sizeLimit) {
+        return filesRemoved;
+    }
+
+    // loads refresh the modification time, so the oldest files are the least recently used ones
+    std::sort(cacheFiles.begin(), cacheFiles.end(), [](const CacheFile &lhs, const CacheFile &rhs) {
+        return lhs.lastUseTime < rhs.lastUseTime;
+    });
+    for (auto &file : cacheFiles) {
+        if (totalSize <= sizeLimit) {
+            break;
+        }
+        // failure means another process removed it already
+        std::remove(file.path.c_str());
+        totalSize -= file.size;
+        filesRemoved++;
+    }
+    return filesRemoved;
+}
+
+CacheFileStatus BinaryCache::verifyCacheFile(const std::string &filePath, const HardwareInfo *hwInfo) {
+    std::stringstream keyPrefix;
+    keyPrefix << "v" << cacheKeyVersion << "-";
+    auto fileName = filePath.substr(filePath.find_last_of("\\/") + 1);
+    if (!endsWith(fileName, cacheFileExtension) || fileName.compare(0, keyPrefix.str().size(), keyPrefix.str()) != 0) {
+        return CacheFileStatus::StaleKey;
+    }
+
+    void *pFile = nullptr;
+    size_t fileSize = loadDataFromFile(filePath.c_str(), pFile);
+    const char *pBinary = nullptr;
+    size_t binarySize = 0;
+    const char *pKernelInfoIndex = nullptr;
+    size_t kernelInfoIndexSize = 0;
+    auto status = CacheFileStatus::Valid;
+
+    if (!unpackCacheFile(static_cast<const char *>(pFile), fileSize, pBinary, binarySize, pKernelInfoIndex, kernelInfoIndexSize)) {
+        status = CacheFileStatus::Corrupted;
+    } else {
+        // same checks the runtime applies before it accepts a gen binary
+        std::vector<KernelInfoIndexEntry> kernelInfoIndex;
+        auto pProgramHeader = reinterpret_cast<const iOpenCL::SProgramBinaryHeader *>(pBinary);
+        if (binarySize < sizeof(iOpenCL::SProgramBinaryHeader) ||
+            pProgramHeader->Version != iOpenCL::CURRENT_ICBE_VERSION ||
+            !KernelInfoIndex::build(pBinary, binarySize, kernelInfoIndex)) {
+            status = CacheFileStatus::Unloadable;
+        } else if (kernelInfoIndexSize > 0 &&
+                   (!KernelInfoIndex::deserialize(pKernelInfoIndex, kernelInfoIndexSize, kernelInfoIndex) ||
+                    !KernelInfoIndex::validate(pBinary, binarySize, kernelInfoIndex))) {
+            status = CacheFileStatus::Corrupted;
+        } else if (hwInfo && pProgramHeader->Device != static_cast<uint32_t>(hwInfo->pPlatform->eRenderCoreFamily)) {
+            status = CacheFileStatus::OtherDevice;
+        }
+    }
+
+    deleteDataReadFromFile(pFile);
+    return status;
+}
+
+const char *BinaryCache::getCacheFileStatusName(CacheFileStatus status) {
+    switch (status) {
+    case CacheFileStatus::Valid:
+        return "valid";
+    case CacheFileStatus::StaleKey:
+        return "stale key";
+    case CacheFileStatus::Corrupted:
+        return "corrupted";
+    case CacheFileStatus::OtherDevice:
+        return "other device";
+    case CacheFileStatus::Unloadable:
+    default:
+        return "unloadable";
+    }
+}
+
+} // namespace OCLRT
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/compiler_interface/binary_cache_memory_tier.h"
+
+#include <functional>
+
+namespace OCLRT {
+
+BinaryCacheMemoryTier::BinaryCacheMemoryTier() : budget(0), hits(0), misses(0), insertions(0), evictions(0), bytesServed(0), cachedBytes(0) {
+}
+
+BinaryCacheMemoryTier::Shard &BinaryCacheMemoryTier::getShard(const std::string &kernelFileHash) {
+    return shards[std::hash<std::string>()(kernelFileHash) % numShards];
+}
+
+BinaryCacheMemoryTier::Binary BinaryCacheMemoryTier::find(const std::string &kernelFileHash) {
+    if (budget == 0) {
+        return nullptr;
+    }
+    Binary binary;
+    {
+        auto &shard = getShard(kernelFileHash);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto it = shard.entries.find(kernelFileHash);
+        if (it != shard.entries.end()) {
+            shard.lruList.splice(shard.lruList.begin(), shard.lruList, it->second);
+            binary = it->second->second;
+        }
+    }
+    if (binary == nullptr) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    bytesServed += binary->size();
+    return binary;
+}
+
+void BinaryCacheMemoryTier::insert(const std::string &kernelFileHash, const char *pBinary, size_t binarySize) {
+    size_t shardBudget = budget / numShards;
+    if (pBinary == nullptr || binarySize == 0 || binarySize > shardBudget) {
+        return;
+    }
+    // copy outside of the shard lock
+    Binary binary = std::make_shared<const std::vector<char>>(pBinary, pBinary + binarySize);
+
+    auto &shard = getShard(kernelFileHash);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto it = shard.entries.find(kernelFileHash);
+    if (it != shard.entries.end()) {
+        shard.cachedBytes -= it->second->second->size();
+        cachedBytes -= it->second->second->size();
+        shard.lruList.erase(it->second);
+        shard.entries.erase(it);
+    }
+    trimLocked(shard, shardBudget - binarySize);
+    shard.lruList.emplace_front(kernelFileHash, binary);
+    shard.entries[kernelFileHash] = shard.lruList.begin();
+    shard.cachedBytes += binarySize;
+    cachedBytes += binarySize;
+    insertions++;
+}
+
+void BinaryCacheMemoryTier::trimLocked(Shard &shard, size_t shardBudget) {
+    while (!shard.lruList.empty() && shard.cachedBytes > shardBudget) {
+        auto &entry = shard.lruList.back();
+        shard.cachedBytes -= entry.second->size();
+        cachedBytes -= entry.second->size();
+        shard.entries.erase(entry.first);
+        shard.lruList.pop_back();
+        evictions++;
+    }
+}
+
+void BinaryCacheMemoryTier::clear() {
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        trimLocked(shard, 0);
+    }
+}
+
+void BinaryCacheMemoryTier::setBudget(size_t budget) {
+    this->budget = budget;
+    for (auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        trimLocked(shard, budget / numShards);
+    }
+}
+
+BinaryCacheMemoryTierStats BinaryCacheMemoryTier::getStats() const {
+    BinaryCacheMemoryTierStats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.insertions = insertions;
+    stats.evictions = evictions;
+    stats.bytesServed = bytesServed;
+    stats.cachedBytes = cachedBytes;
+    return stats;
+}
+} // namespace OCLRT
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OCLRT {
+
+struct BinaryCacheMemoryTierStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    uint64_t bytesServed = 0;
+    uint64_t cachedBytes = 0;
+};
+
+// Process wide, size bounded LRU of cached binaries kept in memory in front of the on-disk cache.
+// Entries are spread over independently locked shards by their hash, so concurrent lookups of different
+// binaries do not serialize, and a lookup only holds a shard lock while it takes a reference to the binary.
+class BinaryCacheMemoryTier {
+  public:
+    using Binary = std::shared_ptr<const std::vector<char>>;
+    static const size_t numShards = 8;
+
+    BinaryCacheMemoryTier();
+
+    BinaryCacheMemoryTier(const BinaryCacheMemoryTier &) = delete;
+    BinaryCacheMemoryTier &operator=(const BinaryCacheMemoryTier &) = delete;
+
+    Binary find(const std::string &kernelFileHash);
+    void insert(const std::string &kernelFileHash, const char *pBinary, size_t binarySize);
+    void clear();
+
+    void setBudget(size_t budget);
+    size_t getBudget() const { return budget; }
+    BinaryCacheMemoryTierStats getStats() const;
+
+  protected:
+    using Entry = std::pair<std::string, Binary>;
+    struct Shard {
+        std::mutex mtx;
+        std::list<Entry> lruList;
+        std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+        size_t cachedBytes = 0;
+    };
+    Shard &getShard(const std::string &kernelFileHash);
+    void trimLocked(Shard &shard, size_t shardBudget);
+
+    std::array<Shard, numShards> shards;
+    std::atomic<size_t> budget;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> insertions;
+    std::atomic<uint64_t> evictions;
+    std::atomic<uint64_t> bytesServed;
+    std::atomic<uint64_t> cachedBytes;
+};
+} // namespace OCLRT
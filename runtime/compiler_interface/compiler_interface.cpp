@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -31,9 +31,11 @@
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "runtime/compiler_interface/compiler_interface.inl"
 #include "runtime/program/program.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/os_inc_base.h"
 
 #include <fstream>
+#include <thread>
 
 namespace OCLRT {
 CompilerInterface *CompilerInterface::pInstance = nullptr;
@@ -81,8 +83,10 @@ cl_int CompilerInterface::build(
         CIF::RAII::UPtr_t<CIF::Builtins::BufferSimple> intermediateRepresentation;
         if (highLevelCodeType != IGC::CodeType::undefined) {
             auto fclTranslationCtx = createFclTranslationCtx(device, highLevelCodeType, intermediateCodeType);
+            std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
             auto fclOutput = translate(fclTranslationCtx.get(), inSrc.get(),
                                        fclOptions.get(), fclInternalOptions.get());
+            translationSlot.unlock();
 
             if (fclOutput == nullptr) {
                 return CL_OUT_OF_HOST_MEMORY;
@@ -114,8 +118,10 @@ cl_int CompilerInterface::build(
         if (!binaryLoaded) {
             auto igcTranslationCtx = createIgcTranslationCtx(device, intermediateCodeType, IGC::CodeType::oclGenBin);
 
+            std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
             auto igcOutput = translate(igcTranslationCtx.get(), intermediateRepresentation.get(),
                                        fclOptions.get(), fclInternalOptions.get());
+            translationSlot.unlock();
 
             if (igcOutput == nullptr) {
                 return CL_OUT_OF_HOST_MEMORY;
@@ -173,8 +179,10 @@ cl_int CompilerInterface::compile(
 
             auto fclTranslationCtx = createFclTranslationCtx(device, inType, outType);
 
+            std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
             auto fclOutput = translate(fclTranslationCtx.get(), fclSrc.get(),
                                        fclOptions.get(), fclInternalOptions.get());
+            translationSlot.unlock();
 
             if (fclOutput == nullptr) {
                 return CL_OUT_OF_HOST_MEMORY;
@@ -228,8 +236,10 @@ cl_int CompilerInterface::link(
             IGC::CodeType::CodeType_t outType = translationChain[ti];
 
             auto igcTranslationCtx = createIgcTranslationCtx(device, inType, outType);
+            std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
             currOut = translate(igcTranslationCtx.get(), currSrc.get(),
                                 igcOptions.get(), igcInternalOptions.get());
+            translationSlot.unlock();
 
             if (currOut == nullptr) {
                 return CL_OUT_OF_HOST_MEMORY;
@@ -268,8 +278,10 @@ cl_int CompilerInterface::createLibrary(
 
         auto igcTranslationCtx = createIgcTranslationCtx(device, IGC::CodeType::elf, IGC::CodeType::llvmBc);
 
+        std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
         auto igcOutput = translate(igcTranslationCtx.get(), igcSrc.get(),
                                    igcOptions.get(), igcInternalOptions.get());
+        translationSlot.unlock();
 
         if (igcOutput == nullptr) {
             return CL_OUT_OF_HOST_MEMORY;
@@ -301,8 +313,10 @@ cl_int CompilerInterface::getSipKernelBinary(SipKernelType kernel, const Device
 
     auto igcTranslationCtx = createIgcTranslationCtx(device, IGC::CodeType::llvmLl, IGC::CodeType::oclGenBin);
 
+    std::unique_lock<ConcurrencyLimiter> translationSlot(translationLimiter);
     auto igcOutput = translate(igcTranslationCtx.get(), igcSrc.get(),
                                igcOptions.get(), igcInternalOptions.get());
+    translationSlot.unlock();
 
     if (igcOutput == nullptr) {
         return CL_OUT_OF_HOST_MEMORY;
@@ -322,10 +336,22 @@ bool CompilerInterface::initialize() {
     compilersModulesSuccessfulyLoaded &= OCLRT::loadCompiler<IGC::IgcOclDeviceCtx>(Os::igcDllName, igcLib, igcMain);
 
     cache.reset(new BinaryCache());
+    translationLimiter.setLimit(getTranslationConcurrencyLimit());
 
     return compilersModulesSuccessfulyLoaded;
 }
 
+uint32_t CompilerInterface::getTranslationConcurrencyLimit() {
+    auto limit = DebugManager.flags.CompilerConcurrencyLimit.get();
+    if (limit < 0) {
+        return 0;
+    }
+    if (limit == 0) {
+        return std::thread::hardware_concurrency();
+    }
+    return static_cast<uint32_t>(limit);
+}
+
 BinaryCache *CompilerInterface::replaceBinaryCache(BinaryCache *newCache) {
     auto res = cache.release();
     this->cache.reset(newCache);
@@ -334,14 +360,17 @@ BinaryCache *CompilerInterface::replaceBinaryCache(BinaryCache *newCache) {
 }
 
 CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = fclDeviceContexts.find(&device);
-    if (it != fclDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
+    {
+        ReadLock readLock(deviceContextsLock);
+        auto it = fclDeviceContexts.find(&device);
+        if (it != fclDeviceContexts.end()) {
+            return it->second->CreateTranslationCtx(inType, outType);
+        }
     }
 
     {
         auto ulock = this->lock();
-        it = fclDeviceContexts.find(&device);
+        auto it = fclDeviceContexts.find(&device);
         if (it != fclDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
@@ -357,7 +386,10 @@ CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclT
             return nullptr;
         }
         newDeviceCtx->SetOclApiVersion(device.getHardwareInfo().capabilityTable.clVersionSupport * 10);
-        fclDeviceContexts[&device] = std::move(newDeviceCtx);
+        {
+            std::unique_lock<ReadWriteLock> writeLock(deviceContextsLock);
+            fclDeviceContexts[&device] = std::move(newDeviceCtx);
+        }
 
         if (fclBaseTranslationCtx == nullptr) {
             fclBaseTranslationCtx = fclDeviceContexts[&device]->CreateTranslationCtx(inType, outType);
@@ -368,14 +400,17 @@ CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclT
 }
 
 CIF::RAII::UPtr_t<IGC::IgcOclTranslationCtxTagOCL> CompilerInterface::createIgcTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = igcDeviceContexts.find(&device);
-    if (it != igcDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
+    {
+        ReadLock readLock(deviceContextsLock);
+        auto it = igcDeviceContexts.find(&device);
+        if (it != igcDeviceContexts.end()) {
+            return it->second->CreateTranslationCtx(inType, outType);
+        }
     }
 
     {
         auto ulock = this->lock();
-        it = igcDeviceContexts.find(&device);
+        auto it = igcDeviceContexts.find(&device);
         if (it != igcDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
@@ -434,7 +469,10 @@ CIF::RAII::UPtr_t<IGC::IgcOclTranslationCtxTagOCL> CompilerInterface::createIgcT
 
         igcFeWa.get()->SetFtrResourceStreamer(device.getHardwareInfo().pSkuTable->ftrResourceStreamer);
 
-        igcDeviceContexts[&device] = std::move(newDeviceCtx);
+        {
+            std::unique_lock<ReadWriteLock> writeLock(deviceContextsLock);
+            igcDeviceContexts[&device] = std::move(newDeviceCtx);
+        }
         return igcDeviceContexts[&device]->CreateTranslationCtx(inType, outType);
     }
 }
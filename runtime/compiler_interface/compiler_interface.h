@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -29,6 +29,8 @@
 #include "runtime/built_ins/sip.h"
 #include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/os_interface/os_library.h"
+#include "runtime/utilities/concurrency_limiter.h"
+#include "runtime/utilities/read_write_lock.h"
 
 #include "CL/cl_platform.h"
 #include <map>
@@ -97,6 +99,9 @@ class CompilerInterface {
 
     bool initialize();
 
+    static uint32_t getTranslationConcurrencyLimit();
+
+    // serializes device context creation only, translations themselves run in parallel
     static std::mutex mtx;
     MOCKABLE_VIRTUAL std::unique_lock<std::mutex> lock() {
         return std::unique_lock<std::mutex>{mtx};
@@ -118,6 +123,11 @@ class CompilerInterface {
     std::map<const Device *, fclDevCtxUptr> fclDeviceContexts;
     CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> fclBaseTranslationCtx = nullptr;
 
+    // guards lookups in device context maps against concurrent insertion (taken exclusively while holding mtx)
+    ReadWriteLock deviceContextsLock;
+    // bounds the number of translations running at the same time
+    ConcurrencyLimiter translationLimiter;
+
     MOCKABLE_VIRTUAL CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> createFclTranslationCtx(const Device &device,
                                                                                                 IGC::CodeType::CodeType_t inType,
                                                                                                 IGC::CodeType::CodeType_t outType);
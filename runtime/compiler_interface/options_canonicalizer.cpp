@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/compiler_interface/options_canonicalizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace OCLRT {
+
+namespace {
+const char *orderIndependentFlags[] = {
+    "-cl-denorms-are-zero",
+    "-cl-fast-relaxed-math",
+    "-cl-finite-math-only",
+    "-cl-fp32-correctly-rounded-divide-sqrt",
+    "-cl-kernel-arg-info",
+    "-cl-mad-enable",
+    "-cl-no-signed-zeros",
+    "-cl-no-subgroup-ifp",
+    "-cl-opt-disable",
+    "-cl-single-precision-constant",
+    "-cl-strict-aliasing",
+    "-cl-uniform-work-group-size",
+    "-cl-unsafe-math-optimizations",
+    "-g",
+    "-w",
+    "-Werror",
+};
+
+// options whose argument is the next token, the pair is kept together and in place
+const char *optionsWithSeparateArgument[] = {
+    "-I",
+    "-U",
+    "-include",
+    "-x",
+};
+
+bool isWhitespace(char c) {
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+bool isOneOf(const std::string &option, const char *const *list, size_t listSize) {
+    for (size_t i = 0; i < listSize; i++) {
+        if (option == list[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string getMacroName(const std::string &definition) {
+    return definition.substr(2, definition.find('=') - 2);
+}
+} // namespace
+
+bool OptionsCanonicalizer::isOrderIndependentFlag(const std::string &option) {
+    return isOneOf(option, orderIndependentFlags, sizeof(orderIndependentFlags) / sizeof(orderIndependentFlags[0]));
+}
+
+std::string OptionsCanonicalizer::canonicalize(const char *options, size_t size) {
+    std::string raw(options, size);
+    while (!raw.empty() && raw.back() == '\0') {
+        raw.pop_back();
+    }
+    if (raw.find_first_of("\"'\\") != std::string::npos) {
+        return raw;
+    }
+
+    std::vector<std::string> tokens;
+    size_t pos = 0;
+    while (pos < raw.size()) {
+        while (pos < raw.size() && isWhitespace(raw[pos])) {
+            pos++;
+        }
+        size_t end = pos;
+        while (end < raw.size() && !isWhitespace(raw[end])) {
+            end++;
+        }
+        if (end > pos) {
+            tokens.push_back(raw.substr(pos, end - pos));
+        }
+        pos = end;
+    }
+
+    // definitions and undefinitions are applied in order, so with any -U present definitions stay in place
+    bool hasUndefinitions = std::any_of(tokens.begin(), tokens.end(), [](const std::string &token) {
+        return token.compare(0, 2, "-U") == 0;
+    });
+
+    std::set<std::string> flags;
+    std::vector<std::string> definitions;
+    std::vector<std::string> others;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        auto &token = tokens[i];
+        bool hasNext = (i + 1 < tokens.size());
+        if (isOrderIndependentFlag(token)) {
+            flags.insert(token);
+        } else if ((token == "-D" && hasNext) || (token.size() > 2 && token.compare(0, 2, "-D") == 0)) {
+            auto definition = (token == "-D") ? token + tokens[++i] : token;
+            (hasUndefinitions ? others : definitions).push_back(definition);
+        } else if (isOneOf(token, optionsWithSeparateArgument, sizeof(optionsWithSeparateArgument) / sizeof(optionsWithSeparateArgument[0])) && hasNext) {
+            others.push_back(token + " " + tokens[++i]);
+        } else {
+            others.push_back(token);
+        }
+    }
+
+    // repeating an identical definition is a no-op, redefining a macro depends on order
+    std::vector<std::string> uniqueDefinitions;
+    std::set<std::string> seenDefinitions;
+    std::set<std::string> macroNames;
+    bool redefinesMacro = false;
+    for (auto &definition : definitions) {
+        if (seenDefinitions.insert(definition).second) {
+            uniqueDefinitions.push_back(definition);
+            redefinesMacro |= !macroNames.insert(getMacroName(definition)).second;
+        }
+    }
+    if (!redefinesMacro) {
+        std::sort(uniqueDefinitions.begin(), uniqueDefinitions.end());
+        definitions.swap(uniqueDefinitions);
+    }
+
+    std::string canonical;
+    canonical.reserve(raw.size());
+    auto append = [&canonical](const std::string &option) {
+        if (!canonical.empty()) {
+            canonical.append(" ");
+        }
+        canonical.append(option);
+    };
+    for (auto &flag : flags) {
+        append(flag);
+    }
+    for (auto &definition : definitions) {
+        append(definition);
+    }
+    for (auto &other : others) {
+        append(other);
+    }
+    return canonical;
+}
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -27,6 +27,7 @@
 #include "runtime/mem_obj/image.h"
 #include "runtime/gtpin/gtpin_notify.h"
 #include "runtime/helpers/get_info.h"
+#include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/platform/platform.h"
 #include "runtime/helpers/string.h"
@@ -45,6 +46,9 @@
 
 namespace OCLRT {
 
+// one for the command queue and one for the command stream receiver
+constexpr size_t warmUpCommandBuffersCount = 2;
+
 Context::Context(
     void(CL_CALLBACK *funcNotify)(const char *, const void *, size_t, void *),
     void *data) {
@@ -106,6 +110,7 @@ bool Context::createImpl(const cl_context_properties *properties,
     auto propertiesCurrent = properties;
     bool interopUserSync = false;
     int32_t driverDiagnosticsUsed = -1;
+    int32_t warmUpLevel = 0;
     auto sharingBuilder = sharingFactory.build();
 
     std::unique_ptr<DriverDiagnostics> driverDiagnostics;
@@ -129,6 +134,9 @@ bool Context::createImpl(const cl_context_properties *properties,
         case CL_CONTEXT_INTEROP_USER_SYNC:
             interopUserSync = propertyValue > 0;
             break;
+        case CL_CONTEXT_WARM_UP_RESOURCES_INTEL:
+            warmUpLevel = static_cast<int32_t>(propertyValue);
+            break;
         default:
             if (!sharingBuilder->processProperties(propertyType, propertyValue, errcodeRet)) {
                 errcodeRet = createContextOsProperties(propertyType, propertyValue);
@@ -182,9 +190,37 @@ bool Context::createImpl(const cl_context_properties *properties,
     DEBUG_BREAK_IF(commandQueue == nullptr);
     overrideSpecialQueueAndDecrementRefCount(commandQueue);
 
+    if (DebugManager.flags.WarmUpContextResources.get() != -1) {
+        warmUpLevel = DebugManager.flags.WarmUpContextResources.get();
+    }
+    if (warmUpLevel > 0) {
+        warmUpResources(warmUpLevel);
+    }
+
     return true;
 }
 
+void Context::warmUpResources(int32_t warmUpLevel) {
+    if (!memoryManager) {
+        return;
+    }
+    // Heaps and command buffers of the first queues are taken from the reuse list.
+    // Smaller allocations are stored first, as the reuse list hands out the first one that fits.
+    auto genericAllocationsCount = static_cast<size_t>(IndirectHeap::NUM_TYPES - 1) + warmUpCommandBuffersCount;
+    memoryManager->preallocateReusableAllocations(genericAllocationsCount, defaultHeapSize);
+    memoryManager->preallocateReusableAllocations(1, optimalInstructionHeapSize);
+    memoryManager->getEventTsAllocator();
+
+    if (warmUpLevel > 1) {
+        auto &builtIns = BuiltIns::getInstance();
+        for (auto device : devices) {
+            builtIns.getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *this, *device);
+            builtIns.getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect, *this, *device);
+            builtIns.getBuiltinDispatchInfoBuilder(EBuiltInOps::FillBuffer, *this, *device);
+        }
+    }
+}
+
 cl_int Context::getInfo(cl_context_info paramName, size_t paramValueSize,
                         void *paramValue, size_t *paramValueSizeRet) {
     cl_int retVal;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -127,6 +127,8 @@ class Context : public BaseObject<_cl_context> {
     Context(void(CL_CALLBACK *pfnNotify)(const char *, const void *, size_t, void *) = nullptr,
             void *userData = nullptr);
 
+    void warmUpResources(int32_t warmUpLevel);
+
     // OS specific implementation
     cl_int createContextOsProperties(cl_context_properties &propertyType, cl_context_properties &propertyValue);
     void *getOsContextInfo(cl_context_info &paramName, size_t *srcParamSize);
@@ -74,6 +74,7 @@ class Device : public BaseObject<_cl_device_id> {
                          size_t *paramValueSizeRet);
 
     bool getDeviceAndHostTimer(uint64_t *deviceTimestamp, uint64_t *hostTimestamp) const;
+    void getMemoryUsageInfo(cl_device_memory_usage_intel &memoryUsage) const;
     bool getHostTimer(uint64_t *hostTimestamp) const;
 
     // Helper functions
@@ -57,7 +57,7 @@ bool Device::getEnabled64kbPages() {
 
 void Device::initializeCaps() {
     deviceExtensions.clear();
-    deviceExtensions.append(deviceExtensionsList);
+    deviceExtensions.append(getExtensionsList(hwInfo));
     // Add our graphics family name to the device name
     auto addressing32bitAllowed = is32BitOsAllocatorAvailable;
     if (is32bit) {
@@ -87,10 +87,7 @@ void Device::initializeCaps() {
     deviceInfo.vendor = vendor.c_str();
     deviceInfo.profile = profile.c_str();
     deviceInfo.ilVersion = "";
-    enabledClVersion = hwInfo.capabilityTable.clVersionSupport;
-    if (DebugManager.flags.ForceOCLVersion.get() != 0) {
-        enabledClVersion = DebugManager.flags.ForceOCLVersion.get();
-    }
+    enabledClVersion = getClVersionToEnable(hwInfo);
     switch (enabledClVersion) {
     case 21:
         deviceInfo.clVersion = "OpenCL 2.1 NEO ";
@@ -115,32 +112,21 @@ void Device::initializeCaps() {
 
     if (enabledClVersion >= 21) {
         deviceInfo.independentForwardProgress = true;
-        deviceExtensions += "cl_khr_subgroups ";
-        deviceExtensions += "cl_khr_il_program ";
     } else {
         deviceInfo.independentForwardProgress = false;
     }
 
-    if (hwInfo.capabilityTable.ftrSupportsFP64) {
-        deviceExtensions += "cl_khr_fp64 ";
-    }
-
     if (DebugManager.flags.EnableNV12.get()) {
-        deviceExtensions += "cl_intel_planar_yuv ";
         deviceInfo.nv12Extension = true;
     }
     if (DebugManager.flags.EnablePackedYuv.get()) {
-        deviceExtensions += "cl_intel_packed_yuv ";
         deviceInfo.packedYuvExtension = true;
     }
     if (DebugManager.flags.EnableIntelVme.get()) {
-        deviceExtensions += "cl_intel_motion_estimation ";
         deviceInfo.vmeExtension = true;
     }
-    if (DebugManager.flags.EnableIntelAdvancedVme.get()) {
-        deviceExtensions += "cl_intel_advanced_motion_estimation ";
-    }
 
+    // cloc -cache_dir composes the same list, sharing extensions depend on the host and are passed to it explicitly
     deviceExtensions += sharingFactory.getExtensions();
 
     simultaneousInterops = {0};
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,6 +25,7 @@
 #include "runtime/device/device_info.h"
 #include "runtime/device/device_info_map.h"
 #include "runtime/helpers/get_info.h"
+#include "runtime/memory_manager/memory_manager.h"
 #include "runtime/platform/platform.h"
 #include "runtime/os_interface/os_time.h"
 
@@ -84,6 +85,7 @@ cl_int Device::getDeviceInfo(cl_device_info paramName,
     size_t srcSize = 0;
     size_t retSize = 0;
     cl_uint param;
+    cl_device_memory_usage_intel memoryUsage;
     const void *src = nullptr;
 
     // clang-format off
@@ -211,6 +213,13 @@ cl_int Device::getDeviceInfo(cl_device_info paramName,
         retSize = srcSize = sizeof(param);
         break;
     }
+    case CL_DEVICE_MEMORY_USAGE_INTEL:
+        if (memoryManager) {
+            getMemoryUsageInfo(memoryUsage);
+            src = &memoryUsage;
+            retSize = srcSize = sizeof(memoryUsage);
+        }
+        break;
     case CL_DEVICE_PLANAR_YUV_MAX_WIDTH_INTEL:
         if (deviceInfo.nv12Extension)
             getCap<CL_DEVICE_PLANAR_YUV_MAX_WIDTH_INTEL>(src, srcSize, retSize);
@@ -230,6 +239,26 @@ cl_int Device::getDeviceInfo(cl_device_info paramName,
     return retVal;
 }
 
+void Device::getMemoryUsageInfo(cl_device_memory_usage_intel &memoryUsage) const {
+    static_assert(CL_MEMORY_USAGE_TYPE_COUNT_INTEL == memoryUsageTypeCount, "memory usage types mismatch");
+    auto copyCounters = [](cl_memory_usage_counters_intel &dst, const MemoryUsageCounters &src) {
+        dst.bytes = src.bytes;
+        dst.allocations = src.allocations;
+        dst.peak_bytes = src.peakBytes;
+    };
+
+    MemoryUsageSnapshot snapshot;
+    memoryManager->getMemoryUsage(snapshot);
+    copyCounters(memoryUsage.total, snapshot.total);
+    for (size_t i = 0; i < memoryUsageTypeCount; i++) {
+        copyCounters(memoryUsage.per_type[i], snapshot.perType[i]);
+    }
+    memoryUsage.os_handles = snapshot.osHandles;
+    memoryUsage.reuse_list_allocations = snapshot.reuseListAllocations;
+    memoryUsage.reuse_list_bytes = snapshot.reuseListBytes;
+    memoryUsage.host_ptr_fragments = snapshot.hostPtrFragments;
+}
+
 bool Device::getDeviceAndHostTimer(uint64_t *deviceTimestamp, uint64_t *hostTimestamp) const {
     TimeStampData queueTimeStamp;
     bool retVal = getOSTime()->getCpuGpuTime(&queueTimeStamp);
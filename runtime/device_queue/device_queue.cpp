@@ -111,22 +111,20 @@ void DeviceQueue::allocateResources() {
     auto &caps = device->getDeviceInfo();
 
     uint32_t alignedQueueSize = alignUp(queueSize, MemoryConstants::pageSize);
-    queueBuffer = device->getMemoryManager()->allocateGraphicsMemory(alignedQueueSize);
+    queueBuffer = device->getMemoryManager()->allocateZeroedGraphicsMemory(alignedQueueSize);
 
     auto eventPoolBufferSize = static_cast<size_t>(caps.maxOnDeviceEvents) * sizeof(IGIL_DeviceEvent) + sizeof(IGIL_EventPool);
     eventPoolBufferSize = alignUp(eventPoolBufferSize, MemoryConstants::pageSize);
-    eventPoolBuffer = device->getMemoryManager()->allocateGraphicsMemory(eventPoolBufferSize);
+    eventPoolBuffer = device->getMemoryManager()->allocateZeroedGraphicsMemory(eventPoolBufferSize);
 
     auto maxEnqueue = static_cast<size_t>(alignedQueueSize) / sizeof(IGIL_CommandHeader);
     auto expectedStackSize = maxEnqueue * sizeof(uint32_t) * 3; // 3 full loads of commands
     expectedStackSize = alignUp(expectedStackSize, MemoryConstants::pageSize);
-    stackBuffer = device->getMemoryManager()->allocateGraphicsMemory(expectedStackSize);
-    memset(stackBuffer->getUnderlyingBuffer(), 0, stackBuffer->getUnderlyingBufferSize());
+    stackBuffer = device->getMemoryManager()->allocateZeroedGraphicsMemory(expectedStackSize);
 
     auto queueStorageSize = alignedQueueSize * 2; // place for 2 full loads of queue_t
     queueStorageSize = alignUp(queueStorageSize, MemoryConstants::pageSize);
-    queueStorageBuffer = device->getMemoryManager()->allocateGraphicsMemory(queueStorageSize);
-    memset(queueStorageBuffer->getUnderlyingBuffer(), 0, queueStorageBuffer->getUnderlyingBufferSize());
+    queueStorageBuffer = device->getMemoryManager()->allocateZeroedGraphicsMemory(queueStorageSize);
 
     auto &hwHelper = HwHelper::get(device->getHardwareInfo().pPlatform->eRenderCoreFamily);
     const size_t IDTSize = numberOfIDTables * interfaceDescriptorEntries * hwHelper.getInterfaceDescriptorDataSize();
@@ -136,23 +134,21 @@ void DeviceQueue::allocateResources() {
     dshSize = alignUp(dshSize, MemoryConstants::pageSize);
     dshBuffer = device->getMemoryManager()->allocateGraphicsMemory(dshSize);
 
-    debugQueue = device->getMemoryManager()->allocateGraphicsMemory(4096);
+    debugQueue = device->getMemoryManager()->allocateZeroedGraphicsMemory(4096);
     debugData = (DebugDataBuffer *)debugQueue->getUnderlyingBuffer();
-    memset(debugQueue->getUnderlyingBuffer(), 0, debugQueue->getUnderlyingBufferSize());
 }
 
 void DeviceQueue::initDeviceQueue() {
     auto igilCmdQueue = reinterpret_cast<IGIL_CommandQueue *>(queueBuffer->getUnderlyingBuffer());
     auto &caps = device->getDeviceInfo();
 
-    memset(queueBuffer->getUnderlyingBuffer(), 0x0, queueBuffer->getUnderlyingBufferSize());
+    // queueBuffer and eventPoolBuffer are allocated zeroed
     igilCmdQueue->m_controls.m_SLBENDoffsetInBytes = -1;
     igilCmdQueue->m_head = IGIL_DEVICE_QUEUE_HEAD_INIT;
     igilCmdQueue->m_size = static_cast<uint32_t>(queueBuffer->getUnderlyingBufferSize() - sizeof(IGIL_CommandQueue));
     igilCmdQueue->m_magic = IGIL_MAGIC_NUMBER;
 
     auto igilEventPool = reinterpret_cast<IGIL_EventPool *>(eventPoolBuffer->getUnderlyingBuffer());
-    memset(eventPoolBuffer->getUnderlyingBuffer(), 0x0, eventPoolBuffer->getUnderlyingBufferSize());
     igilEventPool->m_size = caps.maxOnDeviceEvents;
 }
 
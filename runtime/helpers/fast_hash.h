@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace OCLRT {
+
+// wyhash-style 64-bit hash. Long inputs are consumed 48 bytes per iteration in three
+// independent 64x64->128 multiply lanes, which keeps it several times faster than Hash
+// on kernel sources and binaries. Results are stable across hosts of the same endianness.
+class FastHash {
+  public:
+    explicit FastHash(uint64_t seed = 0) : state(seed) {}
+
+    void update(const char *buff, size_t size) {
+        if (buff == nullptr) {
+            size = 0;
+        }
+        state = hash(buff, size, state);
+    }
+
+    uint64_t finish() const {
+        return state;
+    }
+
+    void reset(uint64_t seed = 0) {
+        state = seed;
+    }
+
+    static uint64_t hash(const char *buff, size_t size, uint64_t seed = 0) {
+        auto p = reinterpret_cast<const uint8_t *>(buff);
+        seed ^= mix(seed ^ secret0, secret1);
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if (size <= 16) {
+            if (size >= 4) {
+                a = (read32(p) << 32) | read32(p + ((size >> 3) << 2));
+                b = (read32(p + size - 4) << 32) | read32(p + size - 4 - ((size >> 3) << 2));
+            } else if (size > 0) {
+                a = read3(p, size);
+            }
+        } else {
+            size_t left = size;
+            if (left > 48) {
+                uint64_t seed1 = seed;
+                uint64_t seed2 = seed;
+                do {
+                    seed = mix(read64(p) ^ secret1, read64(p + 8) ^ seed);
+                    seed1 = mix(read64(p + 16) ^ secret2, read64(p + 24) ^ seed1);
+                    seed2 = mix(read64(p + 32) ^ secret3, read64(p + 40) ^ seed2);
+                    p += 48;
+                    left -= 48;
+                } while (left > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (left > 16) {
+                seed = mix(read64(p) ^ secret1, read64(p + 8) ^ seed);
+                p += 16;
+                left -= 16;
+            }
+            a = read64(p + left - 16);
+            b = read64(p + left - 8);
+        }
+        a ^= secret1;
+        b ^= seed;
+        multiply(a, b);
+        return mix(a ^ secret0 ^ static_cast<uint64_t>(size), b ^ secret1);
+    }
+
+  protected:
+    static const uint64_t secret0 = 0xa0761d6478bd642full;
+    static const uint64_t secret1 = 0xe7037ed1a0b428dbull;
+    static const uint64_t secret2 = 0x8ebc6af09c88c6e3ull;
+    static const uint64_t secret3 = 0x589965cc75374cc3ull;
+
+    static void multiply(uint64_t &a, uint64_t &b) {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t r = a;
+        r *= b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#else
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t = rl + (rm0 << 32);
+        uint64_t c = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    static uint64_t mix(uint64_t a, uint64_t b) {
+        multiply(a, b);
+        return a ^ b;
+    }
+
+    static uint64_t read64(const uint8_t *p) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t read32(const uint8_t *p) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t read3(const uint8_t *p, size_t size) {
+        return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+    }
+
+    uint64_t state;
+};
+} // namespace OCLRT
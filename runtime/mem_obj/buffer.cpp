@@ -92,6 +92,7 @@ Buffer *Buffer::create(Context *context,
     bool isHostPtrSVM = false;
     bool allocateMemory = false;
     bool copyMemoryFromHostPtr = false;
+    size_t svmOffset = 0;
 
     MemoryManager *memoryManager = context->getMemoryManager();
     UNRECOVERABLE_IF(!memoryManager);
@@ -114,8 +115,12 @@ Buffer *Buffer::create(Context *context,
     if (errcodeRet == CL_SUCCESS) {
         while (true) {
             if (flags & CL_MEM_USE_HOST_PTR) {
-                memory = context->getSVMAllocsManager()->getSVMAlloc(hostPtr);
-                if (memory) {
+                SVMAllocsManager::MapBasedAllocationTracker::AllocationRange svmRange;
+                if (context->getSVMAllocsManager()->getSVMAllocRange(hostPtr, svmRange) &&
+                    ptrDiff(hostPtr, svmRange.basePtr) + size <= svmRange.size) {
+                    // svm pointer may be an interior or pooled pointer - address it relative to its allocation
+                    memory = svmRange.allocation;
+                    svmOffset = ptrDiff(hostPtr, memory->getUnderlyingBuffer());
                     zeroCopy = true;
                     isHostPtrSVM = true;
                     copyMemoryFromHostPtr = false;
@@ -149,6 +154,7 @@ Buffer *Buffer::create(Context *context,
                                       ? GraphicsAllocation::ALLOCATION_TYPE_BUFFER
                                       : GraphicsAllocation::ALLOCATION_TYPE_BUFFER | GraphicsAllocation::ALLOCATION_TYPE_WRITABLE;
             memory->setAllocationType(allocationType);
+            memoryManager->getMemoryUsageTracker().registerAllocation(*memory, (!allocateMemory && hostPtr) ? MemoryUsageType::HostPtr : MemoryUsageType::Buffer);
 
             DBG_LOG(LogMemoryObject, __FUNCTION__, "hostPtr:", hostPtr, "size:", size, "memoryStorage:", memory->getUnderlyingBuffer(), "GPU address:", std::hex, memory->getGpuAddress());
 
@@ -159,7 +165,7 @@ Buffer *Buffer::create(Context *context,
             pBuffer = createBufferHw(context,
                                      flags,
                                      size,
-                                     memory->getUnderlyingBuffer(),
+                                     ptrOffset(memory->getUnderlyingBuffer(), svmOffset),
                                      const_cast<void *>(hostPtr),
                                      memory,
                                      zeroCopy,
@@ -171,6 +177,7 @@ Buffer *Buffer::create(Context *context,
             }
 
             if (pBuffer) {
+                pBuffer->offset = svmOffset;
                 pBuffer->setHostPtrMinSize(size);
             }
             break;
@@ -289,6 +289,7 @@ Image *Image::create(Context *context,
                                   ? GraphicsAllocation::ALLOCATION_TYPE_IMAGE
                                   : GraphicsAllocation::ALLOCATION_TYPE_IMAGE | GraphicsAllocation::ALLOCATION_TYPE_WRITABLE;
         memory->setAllocationType(allocationType);
+        memoryManager->getMemoryUsageTracker().registerAllocation(*memory, (zeroCopy && hostPtr) ? MemoryUsageType::HostPtr : MemoryUsageType::Image);
 
         DBG_LOG(LogMemoryObject, __FUNCTION__, "hostPtr:", hostPtr, "size:", memory->getUnderlyingBufferSize(), "memoryStorage:", memory->getUnderlyingBuffer(), "GPU address:", std::hex, memory->getGpuAddress());
 
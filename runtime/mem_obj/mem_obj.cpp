@@ -118,6 +118,8 @@ cl_int MemObj::getMemObjectInfo(cl_mem_info paramName,
     cl_uint mapCount = 0;
     cl_mem clAssociatedMemObject = static_cast<cl_mem>(this->associatedMemObject);
     cl_context ctx = nullptr;
+    // buffers over interior svm pointers use offset for addressing only, it is not a sub-buffer origin
+    size_t memObjOffset = this->associatedMemObject ? offset : 0;
 
     switch (paramName) {
     case CL_MEM_TYPE:
@@ -153,8 +155,8 @@ cl_int MemObj::getMemObjectInfo(cl_mem_info paramName,
         break;
 
     case CL_MEM_OFFSET:
-        srcParamSize = sizeof(offset);
-        srcParam = &offset;
+        srcParamSize = sizeof(memObjOffset);
+        srcParam = &memObjOffset;
         break;
 
     case CL_MEM_ASSOCIATED_MEMOBJECT:
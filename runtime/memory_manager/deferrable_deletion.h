@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,6 +21,8 @@
  */
 #pragma once
 #include "runtime/utilities/idlist.h"
+#include <chrono>
+#include <cstdint>
 
 namespace OCLRT {
 class DeferrableDeletion : public IDNode<DeferrableDeletion> {
@@ -29,5 +31,20 @@ class DeferrableDeletion : public IDNode<DeferrableDeletion> {
     static DeferrableDeletion *create(Args... args);
     virtual void apply() = 0;
     virtual ~DeferrableDeletion() = default;
+
+    // Fence the deletion waits for before releasing its resources, 0 when there is nothing to wait for.
+    // Deletions of one deleter come from one memory manager and share its fence timeline.
+    virtual uint64_t getFenceValue() const { return 0; }
+    virtual void waitForFence() {}
+    void setFenceSignaled() { fenceSignaled = true; }
+
+    void setHighPriority(bool highPriority) { this->highPriority = highPriority; }
+    bool isHighPriority() const { return highPriority; }
+
+  protected:
+    friend class DeferredDeleter;
+    bool highPriority = false;
+    bool fenceSignaled = false;
+    std::chrono::steady_clock::time_point enqueueTime;
 };
 }
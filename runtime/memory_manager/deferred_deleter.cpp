@@ -22,32 +22,52 @@
 
 #include "runtime/memory_manager/deferred_deleter.h"
 #include "runtime/memory_manager/deferrable_deletion.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <algorithm>
 
 namespace OCLRT {
+const size_t DeferredDeleter::maxBatchSize;
+const uint32_t DeferredDeleter::maxWorkersCount;
+const size_t DeferredDeleter::highPrioritySizeThreshold;
+
 DeferredDeleter::DeferredDeleter() {
     doWorkInBackground = false;
     elementsToRelease = 0;
+    startedWorkers = 0;
+    deletionsCompleted = 0;
+    highPriorityDeletionsCompleted = 0;
+    batchesCompleted = 0;
+    maxQueueDepth = 0;
+    totalLatencyInUs = 0;
+    maxLatencyInUs = 0;
+    auto requestedWorkers = DebugManager.flags.DeferredDeleterWorkersCount.get();
+    workersCount = static_cast<uint32_t>(std::max(1, std::min(requestedWorkers, static_cast<int32_t>(maxWorkersCount))));
 }
 
 void DeferredDeleter::stop() {
     // Called with threadMutex acquired
     if (worker != nullptr) {
-        // Working thread was created so we can safely stop it
+        // Working threads were created so we can safely stop them
         std::unique_lock<std::mutex> lock(queueMutex);
-        // Make sure that working thread really started
-        while (!doWorkInBackground) {
+        // Make sure that all working threads really started
+        while (startedWorkers < helperWorkers.size() + 1) {
             lock.unlock();
             lock.lock();
         }
-        // Signal working thread to finish its job
+        // Signal working threads to finish their job
         doWorkInBackground = false;
         lock.unlock();
-        condition.notify_one();
-        // Wait for the working job to exit
+        condition.notify_all();
+        // Wait for the working jobs to exit
         worker->join();
-        // Delete working thread
+        // Delete working threads
         delete worker;
         worker = nullptr;
+        for (auto &helperWorker : helperWorkers) {
+            helperWorker->join();
+        }
+        helperWorkers.clear();
+        startedWorkers = 0;
     }
     drain(false);
 }
@@ -62,9 +82,17 @@ DeferredDeleter::~DeferredDeleter() {
 }
 
 void DeferredDeleter::deferDeletion(DeferrableDeletion *deletion) {
+    deletion->enqueueTime = std::chrono::steady_clock::now();
     std::unique_lock<std::mutex> lock(queueMutex);
-    elementsToRelease++;
-    queue.pushTailOne(*deletion);
+    uint32_t queueDepth = ++elementsToRelease;
+    if (queueDepth > maxQueueDepth) {
+        maxQueueDepth = queueDepth;
+    }
+    if (deletion->isHighPriority()) {
+        highPriorityQueue.pushTailOne(*deletion);
+    } else {
+        queue.pushTailOne(*deletion);
+    }
     lock.unlock();
     condition.notify_one();
 }
@@ -88,6 +116,9 @@ void DeferredDeleter::ensureThread() {
         return;
     }
     worker = new std::thread(run, this);
+    for (uint32_t i = 1; i < workersCount; i++) {
+        helperWorkers.emplace_back(new std::thread(run, this));
+    }
 }
 
 bool DeferredDeleter::areElementsReleased() {
@@ -101,9 +132,10 @@ bool DeferredDeleter::shouldStop() {
 void DeferredDeleter::run(DeferredDeleter *self) {
     std::unique_lock<std::mutex> lock(self->queueMutex);
     // Mark that working thread really started
+    self->startedWorkers++;
     self->doWorkInBackground = true;
     do {
-        if (self->queue.peekIsEmpty()) {
+        if (self->isQueueEmptyLocked()) {
             // Wait for signal that some items are ready to be deleted
             self->condition.wait(lock);
         }
@@ -125,13 +157,86 @@ void DeferredDeleter::drain(bool blocking) {
 }
 
 void DeferredDeleter::clearQueue() {
-    std::unique_ptr<DeferrableDeletion> deletion(nullptr);
+    DeferrableDeletion *batch[maxBatchSize];
+    size_t batchSize = 0;
     do {
-        deletion.reset(queue.removeFrontOne().release());
-        if (deletion) {
-            deletion->apply();
-            elementsToRelease--;
+        batchSize = takeBatch(batch);
+        applyBatch(batch, batchSize);
+    } while (batchSize > 0);
+}
+
+size_t DeferredDeleter::takeBatch(DeferrableDeletion **batch) {
+    // High priority deletions go first, so that large allocations are released before small ones
+    std::lock_guard<std::mutex> lock(queueMutex);
+    size_t batchSize = 0;
+    while (batchSize < maxBatchSize) {
+        auto deletion = highPriorityQueue.removeFrontOne().release();
+        if (deletion == nullptr) {
+            deletion = queue.removeFrontOne().release();
+        }
+        if (deletion == nullptr) {
+            break;
+        }
+        batch[batchSize++] = deletion;
+    }
+    return batchSize;
+}
+
+void DeferredDeleter::applyBatch(DeferrableDeletion **batch, size_t batchSize) {
+    if (batchSize == 0) {
+        return;
+    }
+    uint64_t highPriorityCount = 0;
+    uint64_t batchLatency = 0;
+    uint64_t batchMaxLatency = 0;
+
+    // Waiting once for the latest fence of the batch completes every other deletion in it
+    DeferrableDeletion *latestFenceDeletion = nullptr;
+    for (size_t i = 0; i < batchSize; i++) {
+        auto fenceValue = batch[i]->getFenceValue();
+        if (fenceValue != 0 && (latestFenceDeletion == nullptr || fenceValue > latestFenceDeletion->getFenceValue())) {
+            latestFenceDeletion = batch[i];
+        }
+    }
+    if (latestFenceDeletion) {
+        latestFenceDeletion->waitForFence();
+        for (size_t i = 0; i < batchSize; i++) {
+            batch[i]->setFenceSignaled();
+        }
+    }
+    for (size_t i = 0; i < batchSize; i++) {
+        batch[i]->apply();
+    }
+    auto completionTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < batchSize; i++) {
+        std::unique_ptr<DeferrableDeletion> deletion(batch[i]);
+        auto latency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(completionTime - deletion->enqueueTime).count());
+        batchLatency += latency;
+        batchMaxLatency = std::max(batchMaxLatency, latency);
+        if (deletion->isHighPriority()) {
+            highPriorityCount++;
         }
-    } while (deletion);
+    }
+
+    deletionsCompleted += batchSize;
+    highPriorityDeletionsCompleted += highPriorityCount;
+    batchesCompleted++;
+    totalLatencyInUs += batchLatency;
+    auto currentMaxLatency = maxLatencyInUs.load();
+    while (batchMaxLatency > currentMaxLatency && !maxLatencyInUs.compare_exchange_weak(currentMaxLatency, batchMaxLatency))
+        ;
+    elementsToRelease -= static_cast<int>(batchSize);
+}
+
+DeferredDeleterStats DeferredDeleter::getStats() const {
+    DeferredDeleterStats stats;
+    stats.deletionsCompleted = deletionsCompleted;
+    stats.highPriorityDeletionsCompleted = highPriorityDeletionsCompleted;
+    stats.batchesCompleted = batchesCompleted;
+    stats.queueDepth = static_cast<uint32_t>(std::max(0, elementsToRelease.load()));
+    stats.maxQueueDepth = maxQueueDepth;
+    stats.totalLatencyInUs = totalLatencyInUs;
+    stats.maxLatencyInUs = maxLatencyInUs;
+    return stats;
 }
 } // namespace OCLRT
@@ -21,15 +21,29 @@
 */
 
 #pragma once
+#include "runtime/memory_manager/memory_constants.h"
 #include "runtime/utilities/idlist.h"
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace OCLRT {
 class DeferrableDeletion;
+
+struct DeferredDeleterStats {
+    uint64_t deletionsCompleted = 0;
+    uint64_t highPriorityDeletionsCompleted = 0;
+    uint64_t batchesCompleted = 0;
+    uint32_t queueDepth = 0;
+    uint32_t maxQueueDepth = 0;
+    uint64_t totalLatencyInUs = 0;
+    uint64_t maxLatencyInUs = 0;
+};
+
 class DeferredDeleter {
   public:
     DeferredDeleter();
@@ -46,6 +60,12 @@ class DeferredDeleter {
 
     MOCKABLE_VIRTUAL void drain(bool blocking);
 
+    DeferredDeleterStats getStats() const;
+
+    static const size_t maxBatchSize = 64;
+    static const uint32_t maxWorkersCount = 8;
+    static const size_t highPrioritySizeThreshold = 64 * MemoryConstants::megaByte;
+
   protected:
     void stop();
     void safeStop();
@@ -53,16 +73,32 @@ class DeferredDeleter {
     MOCKABLE_VIRTUAL void clearQueue();
     MOCKABLE_VIRTUAL bool areElementsReleased();
     MOCKABLE_VIRTUAL bool shouldStop();
+    size_t takeBatch(DeferrableDeletion **batch);
+    void applyBatch(DeferrableDeletion **batch, size_t batchSize);
+    bool isQueueEmptyLocked() {
+        return queue.peekIsEmpty() && highPriorityQueue.peekIsEmpty();
+    }
 
     static void run(DeferredDeleter *self);
 
     std::atomic<bool> doWorkInBackground;
     std::atomic<int> elementsToRelease;
     std::thread *worker = nullptr;
+    std::vector<std::unique_ptr<std::thread>> helperWorkers;
+    uint32_t workersCount = 1;
+    std::atomic<uint32_t> startedWorkers;
     int32_t numClients = 0;
-    IDList<DeferrableDeletion, true> queue;
+    IDList<DeferrableDeletion, false> queue;
+    IDList<DeferrableDeletion, false> highPriorityQueue;
     std::mutex queueMutex;
     std::mutex threadMutex;
     std::condition_variable condition;
+
+    std::atomic<uint64_t> deletionsCompleted;
+    std::atomic<uint64_t> highPriorityDeletionsCompleted;
+    std::atomic<uint64_t> batchesCompleted;
+    std::atomic<uint32_t> maxQueueDepth;
+    std::atomic<uint64_t> totalLatencyInUs;
+    std::atomic<uint64_t> maxLatencyInUs;
 };
 } // namespace OCLRT
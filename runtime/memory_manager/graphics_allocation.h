@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -129,12 +129,28 @@ class GraphicsAllocation : public IDNode<GraphicsAllocation> {
     uint32_t peekReuseCount() const { return reuseCount; }
     bool cpuPtrAllocated = false; // flag indicating if cpuPtr is driver-allocated
 
+    GraphicsAllocation *peekPaddingSource() const { return paddingSource; }
+    uint32_t peekPaddedUseCount() const { return paddedUseCount; }
+    const std::vector<GraphicsAllocation *> &peekPaddedAllocations() const { return paddedAllocations; }
+
   private:
     int allocationType;
 
     //this variable can only be modified from SubmissionAggregator
     friend class SubmissionAggregator;
     uint32_t inspectionId = 0;
+
+    //these variables can only be modified from MemoryUsageTracker
+    friend class MemoryUsageTracker;
+    int32_t memoryUsageType = -1;
+    size_t memoryUsageSize = 0;
+
+    //these variables can only be modified from MemoryManager
+    //padded allocations are cached on their source allocation and live until the source is freed
+    friend class MemoryManager;
+    GraphicsAllocation *paddingSource = nullptr;
+    uint32_t paddedUseCount = 0;
+    std::vector<GraphicsAllocation *> paddedAllocations;
 };
 
 using ResidencyContainer = std::vector<GraphicsAllocation *>;
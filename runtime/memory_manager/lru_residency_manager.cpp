@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/lru_residency_manager.h"
+
+#include <iterator>
+
+namespace OCLRT {
+
+void LruResidencyManager::markUsed(GraphicsAllocation &allocation, uint32_t taskCount) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (taskCount != workingSetTaskCount) {
+        workingSetTaskCount = taskCount;
+        workingSetBytes = 0;
+    }
+
+    auto size = allocation.getUnderlyingBufferSize();
+    auto entry = entries.find(&allocation);
+    if (entry == entries.end()) {
+        lruList.push_back({&allocation, taskCount});
+        entries.insert(std::make_pair(&allocation, std::prev(lruList.end())));
+        residentBytes += size;
+        workingSetBytes += size;
+        return;
+    }
+
+    auto &lruEntry = *entry->second;
+    if (lruEntry.lastUsedTaskCount != taskCount) {
+        workingSetBytes += size;
+    }
+    lruEntry.lastUsedTaskCount = taskCount;
+    lruList.splice(lruList.end(), lruList, entry->second);
+}
+
+void LruResidencyManager::remove(GraphicsAllocation &allocation) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto entry = entries.find(&allocation);
+    if (entry == entries.end()) {
+        return;
+    }
+    residentBytes -= allocation.getUnderlyingBufferSize();
+    lruList.erase(entry->second);
+    entries.erase(entry);
+}
+
+size_t LruResidencyManager::evictColdAllocations(const EvictionCallback &evict) {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t evictedCount = 0;
+    auto it = lruList.begin();
+    while (residentBytes > budget && it != lruList.end()) {
+        // allocations used by the current submission are never evicted
+        if (it->lastUsedTaskCount == workingSetTaskCount) {
+            break;
+        }
+        auto allocation = it->allocation;
+        if (!evict(*allocation)) {
+            break;
+        }
+        auto size = allocation->getUnderlyingBufferSize();
+        residentBytes -= size;
+        evictedBytes += size;
+        entries.erase(allocation);
+        it = lruList.erase(it);
+        evictedCount++;
+    }
+    return evictedCount;
+}
+
+bool LruResidencyManager::isTracked(GraphicsAllocation &allocation) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.find(&allocation) != entries.end();
+}
+
+uint32_t LruResidencyManager::getLastUsedTaskCount(GraphicsAllocation &allocation) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto entry = entries.find(&allocation);
+    return entry != entries.end() ? entry->second->lastUsedTaskCount : ObjectNotUsed;
+}
+
+size_t LruResidencyManager::getTrackedAllocationsCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+uint64_t LruResidencyManager::getWorkingSetSize() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return workingSetBytes;
+}
+
+uint32_t LruResidencyManager::getWorkingSetTaskCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return workingSetTaskCount;
+}
+} // namespace OCLRT
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/graphics_allocation.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace OCLRT {
+
+// Tracks allocations used by submissions in least-recently-used order.
+// Every allocation made resident for a submission is marked with that submission's taskCount,
+// which gives both the working set of the current submission and the age of all other allocations.
+// When a budget is set and the tracked bytes exceed it, the OS memory manager evicts allocations
+// coldest first; it decides whether an allocation is still in use by the GPU.
+class LruResidencyManager {
+  public:
+    // returns false when the allocation cannot be evicted yet, which stops the eviction
+    using EvictionCallback = std::function<bool(GraphicsAllocation &)>;
+
+    void setBudget(uint64_t budgetInBytes) { budget = budgetInBytes; }
+    uint64_t getBudget() const { return budget; }
+    bool isEnabled() const { return budget != 0; }
+    bool isBudgetExceeded() const { return budget != 0 && residentBytes.load() > budget; }
+
+    void markUsed(GraphicsAllocation &allocation, uint32_t taskCount);
+    void remove(GraphicsAllocation &allocation);
+    size_t evictColdAllocations(const EvictionCallback &evict);
+
+    bool isTracked(GraphicsAllocation &allocation);
+    uint32_t getLastUsedTaskCount(GraphicsAllocation &allocation);
+    size_t getTrackedAllocationsCount();
+    uint64_t getResidentBytes() const { return residentBytes; }
+    uint64_t getWorkingSetSize();
+    uint32_t getWorkingSetTaskCount();
+    uint64_t getEvictedBytes() const { return evictedBytes; }
+
+  protected:
+    struct LruEntry {
+        GraphicsAllocation *allocation;
+        uint32_t lastUsedTaskCount;
+    };
+    using LruList = std::list<LruEntry>;
+
+    LruList lruList; // front is the least recently used allocation
+    std::unordered_map<GraphicsAllocation *, LruList::iterator> entries;
+    std::mutex mtx;
+
+    uint64_t budget = 0;
+    std::atomic<uint64_t> residentBytes{0};
+    uint64_t workingSetBytes = 0;
+    uint32_t workingSetTaskCount = 0;
+    std::atomic<uint64_t> evictedBytes{0};
+};
+} // namespace OCLRT
@@ -28,6 +28,7 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/utilities/stackvec.h"
 #include "runtime/utilities/tag_allocator.h"
@@ -35,6 +36,7 @@
 #include "runtime/event/perf_counter.h"
 
 #include <algorithm>
+#include <cstring>
 
 namespace OCLRT {
 
@@ -64,8 +66,40 @@ GraphicsAllocation *AllocationsList::detachAllocationImpl(GraphicsAllocation *,
     }
     return nullptr;
 }
+
+struct AllocationsCount {
+    size_t requiredMinimalSize = 0;
+    size_t count = 0;
+    uint64_t totalSize = 0;
+};
+
+size_t AllocationsList::countAllocations(uint64_t &totalSize, size_t requiredMinimalSize) {
+    AllocationsCount counts;
+    counts.requiredMinimalSize = requiredMinimalSize;
+    processLocked<AllocationsList, &AllocationsList::countAllocationsImpl>(nullptr, static_cast<void *>(&counts));
+    totalSize = counts.totalSize;
+    return counts.count;
+}
+
+GraphicsAllocation *AllocationsList::countAllocationsImpl(GraphicsAllocation *, void *data) {
+    auto counts = static_cast<AllocationsCount *>(data);
+    for (auto curr = head; curr != nullptr; curr = curr->next) {
+        if (curr->getUnderlyingBufferSize() >= counts->requiredMinimalSize) {
+            counts->count++;
+            counts->totalSize += curr->getUnderlyingBufferSize();
+        }
+    }
+    return nullptr;
+}
+
 MemoryManager::MemoryManager(bool enable64kbpages) : allocator32Bit(nullptr), enable64kbpages(enable64kbpages) {
     residencyAllocations.reserve(20);
+    if (DebugManager.flags.MemoryUsageDumpSignal.get() > 0) {
+        MemoryUsageTracker::installDumpSignalHandler(DebugManager.flags.MemoryUsageDumpSignal.get());
+    }
+    if (DebugManager.flags.ZeroedAllocationPoolSize.get() > 0) {
+        zeroedAllocationPool.setAllocationsPerSize(DebugManager.flags.ZeroedAllocationPoolSize.get());
+    }
 };
 MemoryManager::~MemoryManager() {
     freeAllocationsList(-1, graphicsAllocations);
@@ -80,9 +114,7 @@ void *MemoryManager::allocateSystemMemory(size_t size, size_t alignment) {
     void *ptr = nullptr;
 
     ptr = alignedMallocWrapper(size, alignment);
-    if (restrictions == nullptr) {
-        return ptr;
-    } else if (restrictions->minAddress == 0) {
+    if (restrictions == nullptr || restrictions->minAddress == 0) {
         return ptr;
     } else {
         if (restrictions->minAddress > reinterpret_cast<uintptr_t>(ptr) && ptr != nullptr) {
@@ -114,6 +146,7 @@ GraphicsAllocation *MemoryManager::allocateGraphicsMemoryForSVM(size_t size, boo
     }
     if (graphicsAllocation) {
         graphicsAllocation->setCoherent(coherent);
+        memoryUsageTracker.registerAllocation(*graphicsAllocation, MemoryUsageType::Svm);
     }
     return graphicsAllocation;
 }
@@ -162,10 +195,52 @@ void MemoryManager::cleanGraphicsMemoryCreatedFromHostPtr(GraphicsAllocation *gr
 }
 
 GraphicsAllocation *MemoryManager::createGraphicsAllocationWithPadding(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding) {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+    for (auto paddedAllocation : inputGraphicsAllocation->paddedAllocations) {
+        if (paddedAllocation->getUnderlyingBufferSize() == sizeWithPadding) {
+            paddedAllocation->paddedUseCount++;
+            return paddedAllocation;
+        }
+    }
+
     if (!paddingAllocation) {
         paddingAllocation = allocateGraphicsMemory(paddingBufferSize, MemoryConstants::pageSize);
     }
-    return createPaddedAllocation(inputGraphicsAllocation, sizeWithPadding);
+    auto paddedAllocation = createPaddedAllocation(inputGraphicsAllocation, sizeWithPadding);
+    if (paddedAllocation && DebugManager.flags.EnablePaddedAllocationReuse.get()) {
+        paddedAllocation->paddingSource = inputGraphicsAllocation;
+        paddedAllocation->paddedUseCount = 1;
+        inputGraphicsAllocation->paddedAllocations.push_back(paddedAllocation);
+        hasPaddedAllocations = true;
+    }
+    return paddedAllocation;
+}
+
+bool MemoryManager::releasePaddedAllocation(GraphicsAllocation *paddedAllocation) {
+    std::lock_guard<decltype(mtx)> lock(mtx);
+    if (!paddedAllocation->paddingSource) {
+        return false;
+    }
+    DEBUG_BREAK_IF(paddedAllocation->paddedUseCount == 0);
+    paddedAllocation->paddedUseCount--;
+    return true;
+}
+
+void MemoryManager::freePaddedAllocations(GraphicsAllocation *sourceAllocation) {
+    std::vector<GraphicsAllocation *> paddedAllocationsToFree;
+    {
+        std::lock_guard<decltype(mtx)> lock(mtx);
+        paddedAllocationsToFree.swap(sourceAllocation->paddedAllocations);
+    }
+    for (auto paddedAllocation : paddedAllocationsToFree) {
+        DEBUG_BREAK_IF(paddedAllocation->paddedUseCount != 0);
+        paddedAllocation->paddingSource = nullptr;
+        if (csr && paddedAllocation->taskCount != ObjectNotUsed && paddedAllocation->taskCount > *csr->getTagAddress()) {
+            storeAllocation(std::unique_ptr<GraphicsAllocation>(paddedAllocation), TEMPORARY_ALLOCATION);
+        } else {
+            freeGraphicsMemory(paddedAllocation);
+        }
+    }
 }
 
 GraphicsAllocation *MemoryManager::createPaddedAllocation(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding) {
@@ -213,6 +288,27 @@ std::unique_ptr<GraphicsAllocation> MemoryManager::obtainReusableAllocation(size
     return allocation;
 }
 
+size_t MemoryManager::preallocateReusableAllocations(size_t count, size_t size) {
+    // every context warms up, only allocations missing from the reuse list are added so it does not grow per context
+    uint64_t reusableBytes = 0;
+    auto reusableCount = allocationsForReuse.countAllocations(reusableBytes, size);
+    if (reusableCount >= count) {
+        return 0;
+    }
+    count -= reusableCount;
+    size_t allocationsCount = 0;
+    for (; allocationsCount < count; allocationsCount++) {
+        auto allocation = allocateGraphicsMemory(size, MemoryConstants::pageSize);
+        if (!allocation) {
+            break;
+        }
+        // fault pages in now rather than in the first submissions
+        memset(allocation->getUnderlyingBuffer(), 0, allocation->getUnderlyingBufferSize());
+        storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
+    }
+    return allocationsCount;
+}
+
 void MemoryManager::setForce32BitAllocations(bool newValue) {
     if (newValue && !this->allocator32Bit) {
         this->allocator32Bit.reset(new Allocator32bit);
@@ -221,6 +317,8 @@ void MemoryManager::setForce32BitAllocations(bool newValue) {
 }
 
 void MemoryManager::applyCommonCleanup() {
+    dumpMemoryUsage();
+    zeroedAllocationPool.cleanUpResources();
     if (this->paddingAllocation) {
         this->freeGraphicsMemory(this->paddingAllocation);
     }
@@ -237,6 +335,9 @@ void MemoryManager::applyCommonCleanup() {
 bool MemoryManager::cleanAllocationList(uint32_t waitTaskCount, uint32_t allocationType) {
     std::lock_guard<decltype(mtx)> lock(mtx);
     freeAllocationsList(waitTaskCount, (allocationType == TEMPORARY_ALLOCATION) ? graphicsAllocations : allocationsForReuse);
+    if (memoryUsageTracker.isDumpRequested()) {
+        dumpMemoryUsage();
+    }
     return false;
 }
 
@@ -290,6 +391,20 @@ void MemoryManager::clearEvictionAllocations() {
 }
 
 void MemoryManager::freeGraphicsMemory(GraphicsAllocation *gfxAllocation) {
+    if (gfxAllocation) {
+        if (hasPaddedAllocations) {
+            if (releasePaddedAllocation(gfxAllocation)) {
+                return;
+            }
+            if (!gfxAllocation->paddedAllocations.empty()) {
+                freePaddedAllocations(gfxAllocation);
+            }
+        }
+        memoryUsageTracker.unregisterAllocation(*gfxAllocation);
+    }
+    if (gfxAllocation && lruResidencyManager.isEnabled()) {
+        lruResidencyManager.remove(*gfxAllocation);
+    }
     freeGraphicsMemoryImpl(gfxAllocation);
 }
 //if not in use destroy in place
@@ -312,6 +427,32 @@ bool MemoryManager::isAsyncDeleterEnabled() const {
     return asyncDeleterEnabled;
 }
 
+void MemoryManager::getMemoryUsage(MemoryUsageSnapshot &snapshot) {
+    memoryUsageTracker.fillSnapshot(snapshot);
+    snapshot.reuseListAllocations = allocationsForReuse.countAllocations(snapshot.reuseListBytes);
+    snapshot.hostPtrFragments = hostPtrManager.getFragmentCount();
+    get32BitHeapStatistics(MemoryType::EXTERNAL_ALLOCATION, snapshot.heap32BitExternal);
+    get32BitHeapStatistics(MemoryType::INTERNAL_ALLOCATION, snapshot.heap32BitInternal);
+}
+
+void MemoryManager::dumpMemoryUsage() {
+    auto fileName = DebugManager.flags.MemoryUsageDumpFile.get();
+    if (fileName == "unk") {
+        return;
+    }
+    MemoryUsageSnapshot snapshot;
+    getMemoryUsage(snapshot);
+    auto dump = MemoryUsageTracker::formatSnapshot(snapshot);
+    DebugManager.writeToFile(fileName, dump.c_str(), dump.size(), std::ios::app);
+}
+
+bool MemoryManager::get32BitHeapStatistics(MemoryType memoryType, HeapStatistics &stats) {
+    if (memoryType != MemoryType::EXTERNAL_ALLOCATION || !allocator32Bit) {
+        return false;
+    }
+    return allocator32Bit->getStatistics(stats);
+}
+
 bool MemoryManager::isMemoryBudgetExhausted() const {
     return false;
 }
@@ -24,10 +24,14 @@
 #include "runtime/memory_manager/host_ptr_defines.h"
 #include "runtime/memory_manager/host_ptr_manager.h"
 #include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/lru_residency_manager.h"
+#include "runtime/memory_manager/memory_usage_tracker.h"
+#include "runtime/memory_manager/zeroed_allocation_pool.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/utilities/tag_allocator_base.h"
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <mutex>
@@ -70,9 +74,11 @@ constexpr size_t paddingBufferSize = 2 * MemoryConstants::megaByte;
 class AllocationsList : public IDList<GraphicsAllocation, true, true> {
   public:
     std::unique_ptr<GraphicsAllocation> detachAllocation(size_t requiredMinimalSize, volatile uint32_t *csrTagAddress = nullptr);
+    size_t countAllocations(uint64_t &totalSize, size_t requiredMinimalSize = 0);
 
   private:
     GraphicsAllocation *detachAllocationImpl(GraphicsAllocation *, void *);
+    GraphicsAllocation *countAllocationsImpl(GraphicsAllocation *, void *);
 };
 
 class Gmm;
@@ -103,6 +109,10 @@ class MemoryManager {
 
     virtual GraphicsAllocation *allocateGraphicsMemory64kb(size_t size, size_t alignment, bool forcePin) = 0;
 
+    GraphicsAllocation *allocateZeroedGraphicsMemory(size_t size) {
+        return zeroedAllocationPool.obtainZeroedAllocation(size);
+    }
+
     virtual GraphicsAllocation *allocateGraphicsMemory(size_t size, const void *ptr) {
         return MemoryManager::allocateGraphicsMemory(size, ptr, false);
     }
@@ -132,6 +142,8 @@ class MemoryManager {
     void cleanGraphicsMemoryCreatedFromHostPtr(GraphicsAllocation *);
     GraphicsAllocation *createGraphicsAllocationWithPadding(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding);
     virtual GraphicsAllocation *createPaddedAllocation(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding);
+    bool releasePaddedAllocation(GraphicsAllocation *paddedAllocation);
+    void freePaddedAllocations(GraphicsAllocation *sourceAllocation);
 
     virtual AllocationStatus populateOsHandles(OsHandleStorage &handleStorage) = 0;
     virtual void cleanOsHandles(OsHandleStorage &handleStorage) = 0;
@@ -165,6 +177,8 @@ class MemoryManager {
     TagAllocator<HwPerfCounter> *getEventPerfCountAllocator();
 
     std::unique_ptr<GraphicsAllocation> obtainReusableAllocation(size_t requiredSize);
+    // Tops the reuse list up to count allocations of at least size bytes, returns the number of allocations added
+    size_t preallocateReusableAllocations(size_t count, size_t size);
 
     //intrusive list of allocation
     AllocationsList graphicsAllocations;
@@ -216,6 +230,19 @@ class MemoryManager {
     ResidencyContainer &getEvictionAllocations() {
         return evictionAllocations;
     }
+    LruResidencyManager &getLruResidencyManager() {
+        return lruResidencyManager;
+    }
+    MemoryUsageTracker &getMemoryUsageTracker() {
+        return memoryUsageTracker;
+    }
+    virtual bool get32BitHeapStatistics(MemoryType memoryType, HeapStatistics &stats);
+
+    ZeroedAllocationPool &getZeroedAllocationPool() {
+        return zeroedAllocationPool;
+    }
+    virtual void getMemoryUsage(MemoryUsageSnapshot &snapshot);
+    void dumpMemoryUsage();
 
     DeferredDeleter *getDeferredDeleter() const {
         return deferredDeleter.get();
@@ -225,6 +252,8 @@ class MemoryManager {
 
     bool isAsyncDeleterEnabled() const;
     virtual bool isMemoryBudgetExhausted() const;
+    // OS memory managers that control residency evict least recently used allocations over the budget
+    virtual void evictColdAllocations() {}
 
     virtual AlignedMallocRestrictions *getAlignedMallocRestrictions() {
         return nullptr;
@@ -238,6 +267,7 @@ class MemoryManager {
         ::alignedFree(ptr);
     }
 
+
   protected:
     std::recursive_mutex mtx;
     std::unique_ptr<TagAllocatorBase> profilingTimeStampAllocator;
@@ -248,6 +278,10 @@ class MemoryManager {
     void applyCommonCleanup();
     ResidencyContainer residencyAllocations;
     ResidencyContainer evictionAllocations;
+    LruResidencyManager lruResidencyManager;
+    MemoryUsageTracker memoryUsageTracker;
+    ZeroedAllocationPool zeroedAllocationPool{*this};
+    std::atomic<bool> hasPaddedAllocations{false};
     std::unique_ptr<DeferredDeleter> deferredDeleter;
     bool asyncDeleterEnabled = false;
     bool enable64kbpages = false;
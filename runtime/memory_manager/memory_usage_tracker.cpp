@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/memory_usage_tracker.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+
+#include <sstream>
+#include <utility>
+
+namespace OCLRT {
+
+volatile std::sig_atomic_t MemoryUsageTracker::dumpRequests = 0;
+
+void MemoryUsageTracker::registerAllocation(GraphicsAllocation &allocation, MemoryUsageType type) {
+    if (allocation.memoryUsageType != -1 || type >= MemoryUsageType::Count) {
+        return;
+    }
+    allocation.memoryUsageType = static_cast<int32_t>(type);
+    allocation.memoryUsageSize = allocation.getUnderlyingBufferSize();
+    add(perType[static_cast<size_t>(type)], allocation.memoryUsageSize);
+    add(total, allocation.memoryUsageSize);
+}
+
+void MemoryUsageTracker::unregisterAllocation(GraphicsAllocation &allocation) {
+    if (allocation.memoryUsageType == -1) {
+        return;
+    }
+    subtract(perType[allocation.memoryUsageType], allocation.memoryUsageSize);
+    subtract(total, allocation.memoryUsageSize);
+    allocation.memoryUsageType = -1;
+    allocation.memoryUsageSize = 0;
+}
+
+bool MemoryUsageTracker::isTracked(const GraphicsAllocation &allocation) const {
+    return allocation.memoryUsageType != -1;
+}
+
+MemoryUsageCounters MemoryUsageTracker::getCounters(MemoryUsageType type) const {
+    return read(perType[static_cast<size_t>(type)]);
+}
+
+MemoryUsageCounters MemoryUsageTracker::getTotalCounters() const {
+    return read(total);
+}
+
+void MemoryUsageTracker::fillSnapshot(MemoryUsageSnapshot &snapshot) const {
+    snapshot.total = read(total);
+    for (size_t i = 0; i < memoryUsageTypeCount; i++) {
+        snapshot.perType[i] = read(perType[i]);
+    }
+}
+
+const char *MemoryUsageTracker::getTypeName(MemoryUsageType type) {
+    switch (type) {
+    case MemoryUsageType::Buffer:
+        return "Buffer";
+    case MemoryUsageType::Image:
+        return "Image";
+    case MemoryUsageType::CommandBuffer:
+        return "CommandBuffer";
+    case MemoryUsageType::Heap:
+        return "Heap";
+    case MemoryUsageType::TimestampTag:
+        return "TimestampTag";
+    case MemoryUsageType::HostPtr:
+        return "HostPtr";
+    case MemoryUsageType::Svm:
+        return "Svm";
+    case MemoryUsageType::Internal:
+        return "Internal";
+    default:
+        return "Unknown";
+    }
+}
+
+std::string MemoryUsageTracker::formatSnapshot(const MemoryUsageSnapshot &snapshot) {
+    std::stringstream ss;
+    ss << "type bytes allocations peakBytes\n";
+    for (size_t i = 0; i < memoryUsageTypeCount; i++) {
+        auto &counters = snapshot.perType[i];
+        ss << getTypeName(static_cast<MemoryUsageType>(i)) << " " << counters.bytes << " " << counters.allocations << " " << counters.peakBytes << "\n";
+    }
+    ss << "Total " << snapshot.total.bytes << " " << snapshot.total.allocations << " " << snapshot.total.peakBytes << "\n";
+    ss << "OsHandles " << snapshot.osHandles << "\n";
+    ss << "ReuseListAllocations " << snapshot.reuseListAllocations << "\n";
+    ss << "ReuseListBytes " << snapshot.reuseListBytes << "\n";
+    ss << "HostPtrFragments " << snapshot.hostPtrFragments << "\n";
+    if (snapshot.numaNode >= 0) {
+        ss << "NumaNode " << snapshot.numaNode << " placedBytes " << snapshot.numaPlacedBytes << " failedPlacements " << snapshot.numaFailedPlacements << "\n";
+    }
+    if (snapshot.hugePageAdvisedBytes) {
+        ss << "HugePages advisedBytes " << snapshot.hugePageAdvisedBytes << " backedBytes " << snapshot.hugePageBackedBytes << "\n";
+    }
+    const std::pair<const char *, const HeapStatistics *> heaps[] = {{"Heap32BitExternal", &snapshot.heap32BitExternal},
+                                                                      {"Heap32BitInternal", &snapshot.heap32BitInternal}};
+    for (auto &heap : heaps) {
+        if (heap.second->totalSize == 0) {
+            continue;
+        }
+        ss << heap.first << " used " << heap.second->usedSize << " free " << heap.second->freeSize
+           << " largestFreeBlock " << heap.second->largestFreeBlockSize << " freeChunks " << heap.second->freeChunksCount
+           << " fragmentation " << heap.second->getFragmentation() << "\n";
+    }
+    return ss.str();
+}
+
+static void memoryUsageDumpSignalHandler(int) {
+    MemoryUsageTracker::requestDump();
+}
+
+bool MemoryUsageTracker::installDumpSignalHandler(int signalNumber) {
+    return std::signal(signalNumber, memoryUsageDumpSignalHandler) != SIG_ERR;
+}
+
+void MemoryUsageTracker::requestDump() {
+    dumpRequests = dumpRequests + 1;
+}
+
+bool MemoryUsageTracker::isDumpRequested() {
+    int requests = static_cast<int>(dumpRequests);
+    int handled = handledDumpRequests.load();
+    if (requests == handled) {
+        return false;
+    }
+    return handledDumpRequests.compare_exchange_strong(handled, requests);
+}
+
+void MemoryUsageTracker::add(AtomicCounters &counters, uint64_t size) {
+    counters.allocations++;
+    auto bytes = counters.bytes.fetch_add(size) + size;
+    auto peak = counters.peakBytes.load();
+    while (bytes > peak && !counters.peakBytes.compare_exchange_weak(peak, bytes)) {
+    }
+}
+
+void MemoryUsageTracker::subtract(AtomicCounters &counters, uint64_t size) {
+    DEBUG_BREAK_IF(counters.allocations.load() == 0);
+    counters.allocations--;
+    counters.bytes -= size;
+}
+
+MemoryUsageCounters MemoryUsageTracker::read(const AtomicCounters &counters) {
+    MemoryUsageCounters result;
+    result.bytes = counters.bytes.load();
+    result.allocations = counters.allocations.load();
+    result.peakBytes = counters.peakBytes.load();
+    return result;
+}
+} // namespace OCLRT
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/heap_allocator.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <string>
+
+namespace OCLRT {
+class GraphicsAllocation;
+
+enum class MemoryUsageType : uint32_t {
+    Buffer = 0,
+    Image,
+    CommandBuffer,
+    Heap,
+    TimestampTag,
+    HostPtr,
+    Svm,
+    Internal,
+    Count
+};
+
+constexpr size_t memoryUsageTypeCount = static_cast<size_t>(MemoryUsageType::Count);
+
+struct MemoryUsageCounters {
+    uint64_t bytes = 0;
+    uint64_t allocations = 0;
+    uint64_t peakBytes = 0;
+};
+
+struct MemoryUsageSnapshot {
+    MemoryUsageCounters total;
+    MemoryUsageCounters perType[memoryUsageTypeCount];
+    uint64_t osHandles = 0;
+    uint64_t reuseListAllocations = 0;
+    uint64_t reuseListBytes = 0;
+    uint64_t hostPtrFragments = 0;
+    int numaNode = -1;
+    uint64_t numaPlacedBytes = 0;
+    uint64_t numaFailedPlacements = 0;
+    uint64_t hugePageAdvisedBytes = 0;
+    uint64_t hugePageBackedBytes = 0;
+    HeapStatistics heap32BitExternal;
+    HeapStatistics heap32BitInternal;
+};
+
+// Always-on accounting of graphics memory by purpose.
+// An allocation is attributed to the type it is first registered with and stays there until it is freed,
+// so an allocation wrapped by several objects (e.g. an image created from a buffer) is counted once.
+// Counters are plain atomics, registering and unregistering never takes a lock.
+class MemoryUsageTracker {
+  public:
+    void registerAllocation(GraphicsAllocation &allocation, MemoryUsageType type);
+    void unregisterAllocation(GraphicsAllocation &allocation);
+    bool isTracked(const GraphicsAllocation &allocation) const;
+
+    MemoryUsageCounters getCounters(MemoryUsageType type) const;
+    MemoryUsageCounters getTotalCounters() const;
+    void fillSnapshot(MemoryUsageSnapshot &snapshot) const;
+
+    static const char *getTypeName(MemoryUsageType type);
+    static std::string formatSnapshot(const MemoryUsageSnapshot &snapshot);
+
+    // Dumps requested by a signal are picked up by every tracker on its next poll
+    static bool installDumpSignalHandler(int signalNumber);
+    static void requestDump();
+    bool isDumpRequested();
+
+  protected:
+    struct AtomicCounters {
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> peakBytes{0};
+    };
+
+    static void add(AtomicCounters &counters, uint64_t size);
+    static void subtract(AtomicCounters &counters, uint64_t size);
+    static MemoryUsageCounters read(const AtomicCounters &counters);
+
+    AtomicCounters perType[memoryUsageTypeCount];
+    AtomicCounters total;
+    std::atomic<int> handledDumpRequests{0};
+
+    static volatile std::sig_atomic_t dumpRequests;
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,72 +23,196 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/heap_allocator.h"
 
 namespace OCLRT {
 
+const size_t SVMAllocsManager::svmPoolSize = 2 * MemoryConstants::megaByte;
+const size_t SVMAllocsManager::svmPoolAllocationThreshold = 64 * MemoryConstants::kiloByte;
+
+SVMAllocsManager::SvmAllocationPool::SvmAllocationPool(GraphicsAllocation &poolAllocation) : poolAllocation(poolAllocation) {
+    heapAllocator.reset(new HeapAllocator(poolAllocation.getUnderlyingBuffer(), poolAllocation.getUnderlyingBufferSize()));
+}
+
+SVMAllocsManager::SvmAllocationPool::~SvmAllocationPool() = default;
+
+void *SVMAllocsManager::SvmAllocationPool::allocate(size_t &size) {
+    auto ptr = heapAllocator->allocate(size);
+    if (ptr) {
+        allocationsCount++;
+    }
+    return ptr;
+}
+
+void SVMAllocsManager::SvmAllocationPool::free(void *ptr, size_t size) {
+    DEBUG_BREAK_IF(allocationsCount == 0);
+    heapAllocator->free(ptr, size);
+    allocationsCount--;
+}
+
 void SVMAllocsManager::MapBasedAllocationTracker::insert(GraphicsAllocation &ga) {
-    allocs.insert(std::make_pair(ga.getUnderlyingBuffer(), &ga));
+    insert({ga.getUnderlyingBuffer(), ga.getUnderlyingBufferSize(), &ga, nullptr});
+}
+
+void SVMAllocsManager::MapBasedAllocationTracker::insert(const AllocationRange &range) {
+    allocs.insert(std::make_pair(range.basePtr, range));
 }
 
 void SVMAllocsManager::MapBasedAllocationTracker::remove(GraphicsAllocation &ga) {
-    std::map<const void *, GraphicsAllocation *>::iterator iter;
-    iter = allocs.find(ga.getUnderlyingBuffer());
-    allocs.erase(iter);
+    remove(ga.getUnderlyingBuffer());
 }
 
-GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) {
-    std::map<const void *, GraphicsAllocation *>::iterator Iter, End;
-    GraphicsAllocation *GA;
-    if (ptr == nullptr)
+void SVMAllocsManager::MapBasedAllocationTracker::remove(const void *basePtr) {
+    auto iter = allocs.find(basePtr);
+    if (iter != allocs.end()) {
+        allocs.erase(iter);
+    }
+}
+
+const SVMAllocsManager::MapBasedAllocationTracker::AllocationRange *SVMAllocsManager::MapBasedAllocationTracker::getRange(const void *ptr) const {
+    if (ptr == nullptr) {
         return nullptr;
-    End = allocs.end();
-    Iter = allocs.lower_bound(ptr);
-    if (((Iter != End) && (Iter->first != ptr)) ||
-        (Iter == End)) {
-        if (Iter == allocs.begin()) {
-            Iter = End;
-        } else {
-            Iter--;
-        }
     }
-    if (Iter != End) {
-        GA = Iter->second;
-        if (ptr < ((char *)GA->getUnderlyingBuffer() + GA->getUnderlyingBufferSize())) {
-            return GA;
-        }
+    // first allocation starting above ptr; the only candidate containing ptr is the one just before it
+    auto iter = allocs.upper_bound(ptr);
+    if (iter == allocs.begin()) {
+        return nullptr;
+    }
+    --iter;
+    const auto &range = iter->second;
+    if (ptr < ptrOffset(range.basePtr, range.size)) {
+        return &range;
     }
     return nullptr;
 }
 
+GraphicsAllocation *SVMAllocsManager::MapBasedAllocationTracker::get(const void *ptr) {
+    auto range = getRange(ptr);
+    return range ? range->allocation : nullptr;
+}
+
 SVMAllocsManager::SVMAllocsManager(MemoryManager *memoryManager) : memoryManager(memoryManager) {
+    poolingEnabled = DebugManager.flags.EnableSvmAllocationPool.get();
+}
+
+SVMAllocsManager::~SVMAllocsManager() {
+    for (auto pools : {&coherentPools, &nonCoherentPools}) {
+        for (auto &pool : *pools) {
+            memoryManager->freeGraphicsMemory(&pool->getGraphicsAllocation());
+        }
+        pools->clear();
+    }
 }
 
 void *SVMAllocsManager::createSVMAlloc(size_t size, bool coherent) {
     if (size == 0)
         return nullptr;
 
-    std::unique_lock<std::mutex> lock(mtx);
+    if (poolingEnabled && size <= svmPoolAllocationThreshold) {
+        return createPooledSVMAlloc(size, coherent);
+    }
+
     GraphicsAllocation *GA = memoryManager->allocateGraphicsMemoryForSVM(size, coherent);
     if (!GA) {
         return nullptr;
     }
+    std::unique_lock<ReadWriteLock> lock(mtx);
     this->SVMAllocs.insert(*GA);
 
     return GA->getUnderlyingBuffer();
 }
 
+void *SVMAllocsManager::createPooledSVMAlloc(size_t size, bool coherent) {
+    auto &pools = coherent ? coherentPools : nonCoherentPools;
+    {
+        std::unique_lock<ReadWriteLock> lock(mtx);
+        for (auto &pool : pools) {
+            auto ptr = allocateFromPool(*pool, size);
+            if (ptr) {
+                return ptr;
+            }
+        }
+    }
+
+    // all pools are full - create a new one without blocking lookups and frees
+    GraphicsAllocation *poolAllocation = memoryManager->allocateGraphicsMemoryForSVM(svmPoolSize, coherent);
+    if (!poolAllocation) {
+        return nullptr;
+    }
+
+    std::unique_lock<ReadWriteLock> lock(mtx);
+    pools.emplace_back(new SvmAllocationPool(*poolAllocation));
+    auto ptr = allocateFromPool(*pools.back(), size);
+    DEBUG_BREAK_IF(ptr == nullptr);
+    return ptr;
+}
+
+void *SVMAllocsManager::allocateFromPool(SvmAllocationPool &pool, size_t size) {
+    size_t sizeToAllocate = size;
+    auto ptr = pool.allocate(sizeToAllocate);
+    if (ptr) {
+        SVMAllocs.insert({ptr, sizeToAllocate, &pool.getGraphicsAllocation(), &pool});
+    }
+    return ptr;
+}
+
+bool SVMAllocsManager::hasOtherEmptyPool(const std::vector<std::unique_ptr<SvmAllocationPool>> &pools, const SvmAllocationPool *pool) const {
+    for (auto &otherPool : pools) {
+        if (otherPool.get() != pool && otherPool->isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 GraphicsAllocation *SVMAllocsManager::getSVMAlloc(const void *ptr) {
-    std::unique_lock<std::mutex> lock(mtx);
+    ReadLock lock(mtx);
     return SVMAllocs.get(ptr);
 }
 
+bool SVMAllocsManager::getSVMAllocRange(const void *ptr, MapBasedAllocationTracker::AllocationRange &range) {
+    ReadLock lock(mtx);
+    auto foundRange = SVMAllocs.getRange(ptr);
+    if (foundRange == nullptr) {
+        return false;
+    }
+    range = *foundRange;
+    return true;
+}
+
 void SVMAllocsManager::freeSVMAlloc(void *ptr) {
-    GraphicsAllocation *GA = getSVMAlloc(ptr);
-    if (GA) {
-        std::unique_lock<std::mutex> lock(mtx);
-        SVMAllocs.remove(*GA);
-        memoryManager->freeGraphicsMemory(GA);
+    GraphicsAllocation *allocationToFree = nullptr;
+    {
+        std::unique_lock<ReadWriteLock> lock(mtx);
+        auto range = SVMAllocs.getRange(ptr);
+        if (range == nullptr) {
+            return;
+        }
+        auto pool = range->pool;
+        if (pool == nullptr) {
+            allocationToFree = range->allocation;
+            SVMAllocs.remove(range->basePtr);
+        } else {
+            pool->free(const_cast<void *>(range->basePtr), range->size);
+            SVMAllocs.remove(range->basePtr);
+            // keep one empty pool per coherency type so alloc/free churn does not recreate pools
+            auto &pools = pool->getGraphicsAllocation().isCoherent() ? coherentPools : nonCoherentPools;
+            if (pool->isEmpty() && hasOtherEmptyPool(pools, pool)) {
+                allocationToFree = &pool->getGraphicsAllocation();
+                for (auto it = pools.begin(); it != pools.end(); it++) {
+                    if (it->get() == pool) {
+                        pools.erase(it);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    if (allocationToFree) {
+        memoryManager->freeGraphicsMemory(allocationToFree);
     }
 }
 } // namespace OCLRT
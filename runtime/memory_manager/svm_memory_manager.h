@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,38 +21,80 @@
  */
 
 #pragma once
+#include "runtime/utilities/read_write_lock.h"
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace OCLRT {
 class Device;
 class GraphicsAllocation;
 class CommandStreamReceiver;
+class HeapAllocator;
 class MemoryManager;
 
 class SVMAllocsManager {
   public:
+    class SvmAllocationPool {
+      public:
+        SvmAllocationPool(GraphicsAllocation &poolAllocation);
+        ~SvmAllocationPool();
+        void *allocate(size_t &size);
+        void free(void *ptr, size_t size);
+        bool isEmpty() const { return allocationsCount == 0; }
+        GraphicsAllocation &getGraphicsAllocation() const { return poolAllocation; }
+
+      protected:
+        GraphicsAllocation &poolAllocation;
+        std::unique_ptr<HeapAllocator> heapAllocator;
+        size_t allocationsCount = 0;
+    };
+
     class MapBasedAllocationTracker {
       public:
+        struct AllocationRange {
+            const void *basePtr;
+            size_t size;
+            GraphicsAllocation *allocation;
+            SvmAllocationPool *pool;
+        };
+
         void insert(GraphicsAllocation &);
+        void insert(const AllocationRange &);
         void remove(GraphicsAllocation &);
+        void remove(const void *basePtr);
         GraphicsAllocation *get(const void *);
+        const AllocationRange *getRange(const void *) const;
         size_t getNumAllocs() const { return allocs.size(); };
 
       protected:
-        std::map<const void *, GraphicsAllocation *> allocs;
+        std::map<const void *, AllocationRange> allocs;
     };
 
+    static const size_t svmPoolSize;
+    static const size_t svmPoolAllocationThreshold;
+
     SVMAllocsManager(MemoryManager *memoryManager);
+    ~SVMAllocsManager();
     void *createSVMAlloc(size_t size, bool coherent = false);
     GraphicsAllocation *getSVMAlloc(const void *ptr);
+    bool getSVMAllocRange(const void *ptr, MapBasedAllocationTracker::AllocationRange &range);
     void freeSVMAlloc(void *ptr);
     size_t getNumAllocs() const { return SVMAllocs.getNumAllocs(); }
+    size_t getNumPools() const { return coherentPools.size() + nonCoherentPools.size(); }
 
   protected:
+    void *createPooledSVMAlloc(size_t size, bool coherent);
+    void *allocateFromPool(SvmAllocationPool &pool, size_t size);
+    bool hasOtherEmptyPool(const std::vector<std::unique_ptr<SvmAllocationPool>> &pools, const SvmAllocationPool *pool) const;
+
     MapBasedAllocationTracker SVMAllocs;
+    std::vector<std::unique_ptr<SvmAllocationPool>> coherentPools;
+    std::vector<std::unique_ptr<SvmAllocationPool>> nonCoherentPools;
     MemoryManager *memoryManager;
-    std::mutex mtx;
+    bool poolingEnabled = false;
+    ReadWriteLock mtx;
 };
 } // namespace OCLRT
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/zeroed_allocation_pool.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+#include <cstring>
+
+namespace OCLRT {
+const size_t ZeroedAllocationPool::maxPooledSizesCount;
+const size_t ZeroedAllocationPool::maxPooledAllocationSize;
+
+ZeroedAllocationPool::ZeroedAllocationPool(MemoryManager &memoryManager) : memoryManager(memoryManager) {
+    bytesZeroedSynchronously = 0;
+    bytesZeroedAsynchronously = 0;
+    poolHits = 0;
+    poolMisses = 0;
+}
+
+ZeroedAllocationPool::~ZeroedAllocationPool() {
+    stop();
+    DEBUG_BREAK_IF(!zeroedAllocations.empty());
+    DEBUG_BREAK_IF(!refillRequests.empty());
+}
+
+void ZeroedAllocationPool::setAllocationsPerSize(size_t allocationsPerSize) {
+    std::lock_guard<std::mutex> lock(mtx);
+    this->allocationsPerSize = allocationsPerSize;
+}
+
+GraphicsAllocation *ZeroedAllocationPool::obtainZeroedAllocation(size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto pooled = zeroedAllocations.find(size);
+        bool canBePooled = allocationsPerSize > 0 && size <= maxPooledAllocationSize &&
+                           (pooled != zeroedAllocations.end() || zeroedAllocations.size() < maxPooledSizesCount);
+        if (canBePooled) {
+            if (pooled == zeroedAllocations.end()) {
+                pooled = zeroedAllocations.insert(std::make_pair(size, std::vector<GraphicsAllocation *>())).first;
+            }
+            GraphicsAllocation *allocation = nullptr;
+            if (!pooled->second.empty()) {
+                allocation = pooled->second.back();
+                pooled->second.pop_back();
+            }
+            requestRefillLocked(size);
+            if (allocation) {
+                poolHits++;
+                return allocation;
+            }
+            poolMisses++;
+        }
+    }
+
+    auto allocation = memoryManager.allocateGraphicsMemory(size);
+    if (allocation) {
+        memset(allocation->getUnderlyingBuffer(), 0, allocation->getUnderlyingBufferSize());
+        bytesZeroedSynchronously += allocation->getUnderlyingBufferSize();
+    }
+    return allocation;
+}
+
+void ZeroedAllocationPool::requestRefillLocked(size_t size) {
+    auto &pending = pendingAllocationsCount[size];
+    auto available = zeroedAllocations[size].size() + pending;
+    if (available >= allocationsPerSize) {
+        return;
+    }
+    // allocations are created and zeroed by the worker, the caller only records the request
+    auto missing = allocationsPerSize - available;
+    refillRequests.push_back(std::make_pair(size, missing));
+    pending += missing;
+    ensureThread();
+    workAvailable.notify_one();
+}
+
+void ZeroedAllocationPool::zero(GraphicsAllocation &allocation) {
+    memset(allocation.getUnderlyingBuffer(), 0, allocation.getUnderlyingBufferSize());
+    bytesZeroedAsynchronously += allocation.getUnderlyingBufferSize();
+}
+
+void ZeroedAllocationPool::ensureThread() {
+    if (!worker) {
+        stopWorker = false;
+        worker.reset(new std::thread(run, this));
+    }
+}
+
+void ZeroedAllocationPool::run(ZeroedAllocationPool *self) {
+    std::unique_lock<std::mutex> lock(self->mtx);
+    while (true) {
+        self->workAvailable.wait(lock, [self] { return self->stopWorker || !self->refillRequests.empty(); });
+        if (self->stopWorker) {
+            return;
+        }
+        std::vector<std::pair<size_t, size_t>> requests;
+        requests.swap(self->refillRequests);
+
+        lock.unlock();
+        std::vector<std::pair<size_t, GraphicsAllocation *>> zeroedBatch;
+        for (auto &request : requests) {
+            for (size_t i = 0; i < request.second; i++) {
+                auto allocation = self->memoryManager.allocateGraphicsMemory(request.first);
+                if (!allocation) {
+                    break;
+                }
+                self->zero(*allocation);
+                zeroedBatch.push_back(std::make_pair(request.first, allocation));
+            }
+        }
+        lock.lock();
+
+        for (auto &allocation : zeroedBatch) {
+            self->zeroedAllocations[allocation.first].push_back(allocation.second);
+        }
+        for (auto &request : requests) {
+            self->pendingAllocationsCount[request.first] -= request.second;
+        }
+        self->workDone.notify_all();
+    }
+}
+
+void ZeroedAllocationPool::drain() {
+    std::unique_lock<std::mutex> lock(mtx);
+    workDone.wait(lock, [this] {
+        for (auto &pending : pendingAllocationsCount) {
+            if (pending.second != 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void ZeroedAllocationPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopWorker = true;
+        // requests not taken by the worker yet are dropped
+        for (auto &request : refillRequests) {
+            pendingAllocationsCount[request.first] -= request.second;
+        }
+        refillRequests.clear();
+    }
+    workAvailable.notify_one();
+    if (worker) {
+        worker->join();
+        worker.reset();
+    }
+}
+
+void ZeroedAllocationPool::cleanUpResources() {
+    stop();
+    std::vector<GraphicsAllocation *> allocationsToFree;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto &pooled : zeroedAllocations) {
+            allocationsToFree.insert(allocationsToFree.end(), pooled.second.begin(), pooled.second.end());
+        }
+        zeroedAllocations.clear();
+        pendingAllocationsCount.clear();
+    }
+    for (auto allocation : allocationsToFree) {
+        memoryManager.freeGraphicsMemory(allocation);
+    }
+}
+
+size_t ZeroedAllocationPool::peekPooledAllocationsCount(size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto pooled = zeroedAllocations.find(size);
+    return pooled != zeroedAllocations.end() ? pooled->second.size() : 0u;
+}
+
+ZeroedAllocationPoolStats ZeroedAllocationPool::getStats() const {
+    ZeroedAllocationPoolStats stats;
+    stats.bytesZeroedSynchronously = bytesZeroedSynchronously;
+    stats.bytesZeroedAsynchronously = bytesZeroedAsynchronously;
+    stats.poolHits = poolHits;
+    stats.poolMisses = poolMisses;
+    return stats;
+}
+} // namespace OCLRT
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/memory_constants.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+struct ZeroedAllocationPoolStats {
+    uint64_t bytesZeroedSynchronously = 0;
+    uint64_t bytesZeroedAsynchronously = 0;
+    uint64_t poolHits = 0;
+    uint64_t poolMisses = 0;
+};
+
+// Serves allocations which have to be zero initialized. Allocations of each requested size are
+// created and zeroed ahead of time by a background worker, so neither happens on the calling thread.
+// Only a bounded number of sizes up to maxPooledAllocationSize are pooled, other sizes are zeroed synchronously.
+class ZeroedAllocationPool {
+  public:
+    ZeroedAllocationPool(MemoryManager &memoryManager);
+    ~ZeroedAllocationPool();
+
+    ZeroedAllocationPool(const ZeroedAllocationPool &) = delete;
+    ZeroedAllocationPool &operator=(const ZeroedAllocationPool &) = delete;
+
+    GraphicsAllocation *obtainZeroedAllocation(size_t size);
+
+    void setAllocationsPerSize(size_t allocationsPerSize);
+    size_t getAllocationsPerSize() const { return allocationsPerSize; }
+
+    void drain();
+    void cleanUpResources();
+
+    size_t peekPooledAllocationsCount(size_t size);
+    ZeroedAllocationPoolStats getStats() const;
+
+    static const size_t maxPooledSizesCount = 8;
+    static const size_t maxPooledAllocationSize = 16 * MemoryConstants::megaByte;
+
+  protected:
+    void requestRefillLocked(size_t size);
+    void zero(GraphicsAllocation &allocation);
+    void ensureThread();
+    void stop();
+    static void run(ZeroedAllocationPool *self);
+
+    MemoryManager &memoryManager;
+    size_t allocationsPerSize = 0;
+
+    std::map<size_t, std::vector<GraphicsAllocation *>> zeroedAllocations;
+    std::map<size_t, size_t> pendingAllocationsCount;
+    std::vector<std::pair<size_t, size_t>> refillRequests;
+
+    std::unique_ptr<std::thread> worker;
+    bool stopWorker = false;
+    std::mutex mtx;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+
+    std::atomic<uint64_t> bytesZeroedSynchronously;
+    std::atomic<uint64_t> bytesZeroedAsynchronously;
+    std::atomic<uint64_t> poolHits;
+    std::atomic<uint64_t> poolMisses;
+};
+} // namespace OCLRT
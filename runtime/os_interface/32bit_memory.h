@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -41,6 +41,7 @@ class Allocator32bit {
     void *allocate(size_t &size);
     uintptr_t getBase();
     int free(void *ptr, size_t size);
+    bool getStatistics(HeapStatistics &stats);
 
   protected:
     std::unique_ptr<OsInternals> osInternals;
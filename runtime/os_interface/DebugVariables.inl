@@ -54,6 +54,27 @@ DECLARE_DEBUG_VARIABLE(bool, DisableStatelessToStatefulOptimization, false, "Dis
 DECLARE_DEBUG_VARIABLE(bool, DisableConcurrentBlockExecution, 0, "disables concurrent block kernel execution")
 DECLARE_DEBUG_VARIABLE(bool, UseNewHeapAllocator, true, "Custom 4GB heap allocator is used")
 DECLARE_DEBUG_VARIABLE(bool, UseNoRingFlushesKmdMode, true, "Windows only, passes flag to KMD that informs KMD to not emit any ring buffer flushes.")
+DECLARE_DEBUG_VARIABLE(bool, EnableSvmAllocationPool, false, "Serves small clSVMAlloc requests from shared, pooled SVM allocations instead of creating a separate allocation for each")
+DECLARE_DEBUG_VARIABLE(int32_t, ResidencyBudgetInMegabytes, 0, "0: no residency budget, >0: budget in MB above which least recently used allocations are evicted after submission, WDDM only")
+DECLARE_DEBUG_VARIABLE(int32_t, EnableHugePageAllocations, 0, "Linux only, 0: disabled, 1: back large allocations with transparent huge pages, 2: use hugetlbfs pages first, fall back to transparent huge pages")
+DECLARE_DEBUG_VARIABLE(int32_t, HugePageAllocationThresholdInMegabytes, 32, "Minimum allocation size in MB served from 2MB aligned huge page backed memory when EnableHugePageAllocations is set")
+DECLARE_DEBUG_VARIABLE(int32_t, OverrideNumaNode, -1, "Linux only, -1: place driver owned host memory on the NUMA node local to the device, -2: disable NUMA aware placement, >=0: place it on given node")
+DECLARE_DEBUG_VARIABLE(int32_t, ProfilingTagPoolsToPreallocate, 0, "0: tag pools are allocated on demand, >0: number of timestamp (and perf counter) tag pools allocated when a profiling queue is created")
+DECLARE_DEBUG_VARIABLE(std::string, MemoryUsageDumpFile, std::string("unk"), "unk: disabled, otherwise file to which memory usage per allocation type is appended at exit and on MemoryUsageDumpSignal")
+DECLARE_DEBUG_VARIABLE(int32_t, MemoryUsageDumpSignal, 0, "0: disabled, >0: signal number which requests a dump of memory usage to MemoryUsageDumpFile")
+DECLARE_DEBUG_VARIABLE(int32_t, WarmUpContextResources, -1, "-1: use CL_CONTEXT_WARM_UP_RESOURCES_INTEL context property, 0: disabled, 1: preallocate heaps, command buffers and timestamp tags at context creation, 2: additionally build copy and fill builtin kernels")
+DECLARE_DEBUG_VARIABLE(bool, EnablePaddedAllocationReuse, false, "Caches padded allocations of images created from buffers on the source allocation and reuses them until the source is freed")
+DECLARE_DEBUG_VARIABLE(int32_t, ZeroedAllocationPoolSize, 0, "0: internal allocations which need zeroed memory are zeroed on the calling thread, >0: number of allocations of each requested size kept pre-zeroed by a background thread, up to 8 sizes of at most 16MB")
+DECLARE_DEBUG_VARIABLE(int32_t, GpuVaManagerRangeInGigabytes, 0, "Linux only, 0: each non-userptr BO reserves its soft-pin address with a separate mmap, >0: size in GB of a single range reserved up front from which soft-pin addresses are assigned")
+DECLARE_DEBUG_VARIABLE(int32_t, CpuMappingCacheSizeInMegabytes, 0, "Linux only, 0: CPU mappings created by lockResource are unmapped on unlock, >0: budget in MB of mappings kept alive after unlock and reused by the next lock, least recently used are unmapped first")
+DECLARE_DEBUG_VARIABLE(int32_t, BinaryCacheMemoryTierSizeInMegabytes, 0, "0: binaries are always read from the on-disk cache, >0: size in MB of a process wide in-memory LRU of cached binaries checked before the on-disk cache")
+DECLARE_DEBUG_VARIABLE(int32_t, BinaryCacheMaxSizeInMegabytes, 0, "0: the on-disk binary cache is not size limited, >0: size limit in MB of the on-disk binary cache, least recently used binaries are removed when it is exceeded")
+DECLARE_DEBUG_VARIABLE(bool, EnableMappedBinaryCacheLoad, true, "Binaries loaded from the on-disk binary cache are used in place from a private file mapping instead of being read and copied into the program")
+DECLARE_DEBUG_VARIABLE(bool, EnableLazyKernelInfoParsing, false, "Patch tokens of a kernel are parsed when the kernel is first requested from its program instead of when the program is built")
+DECLARE_DEBUG_VARIABLE(int32_t, CompilerConcurrencyLimit, 0, "0: one program translation per hardware thread, -1: unlimited, >0: maximum number of program translations running in parallel")
+DECLARE_DEBUG_VARIABLE(bool, EnableAsyncProgramBuild, false, "clBuildProgram called with a notify callback queues the build on runtime worker threads and returns immediately")
+DECLARE_DEBUG_VARIABLE(int32_t, AsyncProgramBuildThreads, 0, "0: one worker per hardware thread, >0: maximum number of worker threads running asynchronous program builds")
+DECLARE_DEBUG_VARIABLE(bool, EnableBinaryCacheOptionsCanonicalization, true, "Build options are canonicalized (order independent flags sorted, -D definitions normalized) before deriving binary cache keys, options passed to the compiler are unchanged")
 /*SIMULATION FLAGS*/
 DECLARE_DEBUG_VARIABLE(int32_t, SetCommandStreamReceiver, 0, "Set command stream receiver")
 DECLARE_DEBUG_VARIABLE(std::string, TbxServer, std::string("127.0.0.1"), "TCP-IP address of TBX server")
@@ -70,6 +91,7 @@ DECLARE_DEBUG_VARIABLE(bool, EnableIntelVme, true, "Enables cl_intel_motion_esti
 DECLARE_DEBUG_VARIABLE(bool, EnableIntelAdvancedVme, true, "Enables cl_intel_advanced_motion_estimation extension")
 DECLARE_DEBUG_VARIABLE(bool, EnableStatelessToStatefulBufferOffsetOpt, false, "Temporary debug variable to help in enabling buffer-offset improvement of the stateless to stateful optimization")
 DECLARE_DEBUG_VARIABLE(bool, EnableDeferredDeleter, true, "Enables async deleter")
+DECLARE_DEBUG_VARIABLE(int32_t, DeferredDeleterWorkersCount, 1, "Number of async deleter worker threads, clamped to 1..8")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncDestroyAllocations, true, "Enables async destroying graphics allocations in mem obj destructor")
 DECLARE_DEBUG_VARIABLE(bool, EnableAsyncEventsHandler, true, "Enables async events handler")
 DECLARE_DEBUG_VARIABLE(bool, EnableForcePin, true, "Enables early pinning for memory object")
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,6 +25,7 @@
 
 namespace OCLRT {
 class BufferObject;
+class DrmGemCloseWorker;
 
 struct OsHandle {
     BufferObject *bo = nullptr;
@@ -47,6 +48,8 @@ class DrmAllocation : public GraphicsAllocation {
     }
 
   protected:
+    friend DrmGemCloseWorker;
     BufferObject *bo;
+    DrmAllocation *nextToClose = nullptr;
 };
 }
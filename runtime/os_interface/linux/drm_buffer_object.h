@@ -44,6 +44,8 @@ enum StorageAllocatorType {
     BIT32_ALLOCATOR_INTERNAL,
     MALLOC_ALLOCATOR,
     EXTERNAL_ALLOCATOR,
+    HUGE_PAGE_ALLOCATOR,
+    GPU_VA_ALLOCATOR,
     UNKNOWN_ALLOCATOR
 };
 
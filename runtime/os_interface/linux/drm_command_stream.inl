@@ -83,8 +83,10 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
             batchBuffer.stream->replaceBuffer(nullptr, 0);
             batchBuffer.stream->replaceGraphicsAllocation(nullptr);
 
-            // Push for asynchronous cleanup
+            // Push for asynchronous cleanup, submissions wait when the worker falls behind
+            // instead of piling up command buffers and the residency they hold
             getMemoryManager()->push(alloc);
+            getMemoryManager()->throttleOnCloseWorkerBackPressure();
         } else {
             bb->getResidency()->clear();
         }
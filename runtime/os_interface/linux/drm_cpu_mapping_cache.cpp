@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_cpu_mapping_cache.h"
+
+namespace OCLRT {
+
+DrmCpuMappingCache::DrmCpuMappingCache(size_t budget, const MunmapFunction &munmapFunction) : budget(budget), munmapFunction(munmapFunction) {
+}
+
+DrmCpuMappingCache::~DrmCpuMappingCache() {
+    evictAll();
+}
+
+bool DrmCpuMappingCache::acquire(BufferObject *bo, Mapping &mapping) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = entries.find(bo);
+    if (it == entries.end()) {
+        return false;
+    }
+    mapping = it->second->mapping;
+    stats.cachedBytes -= mapping.size;
+    stats.mmapCallsAvoided++;
+    lruList.erase(it->second);
+    entries.erase(it);
+    return true;
+}
+
+void DrmCpuMappingCache::markLocked(BufferObject *bo, const Mapping &mapping) {
+    std::lock_guard<std::mutex> lock(mtx);
+    lockedMappings[bo] = mapping;
+}
+
+bool DrmCpuMappingCache::release(BufferObject *bo, uint32_t taskCount) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto locked = lockedMappings.find(bo);
+    if (locked == lockedMappings.end()) {
+        return false;
+    }
+    auto mapping = locked->second;
+    mapping.domainTaskCount = taskCount;
+    lockedMappings.erase(locked);
+
+    if (mapping.size > budget) {
+        munmapFunction(mapping.cpuAddress, mapping.size);
+        stats.mappingsEvicted++;
+        return true;
+    }
+    while (!lruList.empty() && stats.cachedBytes + mapping.size > budget) {
+        evictLocked(std::prev(lruList.end()));
+    }
+    lruList.push_front({bo, mapping});
+    entries[bo] = lruList.begin();
+    stats.cachedBytes += mapping.size;
+    return true;
+}
+
+void DrmCpuMappingCache::evict(BufferObject *bo) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto locked = lockedMappings.find(bo);
+    if (locked != lockedMappings.end()) {
+        munmapFunction(locked->second.cpuAddress, locked->second.size);
+        lockedMappings.erase(locked);
+    }
+    auto it = entries.find(bo);
+    if (it != entries.end()) {
+        evictLocked(it->second);
+    }
+}
+
+void DrmCpuMappingCache::evictAll() {
+    std::lock_guard<std::mutex> lock(mtx);
+    while (!lruList.empty()) {
+        evictLocked(lruList.begin());
+    }
+}
+
+void DrmCpuMappingCache::evictLocked(std::list<Entry>::iterator it) {
+    munmapFunction(it->mapping.cpuAddress, it->mapping.size);
+    stats.cachedBytes -= it->mapping.size;
+    stats.mappingsEvicted++;
+    entries.erase(it->bo);
+    lruList.erase(it);
+}
+
+void DrmCpuMappingCache::notifyMappingCreated() {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.mappingsCreated++;
+}
+
+void DrmCpuMappingCache::notifySetDomainAvoided() {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats.setDomainCallsAvoided++;
+}
+
+size_t DrmCpuMappingCache::peekCachedMappingsCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return lruList.size();
+}
+
+CpuMappingCacheStats DrmCpuMappingCache::getStats() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats;
+}
+} // namespace OCLRT
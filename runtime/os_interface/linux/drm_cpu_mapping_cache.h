@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <sys/mman.h>
+#include <unordered_map>
+
+namespace OCLRT {
+class BufferObject;
+
+struct CpuMappingCacheStats {
+    uint64_t mappingsCreated = 0;
+    uint64_t mmapCallsAvoided = 0;
+    uint64_t setDomainCallsAvoided = 0;
+    uint64_t mappingsEvicted = 0;
+    uint64_t cachedBytes = 0;
+};
+
+// Keeps CPU mappings of buffer objects alive between unlockResource and the next lockResource.
+// Mappings of unlocked BOs are kept in LRU order and unmapped once their total size exceeds the budget.
+// Locked mappings are never unmapped by the budget, they return to the LRU list on unlock.
+class DrmCpuMappingCache {
+  public:
+    using MunmapFunction = decltype(&munmap);
+
+    struct Mapping {
+        void *cpuAddress = nullptr;
+        size_t size = 0;
+        uint32_t domainTaskCount = 0;
+        bool domainSet = false;
+    };
+
+    DrmCpuMappingCache(size_t budget, const MunmapFunction &munmapFunction);
+    ~DrmCpuMappingCache();
+
+    DrmCpuMappingCache(const DrmCpuMappingCache &) = delete;
+    DrmCpuMappingCache &operator=(const DrmCpuMappingCache &) = delete;
+
+    bool acquire(BufferObject *bo, Mapping &mapping);
+    void markLocked(BufferObject *bo, const Mapping &mapping);
+    bool release(BufferObject *bo, uint32_t taskCount);
+    void evict(BufferObject *bo);
+    void evictAll();
+
+    void notifyMappingCreated();
+    void notifySetDomainAvoided();
+
+    size_t getBudget() const { return budget; }
+    size_t peekCachedMappingsCount();
+    CpuMappingCacheStats getStats();
+
+  protected:
+    struct Entry {
+        BufferObject *bo;
+        Mapping mapping;
+    };
+    void evictLocked(std::list<Entry>::iterator it);
+
+    size_t budget;
+    // refers to the owner's function, so a replaced munmap is used for unmapping as well
+    const MunmapFunction &munmapFunction;
+
+    std::list<Entry> lruList;
+    std::unordered_map<BufferObject *, std::list<Entry>::iterator> entries;
+    std::unordered_map<BufferObject *, Mapping> lockedMappings;
+    std::mutex mtx;
+    CpuMappingCacheStats stats;
+};
+} // namespace OCLRT
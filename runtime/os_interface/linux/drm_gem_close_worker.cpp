@@ -20,9 +20,9 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
-#include <queue>
 #include <stdio.h>
 #include "runtime/helpers/aligned_memory.h"
 #include "drm_buffer_object.h"
@@ -31,6 +31,7 @@
 #include "drm_memory_manager.h"
 
 namespace OCLRT {
+const uint32_t DrmGemCloseWorker::backPressureThreshold;
 
 DrmGemCloseWorker::DrmGemCloseWorker(DrmMemoryManager &memoryManager) : active(true), thread(nullptr), workCount(0), memoryManager(memoryManager),
                                                                         workerDone(false) {
@@ -55,11 +56,16 @@ DrmGemCloseWorker::~DrmGemCloseWorker() {
 }
 
 void DrmGemCloseWorker::push(DrmAllocation *bo) {
-    std::unique_lock<std::mutex> lock(closeWorkerMutex);
-    workCount++;
-    queue.push(bo);
-    lock.unlock();
-    condition.notify_one();
+    auto pending = ++workCount;
+    if (pending == backPressureThreshold) {
+        backPressureEvents++;
+    }
+    // Producers only take the mutex when the worker may be waiting on an empty queue,
+    // a busy worker picks the allocation up with its next batch.
+    if (queue.push(*bo)) {
+        std::lock_guard<std::mutex> lock(closeWorkerMutex);
+        condition.notify_one();
+    }
 }
 
 void DrmGemCloseWorker::close(bool blocking) {
@@ -74,50 +80,53 @@ bool DrmGemCloseWorker::isEmpty() {
     return workCount.load() == 0;
 }
 
-inline void DrmGemCloseWorker::close(DrmAllocation *alloc) {
-    auto bo = alloc->getBO();
+void DrmGemCloseWorker::closeBatch(DrmAllocation *batch) {
+    uint32_t batchSize = 0;
+    while (batch != nullptr) {
+        auto alloc = batch;
+        batch = batch->nextToClose;
+
+        auto bo = alloc->getBO();
+        bo->wait(-1);
+        // Objects referenced by consecutive command buffers are released once per batch
+        auto residency = bo->getResidency();
+        pendingUnreferences.insert(pendingUnreferences.end(), residency->begin(), residency->end());
+        residency->clear();
+        memoryManager.unreference(bo);
+
+        delete alloc;
+        batchSize++;
+    }
 
-    bo->wait(-1);
-    memoryManager.unreference(bo);
-    workCount--;
+    std::sort(pendingUnreferences.begin(), pendingUnreferences.end());
+    for (auto it = pendingUnreferences.begin(); it != pendingUnreferences.end();) {
+        auto rangeEnd = std::upper_bound(it, pendingUnreferences.end(), *it);
+        memoryManager.releaseReferences(*it, static_cast<uint32_t>(rangeEnd - it));
+        it = rangeEnd;
+    }
+    pendingUnreferences.clear();
 
-    delete alloc;
+    if (batchSize > 0) {
+        batchesCount++;
+        workCount -= batchSize;
+    }
 }
 
 void DrmGemCloseWorker::worker() {
-    DrmAllocation *workItem = nullptr;
-    std::queue<DrmAllocation *> localQueue;
     std::unique_lock<std::mutex> lock(closeWorkerMutex);
     lock.unlock();
 
     while (active) {
         lock.lock();
-        workItem = nullptr;
-
-        while (queue.empty() && active) {
+        while (queue.peekIsEmpty() && active) {
             condition.wait(lock);
         }
-
-        if (!queue.empty()) {
-            localQueue.swap(queue);
-        }
-
         lock.unlock();
-        while (!localQueue.empty()) {
-            workItem = localQueue.front();
-            localQueue.pop();
-            close(workItem);
-        }
-    }
 
-    lock.lock();
-    while (!queue.empty()) {
-        workItem = queue.front();
-        queue.pop();
-        close(workItem);
+        closeBatch(queue.popAll());
     }
 
-    lock.unlock();
+    closeBatch(queue.popAll());
     workerDone.store(true);
 }
 }
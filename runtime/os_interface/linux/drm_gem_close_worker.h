@@ -21,18 +21,19 @@
  */
 
 #pragma once
+#include "runtime/os_interface/linux/drm_allocation.h"
+#include "runtime/utilities/intrusive_mpsc_queue.h"
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 #include <map>
 #include <set>
-#include <queue>
+#include <vector>
 #include <cstdint>
 
 namespace OCLRT {
 class DrmMemoryManager;
-class DrmAllocation;
 
 enum gemCloseWorkerMode {
     gemCloseWorkerConsumingCommandBuffers,
@@ -52,17 +53,31 @@ class DrmGemCloseWorker {
     void close(bool blocking);
 
     bool isEmpty();
+    bool isBackPressured() const {
+        return workCount.load() >= backPressureThreshold;
+    }
+    uint64_t getBackPressureEventsCount() const {
+        return backPressureEvents;
+    }
+    uint64_t getBatchesCount() const {
+        return batchesCount;
+    }
+
+    static const uint32_t backPressureThreshold = 4096;
 
   private:
-    void close(DrmAllocation *workItem);
+    void closeBatch(DrmAllocation *batch);
     void closeThread();
     void worker();
     bool active;
 
     std::thread *thread;
 
-    std::queue<DrmAllocation *> queue;
+    IntrusiveMpscQueue<DrmAllocation, &DrmAllocation::nextToClose> queue;
     std::atomic<uint32_t> workCount;
+    std::atomic<uint64_t> backPressureEvents{0};
+    std::atomic<uint64_t> batchesCount{0};
+    std::vector<BufferObject *> pendingUnreferences;
 
     DrmMemoryManager &memoryManager;
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_gpu_va_manager.h"
+
+namespace OCLRT {
+
+DrmGpuVaManager::DrmGpuVaManager(uint64_t rangeSize, MmapFunction mmapFunction, MunmapFunction munmapFunction) : munmapFunction(munmapFunction) {
+    auto ptr = mmapFunction(nullptr, static_cast<size_t>(rangeSize), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED || ptr == nullptr) {
+        return;
+    }
+    this->rangeBase = ptr;
+    this->rangeSize = rangeSize;
+    heapAllocator.reset(new HeapAllocator(ptr, rangeSize));
+}
+
+DrmGpuVaManager::~DrmGpuVaManager() {
+    if (rangeBase) {
+        munmapFunction(rangeBase, static_cast<size_t>(rangeSize));
+    }
+}
+
+void *DrmGpuVaManager::reserve(size_t &size) {
+    if (!heapAllocator) {
+        return nullptr;
+    }
+    return heapAllocator->allocate(size);
+}
+
+void DrmGpuVaManager::release(void *gpuAddress, size_t size) {
+    DEBUG_BREAK_IF(!isInRange(gpuAddress));
+    heapAllocator->free(gpuAddress, size);
+}
+
+bool DrmGpuVaManager::isInRange(const void *gpuAddress) const {
+    auto address = reinterpret_cast<uint64_t>(gpuAddress);
+    return rangeBase && address >= getBase() && address < getBase() + rangeSize;
+}
+
+bool DrmGpuVaManager::getStatistics(HeapStatistics &stats) {
+    if (!heapAllocator) {
+        return false;
+    }
+    heapAllocator->getStatistics(stats);
+    return true;
+}
+} // namespace OCLRT
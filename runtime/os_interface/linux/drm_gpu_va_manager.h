@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/heap_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sys/mman.h>
+
+namespace OCLRT {
+
+// Runtime owned GPU virtual address space for BOs which are not identity mapped userptrs.
+// One range is reserved in the process address space up front, so soft-pin addresses assigned
+// from it can never collide with userptr BOs, and each BO gets its stable address without an mmap call.
+class DrmGpuVaManager {
+  public:
+    using MmapFunction = decltype(&mmap);
+    using MunmapFunction = decltype(&munmap);
+
+    DrmGpuVaManager(uint64_t rangeSize, MmapFunction mmapFunction, MunmapFunction munmapFunction);
+    ~DrmGpuVaManager();
+
+    DrmGpuVaManager(const DrmGpuVaManager &) = delete;
+    DrmGpuVaManager &operator=(const DrmGpuVaManager &) = delete;
+
+    bool isInitialized() const { return heapAllocator != nullptr; }
+    void *reserve(size_t &size);
+    void release(void *gpuAddress, size_t size);
+    bool isInRange(const void *gpuAddress) const;
+
+    uint64_t getBase() const { return reinterpret_cast<uint64_t>(rangeBase); }
+    uint64_t getRangeSize() const { return rangeSize; }
+    bool getStatistics(HeapStatistics &stats);
+
+  protected:
+    MunmapFunction munmapFunction;
+    void *rangeBase = nullptr;
+    uint64_t rangeSize = 0;
+    std::unique_ptr<HeapAllocator> heapAllocator;
+};
+} // namespace OCLRT
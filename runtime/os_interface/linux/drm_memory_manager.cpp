@@ -23,13 +23,19 @@
 #include "runtime/device/device.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/options.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/32bit_memory.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
+#include "runtime/os_interface/linux/drm_cpu_mapping_cache.h"
+#include "runtime/os_interface/linux/drm_gpu_va_manager.h"
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/helpers/surface_formats.h"
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 #include "drm/i915_drm.h"
 #include "drm/drm.h"
@@ -45,6 +51,16 @@ DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool force
                                                                                                                           forcePinEnabled(forcePinAllowed),
                                                                                                                           validateHostPtrMemory(validateHostPtrMemory) {
     MemoryManager::virtualPaddingAvailable = true;
+
+    auto numaNode = DebugManager.flags.OverrideNumaNode.get();
+    if (numaNode == -1) {
+        numaNode = drm->getNumaNode();
+    }
+    numaPolicy.setPreferredNode(numaNode);
+    if (numaPolicy.isEnabled()) {
+        printDebugString(DebugManager.flags.PrintDebugMessages.get(), stdout, "NUMA: driver owned host memory is placed on node %d\n", numaPolicy.getPreferredNode());
+    }
+
     if (mode != gemCloseWorkerMode::gemCloseWorkerInactive) {
         gemCloseWorker.reset(new DrmGemCloseWorker(*this));
     }
@@ -64,10 +80,24 @@ DrmMemoryManager::DrmMemoryManager(Drm *drm, gemCloseWorkerMode mode, bool force
         pinBB->isAllocated = true;
     }
     internal32bitAllocator.reset(new Allocator32bit);
+
+    if (DebugManager.flags.GpuVaManagerRangeInGigabytes.get() > 0) {
+        gpuVaManager.reset(new DrmGpuVaManager(DebugManager.flags.GpuVaManagerRangeInGigabytes.get() * MemoryConstants::gigaByte, mmapFunction, munmapFunction));
+        if (!gpuVaManager->isInitialized()) {
+            gpuVaManager.reset();
+        }
+    }
+
+    if (DebugManager.flags.CpuMappingCacheSizeInMegabytes.get() > 0) {
+        cpuMappingCache.reset(new DrmCpuMappingCache(static_cast<size_t>(DebugManager.flags.CpuMappingCacheSizeInMegabytes.get() * MemoryConstants::megaByte), munmapFunction));
+    }
 }
 
 DrmMemoryManager::~DrmMemoryManager() {
     applyCommonCleanup();
+    if (cpuMappingCache) {
+        cpuMappingCache->evictAll();
+    }
     if (gemCloseWorker) {
         gemCloseWorker->close(false);
     }
@@ -81,6 +111,17 @@ void DrmMemoryManager::push(DrmAllocation *alloc) {
     gemCloseWorker->push(alloc);
 }
 
+bool DrmMemoryManager::throttleOnCloseWorkerBackPressure() {
+    if (!gemCloseWorker || !gemCloseWorker->isBackPressured()) {
+        return false;
+    }
+    // the worker pops everything pending at once, so one finished batch takes it well below the threshold
+    while (gemCloseWorker->isBackPressured()) {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
 void DrmMemoryManager::eraseSharedBufferObject(OCLRT::BufferObject *bo) {
     std::lock_guard<decltype(mtx)> lock(mtx);
 
@@ -106,9 +147,14 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
             ;
     }
 
-    uint32_t r = bo->refCount.fetch_sub(1);
+    return releaseReferences(bo, 1);
+}
+
+uint32_t DrmMemoryManager::releaseReferences(OCLRT::BufferObject *bo, uint32_t count) {
+    uint32_t r = bo->refCount.fetch_sub(count);
+    DEBUG_BREAK_IF(r < count);
 
-    if (r == 1) {
+    if (r == count) {
         for (auto it : *bo->getResidency()) {
             unreference(it);
         }
@@ -120,13 +166,28 @@ uint32_t DrmMemoryManager::unreference(OCLRT::BufferObject *bo, bool synchronous
             eraseSharedBufferObject(bo);
         }
 
+        if (cpuMappingCache) {
+            cpuMappingCache->evict(bo);
+        }
+
         bo->close();
 
         delete bo;
+        bufferObjectsCount--;
         if (address) {
             if (unmapSize) {
                 if (allocatorType == MMAP_ALLOCATOR) {
                     munmapFunction(address, unmapSize);
+                } else if (allocatorType == GPU_VA_ALLOCATOR) {
+                    gpuVaManager->release(address, static_cast<size_t>(unmapSize));
+                } else if (allocatorType == HUGE_PAGE_ALLOCATOR) {
+                    {
+                        std::lock_guard<std::mutex> lock(hugePageRangesMtx);
+                        transparentHugePageRanges.erase(reinterpret_cast<uintptr_t>(address));
+                        hugetlbRanges.erase(reinterpret_cast<uintptr_t>(address));
+                    }
+                    munmapFunction(address, unmapSize);
+                    hugePageAdvisedBytes -= unmapSize;
                 } else {
                     if (allocatorType == BIT32_ALLOCATOR_EXTERNAL) {
                         allocator32Bit->free(address, unmapSize);
@@ -159,6 +220,7 @@ OCLRT::BufferObject *DrmMemoryManager::allocUserptr(uintptr_t address, size_t si
         DEBUG_BREAK_IF(true);
         return nullptr;
     }
+    bufferObjectsCount++;
     res->size = size;
     res->address = reinterpret_cast<void *>(address);
     res->softPin(address);
@@ -179,6 +241,21 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     // It's needed to prevent overlapping pages with user pointers
     size_t cSize = std::max(alignUp(size, minAlignment), minAlignment);
 
+    if (isHugePageAllocationPreferred(cSize, cAlignment)) {
+        auto allocation = allocateGraphicsMemoryWithHugePages(cSize, forcePin);
+        if (allocation) {
+            return allocation;
+        }
+    }
+
+    if (numaPolicy.isEnabled()) {
+        // command buffers, heaps and pools can only be placed when their pages are not shared with the malloc heap
+        auto allocation = allocateGraphicsMemoryWithPlacement(cSize, cAlignment, forcePin);
+        if (allocation) {
+            return allocation;
+        }
+    }
+
     auto res = alignedMallocWrapper(cSize, cAlignment);
 
     if (!res)
@@ -199,6 +276,162 @@ DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, size_t alig
     return new DrmAllocation(bo, res, cSize);
 }
 
+bool DrmMemoryManager::isHugePageAllocationPreferred(size_t size, size_t alignment) const {
+    if (DebugManager.flags.EnableHugePageAllocations.get() == 0 || alignment > MemoryConstants::pageSize2Mb) {
+        return false;
+    }
+    auto threshold = static_cast<size_t>(DebugManager.flags.HugePageAllocationThresholdInMegabytes.get() * MemoryConstants::megaByte);
+    return size >= std::max(threshold, MemoryConstants::pageSize2Mb);
+}
+
+DrmAllocation *DrmMemoryManager::allocateGraphicsMemoryWithHugePages(size_t size, bool forcePin) {
+    size_t alignedSize = alignUp(size, MemoryConstants::pageSize2Mb);
+    void *ptr = nullptr;
+    bool hugePageRequested = false;
+    bool hugetlbMapped = false;
+
+    if (DebugManager.flags.EnableHugePageAllocations.get() == 2) {
+        // hugetlbfs mappings are 2MB aligned by the kernel, but fail when no huge pages are reserved
+        auto res = mmapFunction(nullptr, alignedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (res != MAP_FAILED) {
+            ptr = res;
+            hugePageRequested = true;
+            hugetlbMapped = true;
+        }
+    }
+
+    if (!ptr) {
+        ptr = mapAlignedHostRange(alignedSize, MemoryConstants::pageSize2Mb);
+        if (!ptr) {
+            return nullptr;
+        }
+        hugePageRequested = madviseFunction(ptr, alignedSize, MADV_HUGEPAGE) == 0;
+    }
+    applyHostMemoryPlacement(ptr, alignedSize);
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(ptr), alignedSize, 0, true);
+    if (!bo) {
+        munmapFunction(ptr, alignedSize);
+        return nullptr;
+    }
+
+    bo->isAllocated = true;
+    bo->setUnmapSize(alignedSize);
+    if (hugePageRequested) {
+        bo->setAllocationType(HUGE_PAGE_ALLOCATOR);
+        hugePageAdvisedBytes += alignedSize;
+        std::lock_guard<std::mutex> lock(hugePageRangesMtx);
+        auto &ranges = hugetlbMapped ? hugetlbRanges : transparentHugePageRanges;
+        ranges[reinterpret_cast<uintptr_t>(ptr)] = alignedSize;
+    } else {
+        bo->setAllocationType(MMAP_ALLOCATOR);
+    }
+
+    if (forcePinEnabled && pinBB != nullptr && forcePin && size >= this->pinThreshold) {
+        pinBB->pin(&bo, 1);
+    }
+
+    return new DrmAllocation(bo, ptr, size);
+}
+
+uint64_t DrmMemoryManager::getHugePageBackedBytes() {
+    uint64_t backedBytes = 0;
+    std::map<uintptr_t, size_t> transparentRanges;
+    {
+        std::lock_guard<std::mutex> lock(hugePageRangesMtx);
+        // hugetlbfs mappings are backed by reserved huge pages as soon as they are created
+        for (auto &range : hugetlbRanges) {
+            backedBytes += range.second;
+        }
+        transparentRanges = transparentHugePageRanges;
+    }
+    if (transparentRanges.empty()) {
+        return backedBytes;
+    }
+    std::ifstream smaps("/proc/self/smaps");
+    return backedBytes + countTransparentHugePageBytes(smaps, transparentRanges);
+}
+
+uint64_t DrmMemoryManager::countTransparentHugePageBytes(std::istream &smaps, const std::map<uintptr_t, size_t> &ranges) {
+    // AnonHugePages is reported per mapping and adjacent advised ranges may be merged into one mapping,
+    // so a mapping contributes at most the part of it that is covered by the given ranges
+    uint64_t backedBytes = 0;
+    uint64_t coveredBytes = 0;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        fields >> name;
+        if (name.empty()) {
+            continue;
+        }
+        if (name.back() != ':') {
+            // mapping header, "start-end perms offset dev inode path"
+            uintptr_t start = 0;
+            uintptr_t end = 0;
+            char separator = 0;
+            std::istringstream bounds(name);
+            bounds >> std::hex >> start >> separator >> end;
+            coveredBytes = 0;
+            for (auto &range : ranges) {
+                auto overlapStart = std::max(start, range.first);
+                auto overlapEnd = std::min(end, range.first + range.second);
+                if (overlapStart < overlapEnd) {
+                    coveredBytes += overlapEnd - overlapStart;
+                }
+            }
+        } else if (name == "AnonHugePages:" && coveredBytes) {
+            uint64_t kiloBytes = 0;
+            fields >> kiloBytes;
+            backedBytes += std::min(kiloBytes * MemoryConstants::kiloByte, coveredBytes);
+        }
+    }
+    return backedBytes;
+}
+
+DrmAllocation *DrmMemoryManager::allocateGraphicsMemoryWithPlacement(size_t size, size_t alignment, bool forcePin) {
+    void *ptr = mapAlignedHostRange(size, alignment);
+    if (!ptr) {
+        return nullptr;
+    }
+    applyHostMemoryPlacement(ptr, size);
+
+    BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(ptr), size, 0, true);
+    if (!bo) {
+        munmapFunction(ptr, size);
+        return nullptr;
+    }
+
+    bo->isAllocated = true;
+    bo->setUnmapSize(size);
+    bo->setAllocationType(MMAP_ALLOCATOR);
+
+    if (forcePinEnabled && pinBB != nullptr && forcePin && size >= this->pinThreshold) {
+        pinBB->pin(&bo, 1);
+    }
+
+    return new DrmAllocation(bo, ptr, size);
+}
+
+void *DrmMemoryManager::mapAlignedHostRange(size_t size, size_t alignment) {
+    // mmap is page aligned, larger alignments over-reserve and give back the unaligned head and tail
+    size_t reservedSize = alignment > MemoryConstants::pageSize ? size + alignment : size;
+    auto res = mmapFunction(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (res == MAP_FAILED) {
+        return nullptr;
+    }
+    auto ptr = alignUp(res, alignment);
+    size_t headSize = ptrDiff(ptr, res);
+    size_t tailSize = reservedSize - headSize - size;
+    if (headSize) {
+        munmapFunction(res, headSize);
+    }
+    if (tailSize) {
+        munmapFunction(ptrOffset(ptr, size), tailSize);
+    }
+    return ptr;
+}
+
 DrmAllocation *DrmMemoryManager::allocateGraphicsMemory(size_t size, const void *ptr, bool forcePin) {
     auto res = (DrmAllocation *)MemoryManager::allocateGraphicsMemory(size, const_cast<void *>(ptr), forcePin);
 
@@ -223,7 +456,9 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
         return alloc;
     }
 
-    auto gpuRange = mmapFunction(nullptr, imgInfo.size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    size_t gpuRangeSize = imgInfo.size;
+    StorageAllocatorType gpuRangeType = MMAP_ALLOCATOR;
+    auto gpuRange = reserveGpuRange(gpuRangeSize, gpuRangeType);
     DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
 
     drm_i915_gem_create create = {0, 0, 0};
@@ -237,6 +472,7 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
     if (!bo) {
         return nullptr;
     }
+    bufferObjectsCount++;
     bo->size = imgInfo.size;
     bo->address = reinterpret_cast<void *>(gpuRange);
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
@@ -245,10 +481,10 @@ GraphicsAllocation *DrmMemoryManager::allocateGraphicsMemoryForImage(ImageInfo &
     DEBUG_BREAK_IF(ret2 != true);
     ((void)(ret2));
 
-    bo->setUnmapSize(imgInfo.size);
+    bo->setUnmapSize(gpuRangeSize);
 
     auto allocation = new DrmAllocation(bo, nullptr, (uint64_t)gpuRange, imgInfo.size);
-    bo->setAllocationType(MMAP_ALLOCATOR);
+    bo->setAllocationType(gpuRangeType);
     allocation->gmm = gmm;
     return allocation;
 }
@@ -300,6 +536,8 @@ DrmAllocation *DrmMemoryManager::allocate32BitGraphicsMemory(size_t size, void *
         return nullptr;
     }
 
+    applyHostMemoryPlacement(res, allocationSize);
+
     BufferObject *bo = allocUserptr(reinterpret_cast<uintptr_t>(res), alignedAllocationSize, 0, true);
 
     if (!bo) {
@@ -322,6 +560,13 @@ GraphicsAllocation *DrmMemoryManager::createInternalGraphicsAllocation(const voi
     return allocate32BitGraphicsMemory(allocationSize, const_cast<void *>(ptr), MemoryType::INTERNAL_ALLOCATION);
 }
 
+bool DrmMemoryManager::get32BitHeapStatistics(MemoryType memoryType, HeapStatistics &stats) {
+    if (memoryType == MemoryType::INTERNAL_ALLOCATION) {
+        return internal32bitAllocator->getStatistics(stats);
+    }
+    return MemoryManager::get32BitHeapStatistics(memoryType, stats);
+}
+
 BufferObject *DrmMemoryManager::findAndReferenceSharedBufferObject(int boHandle) {
     BufferObject *bo = nullptr;
 
@@ -340,13 +585,13 @@ BufferObject *DrmMemoryManager::findAndReferenceSharedBufferObject(int boHandle)
 BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t size, bool requireSpecificBitness) {
     void *gpuRange = nullptr;
     StorageAllocatorType storageType = UNKNOWN_ALLOCATOR;
+    size_t gpuRangeSize = size;
 
     if (requireSpecificBitness && this->force32bitAllocations) {
         gpuRange = this->allocator32Bit->allocate(size);
         storageType = BIT32_ALLOCATOR_EXTERNAL;
     } else {
-        gpuRange = mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
-        storageType = MMAP_ALLOCATOR;
+        gpuRange = reserveGpuRange(gpuRangeSize, storageType);
     }
 
     DEBUG_BREAK_IF(gpuRange == MAP_FAILED);
@@ -355,11 +600,12 @@ BufferObject *DrmMemoryManager::createSharedBufferObject(int boHandle, size_t si
     if (!bo) {
         return nullptr;
     }
+    bufferObjectsCount++;
 
     bo->size = size;
     bo->address = reinterpret_cast<void *>(gpuRange);
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
-    bo->setUnmapSize(size);
+    bo->setUnmapSize(gpuRangeSize);
     bo->setAllocationType(storageType);
     return bo;
 }
@@ -402,8 +648,32 @@ GraphicsAllocation *DrmMemoryManager::createGraphicsAllocationFromSharedHandle(o
     return drmAllocation;
 }
 
+void *DrmMemoryManager::reserveGpuRange(size_t &size, StorageAllocatorType &storageType) {
+    if (gpuVaManager) {
+        auto rangeSize = size;
+        auto gpuRange = gpuVaManager->reserve(rangeSize);
+        if (gpuRange) {
+            size = rangeSize;
+            storageType = GPU_VA_ALLOCATOR;
+            return gpuRange;
+        }
+    }
+    storageType = MMAP_ALLOCATOR;
+    return mmapFunction(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+}
+
+void DrmMemoryManager::releaseGpuRange(void *gpuRange, size_t size, StorageAllocatorType storageType) {
+    if (storageType == GPU_VA_ALLOCATOR) {
+        gpuVaManager->release(gpuRange, size);
+    } else {
+        munmapFunction(gpuRange, size);
+    }
+}
+
 GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding) {
-    void *gpuRange = mmapFunction(nullptr, sizeWithPadding, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    size_t gpuRangeSize = sizeWithPadding;
+    StorageAllocatorType gpuRangeType = MMAP_ALLOCATOR;
+    void *gpuRange = reserveGpuRange(gpuRangeSize, gpuRangeType);
 
     auto srcPtr = inputGraphicsAllocation->getUnderlyingBuffer();
     auto srcSize = inputGraphicsAllocation->getUnderlyingBufferSize();
@@ -413,12 +683,13 @@ GraphicsAllocation *DrmMemoryManager::createPaddedAllocation(GraphicsAllocation
 
     BufferObject *bo = allocUserptr(alignedPtr, alignedSrcSize, 0, true);
     if (!bo) {
+        releaseGpuRange(gpuRange, gpuRangeSize, gpuRangeType);
         return nullptr;
     }
     bo->setAddress(gpuRange);
     bo->softPin(reinterpret_cast<uint64_t>(gpuRange));
-    bo->setUnmapSize(sizeWithPadding);
-    bo->setAllocationType(MMAP_ALLOCATOR);
+    bo->setUnmapSize(gpuRangeSize);
+    bo->setAllocationType(gpuRangeType);
     return new DrmAllocation(bo, (void *)srcPtr, (uint64_t)ptrOffset(gpuRange, offset), sizeWithPadding);
 }
 
@@ -448,6 +719,16 @@ void DrmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation)
     unreference(search);
 }
 
+void DrmMemoryManager::getMemoryUsage(MemoryUsageSnapshot &snapshot) {
+    MemoryManager::getMemoryUsage(snapshot);
+    snapshot.osHandles = bufferObjectsCount;
+    snapshot.hugePageAdvisedBytes = hugePageAdvisedBytes;
+    snapshot.hugePageBackedBytes = getHugePageBackedBytes();
+    snapshot.numaNode = numaPolicy.getPreferredNode();
+    snapshot.numaPlacedBytes = numaPolicy.getPlacedBytes();
+    snapshot.numaFailedPlacements = numaPolicy.getFailedPlacementsCount();
+}
+
 uint64_t DrmMemoryManager::getSystemSharedMemory() {
     uint64_t hostMemorySize = MemoryConstants::pageSize * (uint64_t)(sysconf(_SC_PHYS_PAGES));
 
@@ -572,6 +853,20 @@ void *DrmMemoryManager::lockResource(GraphicsAllocation *graphicsAllocation) {
     if (bo == nullptr)
         return nullptr;
 
+    DrmCpuMappingCache::Mapping mapping;
+    if (cpuMappingCache && cpuMappingCache->acquire(bo, mapping)) {
+        bo->setLockedAddress(mapping.cpuAddress);
+        // the GPU did not use the BO since the domain was last moved to CPU, so there is nothing to wait for
+        if (mapping.domainSet && mapping.domainTaskCount == graphicsAllocation->taskCount) {
+            cpuMappingCache->notifySetDomainAvoided();
+        } else {
+            mapping.domainSet = setDomainCpu(*graphicsAllocation, false);
+            DEBUG_BREAK_IF(!mapping.domainSet);
+        }
+        cpuMappingCache->markLocked(bo, mapping);
+        return bo->peekLockedAddress();
+    }
+
     drm_i915_gem_mmap mmap_arg = {};
     mmap_arg.handle = bo->peekHandle();
     mmap_arg.size = bo->peekSize();
@@ -583,7 +878,14 @@ void *DrmMemoryManager::lockResource(GraphicsAllocation *graphicsAllocation) {
 
     auto success = setDomainCpu(*graphicsAllocation, false);
     DEBUG_BREAK_IF(!success);
-    (void)success;
+
+    if (cpuMappingCache) {
+        cpuMappingCache->notifyMappingCreated();
+        mapping.cpuAddress = bo->peekLockedAddress();
+        mapping.size = bo->peekSize();
+        mapping.domainSet = success;
+        cpuMappingCache->markLocked(bo, mapping);
+    }
 
     return bo->peekLockedAddress();
 }
@@ -601,6 +903,11 @@ void DrmMemoryManager::unlockResource(GraphicsAllocation *graphicsAllocation) {
     if (bo == nullptr)
         return;
 
+    if (cpuMappingCache && cpuMappingCache->release(bo, graphicsAllocation->taskCount)) {
+        bo->setLockedAddress(nullptr);
+        return;
+    }
+
     munmapFunction(bo->peekLockedAddress(), bo->peekSize());
 
     bo->setLockedAddress(nullptr);
@@ -25,12 +25,18 @@
 #include "runtime/memory_manager/memory_manager.h"
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_neo.h"
+#include "runtime/os_interface/linux/numa_policy.h"
+#include <atomic>
+#include <iosfwd>
 #include <map>
+#include <mutex>
 #include <sys/mman.h>
 
 namespace OCLRT {
 class BufferObject;
 class Drm;
+class DrmCpuMappingCache;
+class DrmGpuVaManager;
 
 class DrmMemoryManager : public MemoryManager {
   public:
@@ -69,23 +75,57 @@ class DrmMemoryManager : public MemoryManager {
 
     // drm/i915 ioctl wrappers
     uint32_t unreference(BufferObject *bo, bool synchronousDestroy = false);
+    // drops count references at once, destroys the object when the last one is released
+    uint32_t releaseReferences(BufferObject *bo, uint32_t count);
 
     // CloseWorker delegate
     void push(DrmAllocation *alloc);
+    // blocks while the close worker is back-pressured, returns whether the caller had to wait
+    bool throttleOnCloseWorkerBackPressure();
 
     DrmAllocation *createGraphicsAllocation(OsHandleStorage &handleStorage, size_t hostPtrSize, const void *hostPtr) override;
     void waitForDeletions() override;
     bool isValidateHostMemoryEnabled() const {
         return validateHostPtrMemory;
     }
+    // bytes mapped from hugetlbfs or advised with MADV_HUGEPAGE, transparent huge page backing is up to the kernel
+    uint64_t getHugePageAdvisedBytes() const {
+        return hugePageAdvisedBytes;
+    }
+    // bytes of the above actually backed by huge pages, transparent ones are looked up in /proc/self/smaps
+    uint64_t getHugePageBackedBytes();
+    uint64_t getBufferObjectsCount() const {
+        return bufferObjectsCount;
+    }
+    void getMemoryUsage(MemoryUsageSnapshot &snapshot) override;
+    bool get32BitHeapStatistics(MemoryType memoryType, HeapStatistics &stats) override;
+    DrmGpuVaManager *getGpuVaManager() const {
+        return gpuVaManager.get();
+    }
+    DrmCpuMappingCache *getCpuMappingCache() const {
+        return cpuMappingCache.get();
+    }
+    const NumaPolicy &getNumaPolicy() const {
+        return numaPolicy;
+    }
 
   protected:
+    void applyHostMemoryPlacement(void *ptr, size_t size) {
+        numaPolicy.applyPreferredPlacement(ptr, size);
+    }
     BufferObject *findAndReferenceSharedBufferObject(int boHandle);
     BufferObject *createSharedBufferObject(int boHandle, size_t size, bool requireSpecificBitness);
     void eraseSharedBufferObject(BufferObject *bo);
     void pushSharedBufferObject(BufferObject *bo);
     BufferObject *allocUserptr(uintptr_t address, size_t size, uint64_t flags, bool softpin);
+    bool isHugePageAllocationPreferred(size_t size, size_t alignment) const;
+    DrmAllocation *allocateGraphicsMemoryWithHugePages(size_t size, bool forcePin);
+    static uint64_t countTransparentHugePageBytes(std::istream &smaps, const std::map<uintptr_t, size_t> &ranges);
+    DrmAllocation *allocateGraphicsMemoryWithPlacement(size_t size, size_t alignment, bool forcePin);
+    void *mapAlignedHostRange(size_t size, size_t alignment);
     bool setDomainCpu(GraphicsAllocation &graphicsAllocation, bool writeEnable);
+    void *reserveGpuRange(size_t &size, StorageAllocatorType &storageType);
+    void releaseGpuRange(void *gpuRange, size_t size, StorageAllocatorType storageType);
 
     Drm *drm;
     BufferObject *pinBB;
@@ -96,9 +136,18 @@ class DrmMemoryManager : public MemoryManager {
     decltype(&lseek) lseekFunction = lseek;
     decltype(&mmap) mmapFunction = mmap;
     decltype(&munmap) munmapFunction = munmap;
+    decltype(&madvise) madviseFunction = madvise;
     decltype(&close) closeFunction = close;
     std::vector<BufferObject *> sharingBufferObjects;
     std::recursive_mutex mtx;
     std::unique_ptr<Allocator32bit> internal32bitAllocator;
+    std::unique_ptr<DrmGpuVaManager> gpuVaManager;
+    std::unique_ptr<DrmCpuMappingCache> cpuMappingCache;
+    std::atomic<uint64_t> hugePageAdvisedBytes{0};
+    std::mutex hugePageRangesMtx;
+    std::map<uintptr_t, size_t> transparentHugePageRanges;
+    std::map<uintptr_t, size_t> hugetlbRanges;
+    std::atomic<uint64_t> bufferObjectsCount{0};
+    NumaPolicy numaPolicy;
 };
 } // namespace OCLRT
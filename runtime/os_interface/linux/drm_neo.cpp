@@ -28,6 +28,8 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
 
 namespace OCLRT {
 
@@ -150,6 +152,23 @@ std::string Drm::getSysFsPciPath(int deviceID) {
     return nullPath;
 }
 
+int Drm::getNumaNode() {
+    struct stat deviceStat = {};
+    if (fstat(fd, &deviceStat) != 0 || !S_ISCHR(deviceStat.st_mode)) {
+        return -1;
+    }
+
+    std::string numaNodePath = "/sys/dev/char/" + std::to_string(major(deviceStat.st_rdev)) + ":" + std::to_string(minor(deviceStat.st_rdev)) + "/device/numa_node";
+    std::ifstream numaNodeFile(numaNodePath.c_str(), std::ifstream::in);
+    if (numaNodeFile.fail()) {
+        return -1;
+    }
+
+    int numaNode = -1;
+    numaNodeFile >> numaNode;
+    return numaNodeFile.fail() ? -1 : numaNode;
+}
+
 bool Drm::is48BitAddressRangeSupported() {
     int value = 0;
     auto ret = getParamIoctl(I915_PARAM_HAS_ALIASING_PPGTT, &value);
@@ -82,6 +82,7 @@ class Drm {
     virtual void obtainCoherencyDisablePatchActive();
     MOCKABLE_VIRTUAL void obtainDataPortCoherencyPatchActive();
     int getFileDescriptor() const { return fd; }
+    MOCKABLE_VIRTUAL int getNumaNode();
     bool contextCreate();
     void contextDestroy();
 
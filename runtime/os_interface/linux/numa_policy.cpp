@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/numa_policy.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/ptr_math.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace OCLRT {
+
+namespace {
+// from linux/mempolicy.h, not every distribution ships numaif.h
+constexpr int mpolPreferred = 1;
+constexpr unsigned int mpolMfMove = 1 << 1;
+constexpr size_t bitsPerMaskWord = sizeof(unsigned long) * 8;
+} // namespace
+
+const int NumaPolicy::noNode;
+const int NumaPolicy::maxNodes;
+
+void NumaPolicy::setPreferredNode(int node) {
+    preferredNode = (node >= 0 && node < maxNodes) ? node : noNode;
+}
+
+long NumaPolicy::mbindSyscall(void *addr, unsigned long len, int mode, const unsigned long *nodemask, unsigned long maxnode, unsigned int flags) {
+    return syscall(SYS_mbind, addr, len, mode, nodemask, maxnode, flags);
+}
+
+bool NumaPolicy::applyPreferredPlacement(void *ptr, size_t size) {
+    if (!isEnabled() || ptr == nullptr || size == 0) {
+        return false;
+    }
+
+    // mbind operates on whole pages
+    auto alignedPtr = alignDown(ptr, MemoryConstants::pageSize);
+    auto alignedSize = alignUp(size + ptrDiff(ptr, alignedPtr), MemoryConstants::pageSize);
+
+    unsigned long nodeMask[maxNodes / bitsPerMaskWord] = {};
+    nodeMask[preferredNode / bitsPerMaskWord] = 1ul << (preferredNode % bitsPerMaskWord);
+
+    // kernel expects maxnode to be one more than the number of bits in the mask,
+    // MPOL_MF_MOVE migrates pages of a reused range that were already faulted in elsewhere
+    if (mbindFunction(alignedPtr, alignedSize, mpolPreferred, nodeMask, maxNodes + 1, mpolMfMove) != 0) {
+        failedPlacements++;
+        return false;
+    }
+    placedBytes += alignedSize;
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+
+// Preferred NUMA placement for driver owned host memory.
+// Only ranges the driver maps itself may be placed, malloc'd ranges share pages with unrelated heap data.
+// Placement is best effort, failures leave default first-touch policy.
+class NumaPolicy {
+  public:
+    static const int noNode = -1;
+    static const int maxNodes = 1024;
+
+    using MbindFunction = long (*)(void *addr, unsigned long len, int mode, const unsigned long *nodemask, unsigned long maxnode, unsigned int flags);
+
+    void setPreferredNode(int node);
+    int getPreferredNode() const { return preferredNode; }
+    bool isEnabled() const { return preferredNode != noNode; }
+
+    bool applyPreferredPlacement(void *ptr, size_t size);
+
+    uint64_t getPlacedBytes() const { return placedBytes; }
+    uint32_t getFailedPlacementsCount() const { return failedPlacements; }
+
+  protected:
+    static long mbindSyscall(void *addr, unsigned long len, int mode, const unsigned long *nodemask, unsigned long maxnode, unsigned int flags);
+
+    MbindFunction mbindFunction = mbindSyscall;
+    int preferredNode = noNode;
+    std::atomic<uint64_t> placedBytes{0};
+    std::atomic<uint32_t> failedPlacements{0};
+};
+} // namespace OCLRT
@@ -46,9 +46,12 @@ DeferrableDeletionImpl::DeferrableDeletionImpl(Wddm *wddm, D3DKMT_HANDLE *handle
     this->resourceHandle = resourceHandle;
 }
 void DeferrableDeletionImpl::apply() {
-    bool destroyStatus = wddm->destroyAllocations(handles, allocationCount, lastFenceValue, resourceHandle);
+    bool destroyStatus = wddm->destroyAllocations(handles, allocationCount, fenceSignaled ? 0 : lastFenceValue, resourceHandle);
     DEBUG_BREAK_IF(!destroyStatus);
 }
+void DeferrableDeletionImpl::waitForFence() {
+    wddm->waitFromCpu(lastFenceValue);
+}
 DeferrableDeletionImpl::~DeferrableDeletionImpl() {
     if (handles) {
         delete[] handles;
@@ -32,6 +32,8 @@ class DeferrableDeletionImpl : public DeferrableDeletion {
     DeferrableDeletionImpl(Wddm *wddm, D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue,
                            D3DKMT_HANDLE resourceHandle);
     void apply() override;
+    uint64_t getFenceValue() const override { return lastFenceValue; }
+    void waitForFence() override;
     ~DeferrableDeletionImpl();
 
   protected:
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -63,6 +63,11 @@ int Allocator32bit::free(void *ptr, size_t size) {
     return 0;
 }
 
+bool Allocator32bit::getStatistics(HeapStatistics &stats) {
+    heapAllocator->getStatistics(stats);
+    return true;
+}
+
 uintptr_t Allocator32bit::getBase() {
     return (uintptr_t)base;
 }
@@ -56,6 +56,9 @@ WddmMemoryManager::WddmMemoryManager(bool enable64kbPages, Wddm *wddm) : MemoryM
     if (asyncDeleterEnabled)
         deferredDeleter = createDeferredDeleter();
     mallocRestrictions.minAddress = wddm->getWddmMinAddress();
+    if (DebugManager.flags.ResidencyBudgetInMegabytes.get() > 0) {
+        lruResidencyManager.setBudget(DebugManager.flags.ResidencyBudgetInMegabytes.get() * MemoryConstants::megaByte);
+    }
 }
 
 void APIENTRY WddmMemoryManager::trimCallback(_Inout_ D3DKMT_TRIMNOTIFICATION *trimNotification) {
@@ -309,7 +312,8 @@ void WddmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation
             unlockResource(input);
             input->setLocked(false);
         }
-        auto status = tryDeferDeletions(allocationHandles, allocationCount, input->getResidencyData().lastFence, resourceHandle);
+        bool highPriority = input->getUnderlyingBufferSize() >= DeferredDeleter::highPrioritySizeThreshold;
+        auto status = tryDeferDeletions(allocationHandles, allocationCount, input->getResidencyData().lastFence, resourceHandle, highPriority);
         DEBUG_BREAK_IF(!status);
         alignedFreeWrapper(cpuPtr);
     }
@@ -317,10 +321,12 @@ void WddmMemoryManager::freeGraphicsMemoryImpl(GraphicsAllocation *gfxAllocation
     delete gfxAllocation;
 }
 
-bool WddmMemoryManager::tryDeferDeletions(D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue, D3DKMT_HANDLE resourceHandle) {
+bool WddmMemoryManager::tryDeferDeletions(D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue, D3DKMT_HANDLE resourceHandle, bool highPriority) {
     bool status = true;
     if (deferredDeleter) {
-        deferredDeleter->deferDeletion(DeferrableDeletion::create(wddm, handles, allocationCount, lastFenceValue, resourceHandle));
+        auto deletion = DeferrableDeletion::create(wddm, handles, allocationCount, lastFenceValue, resourceHandle);
+        deletion->setHighPriority(highPriority);
+        deferredDeleter->deferDeletion(deletion);
     } else {
         status = wddm->destroyAllocations(handles, allocationCount, lastFenceValue, resourceHandle);
     }
@@ -754,6 +760,52 @@ bool WddmMemoryManager::trimResidencyToBudget(uint64_t bytes) {
     return numberOfBytesToTrim == 0;
 }
 
+void WddmMemoryManager::evictColdAllocations() {
+    if (!lruResidencyManager.isBudgetExceeded()) {
+        return;
+    }
+    acquireResidencyLock();
+    lruResidencyManager.evictColdAllocations([this](GraphicsAllocation &allocation) {
+        return evictCompletedAllocation(static_cast<WddmAllocation &>(allocation));
+    });
+    releaseResidencyLock();
+}
+
+bool WddmMemoryManager::evictCompletedAllocation(WddmAllocation &allocation) {
+    // monitored fence covers every submission on this device, not only one command stream receiver
+    auto completedFence = *wddm->getMonitoredFence().cpuAddress;
+    if (allocation.getResidencyData().lastFence > completedFence) {
+        return false;
+    }
+
+    uint64_t sizeToTrim = 0;
+    if (allocation.fragmentsStorage.fragmentCount == 0) {
+        if (allocation.getResidencyData().resident) {
+            wddm->evict(&allocation.handle, 1, sizeToTrim);
+        }
+    } else {
+        D3DKMT_HANDLE fragmentEvictHandles[max_fragments_count] = {0};
+        uint32_t fragmentsToEvict = 0;
+        for (uint32_t allocationId = 0; allocationId < allocation.fragmentsStorage.fragmentCount; allocationId++) {
+            auto residency = allocation.fragmentsStorage.fragmentStorageData[allocationId].residency;
+            // fragments shared with allocations of newer submissions stay resident
+            if (residency->resident && residency->lastFence <= completedFence) {
+                fragmentEvictHandles[fragmentsToEvict++] = allocation.fragmentsStorage.fragmentStorageData[allocationId].osHandleStorage->handle;
+                residency->resident = false;
+            }
+        }
+        if (fragmentsToEvict != 0) {
+            wddm->evict(fragmentEvictHandles, fragmentsToEvict, sizeToTrim);
+        }
+    }
+    allocation.getResidencyData().resident = false;
+
+    if (allocation.getTrimCandidateListPosition() != trimListUnusedPosition) {
+        removeFromTrimCandidateList(&allocation, true);
+    }
+    return true;
+}
+
 bool WddmMemoryManager::mapAuxGpuVA(GraphicsAllocation *graphicsAllocation) {
     return wddm->updateAuxTable(graphicsAllocation->getGpuAddress(), graphicsAllocation->gmm, true);
 }
@@ -81,9 +81,10 @@ class WddmMemoryManager : public MemoryManager {
         residencyLock = false;
     }
 
-    bool tryDeferDeletions(D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue, D3DKMT_HANDLE resourceHandle);
+    bool tryDeferDeletions(D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue, D3DKMT_HANDLE resourceHandle, bool highPriority = false);
 
-    bool isMemoryBudgetExhausted() const override { return memoryBudgetExhausted; }
+    bool isMemoryBudgetExhausted() const override { return memoryBudgetExhausted || lruResidencyManager.isBudgetExceeded(); }
+    void evictColdAllocations() override;
 
     bool mapAuxGpuVA(GraphicsAllocation *graphicsAllocation) override;
 
@@ -108,6 +109,7 @@ class WddmMemoryManager : public MemoryManager {
     void compactTrimCandidateList();
     void trimResidency(D3DDDI_TRIMRESIDENCYSET_FLAGS flags, uint64_t bytes);
     bool trimResidencyToBudget(uint64_t bytes);
+    bool evictCompletedAllocation(WddmAllocation &allocation);
     static bool validateAllocation(WddmAllocation *alloc);
     bool checkTrimCandidateListCompaction();
     void checkTrimCandidateCount();
@@ -22,6 +22,7 @@
 
 #include <string>
 #include "runtime/helpers/hw_info.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/platform/extensions.h"
 
 namespace OCLRT {
@@ -48,13 +49,20 @@ const char *deviceExtensionsList = "cl_khr_3d_image_writes "
                                    "cl_khr_throttle_hints "
                                    "cl_khr_create_command_queue ";
 
+uint32_t getClVersionToEnable(const HardwareInfo &hwInfo) {
+    if (DebugManager.flags.ForceOCLVersion.get() != 0) {
+        return DebugManager.flags.ForceOCLVersion.get();
+    }
+    return hwInfo.capabilityTable.clVersionSupport;
+}
+
 std::string getExtensionsList(const HardwareInfo &hwInfo) {
     std::string allExtensionsList;
     allExtensionsList.reserve(1000);
 
     allExtensionsList.append(deviceExtensionsList);
 
-    if (hwInfo.capabilityTable.clVersionSupport >= 21) {
+    if (getClVersionToEnable(hwInfo) >= 21) {
         allExtensionsList += "cl_khr_subgroups ";
         allExtensionsList += "cl_khr_il_program ";
     }
@@ -63,6 +71,19 @@ std::string getExtensionsList(const HardwareInfo &hwInfo) {
         allExtensionsList += "cl_khr_fp64 ";
     }
 
+    if (DebugManager.flags.EnableNV12.get()) {
+        allExtensionsList += "cl_intel_planar_yuv ";
+    }
+    if (DebugManager.flags.EnablePackedYuv.get()) {
+        allExtensionsList += "cl_intel_packed_yuv ";
+    }
+    if (DebugManager.flags.EnableIntelVme.get()) {
+        allExtensionsList += "cl_intel_motion_estimation ";
+    }
+    if (DebugManager.flags.EnableIntelAdvancedVme.get()) {
+        allExtensionsList += "cl_intel_advanced_motion_estimation ";
+    }
+
     return allExtensionsList;
 }
 
@@ -21,11 +21,16 @@
  */
 
 #pragma once
+#include <cstdint>
+#include <string>
 
 namespace OCLRT {
+struct HardwareInfo;
 
 extern const char *deviceExtensionsList;
 
+uint32_t getClVersionToEnable(const HardwareInfo &hwInfo);
+// extensions the device exposes on any host, the runtime adds the ones of enabled sharings on top of them
 std::string getExtensionsList(const HardwareInfo &hwInfo);
 std::string removeLastSpace(std::string &s);
 std::string convertEnabledExtensionsToCompilerInternalOptions(const char *deviceExtensions);
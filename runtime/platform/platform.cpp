@@ -32,6 +32,7 @@
 #include "runtime/helpers/string.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
+#include "runtime/program/async_build_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
 #include "CL/cl_ext.h"
@@ -46,6 +47,7 @@ Platform *platform() { return &platformImpl; }
 Platform::Platform() {
     devices.reserve(64);
     setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler>(new AsyncEventsHandler()));
+    setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(new AsyncBuildHandler()));
 }
 
 Platform::~Platform() {
@@ -174,6 +176,7 @@ bool Platform::isInitialized() {
 }
 
 void Platform::shutdown() {
+    asyncBuildHandler->closeThreads();
     asyncEventsHandler->closeThread();
     TakeOwnershipWrapper<Platform> platformOwnership(*this);
 
@@ -243,4 +246,13 @@ std::unique_ptr<AsyncEventsHandler> Platform::setAsyncEventsHandler(std::unique_
     return handler;
 }
 
+AsyncBuildHandler *Platform::getAsyncBuildHandler() {
+    return asyncBuildHandler.get();
+}
+
+std::unique_ptr<AsyncBuildHandler> Platform::setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler> handler) {
+    asyncBuildHandler.swap(handler);
+    return handler;
+}
+
 } // namespace OCLRT
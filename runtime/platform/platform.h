@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -34,6 +34,7 @@ namespace OCLRT {
 class CompilerInterface;
 class Device;
 class AsyncEventsHandler;
+class AsyncBuildHandler;
 struct HardwareInfo;
 
 template <>
@@ -67,6 +68,8 @@ class Platform : public BaseObject<_cl_platform_id> {
     const PlatformInfo &getPlatformInfo() const;
     AsyncEventsHandler *getAsyncEventsHandler();
     std::unique_ptr<AsyncEventsHandler> setAsyncEventsHandler(std::unique_ptr<AsyncEventsHandler> handler);
+    AsyncBuildHandler *getAsyncBuildHandler();
+    std::unique_ptr<AsyncBuildHandler> setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler> handler);
 
   protected:
     enum {
@@ -81,6 +84,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::unique_ptr<AsyncBuildHandler> asyncBuildHandler;
 };
 
 Platform *platform();
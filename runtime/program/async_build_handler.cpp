@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/program/async_build_handler.h"
+
+namespace OCLRT {
+AsyncBuildHandler::AsyncBuildHandler() {
+    auto threadCount = DebugManager.flags.AsyncProgramBuildThreads.get();
+    if (threadCount > 0) {
+        maxThreads = static_cast<uint32_t>(threadCount);
+    } else if (std::thread::hardware_concurrency() > 0) {
+        maxThreads = std::thread::hardware_concurrency();
+    }
+    threads.reserve(maxThreads);
+}
+
+AsyncBuildHandler::~AsyncBuildHandler() {
+    closeThreads();
+}
+
+void AsyncBuildHandler::submit(BuildTask task) {
+    std::unique_lock<std::mutex> lock(queueMtx);
+    taskQueue.push_back(std::move(task));
+    //Create on demand, so the pool never owns more workers than there are queued builds
+    if (idleThreads < taskQueue.size() && threads.size() < maxThreads) {
+        openThread();
+    }
+    queueCond.notify_one();
+}
+
+void AsyncBuildHandler::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMtx);
+    while (true) {
+        ++idleThreads;
+        queueCond.wait(lock, [this] { return !taskQueue.empty() || !allowProcessing; });
+        --idleThreads;
+        if (taskQueue.empty()) {
+            break;
+        }
+        auto task = std::move(taskQueue.front());
+        taskQueue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+void AsyncBuildHandler::closeThreads() {
+    std::unique_lock<std::mutex> lock(queueMtx);
+    if (threads.empty()) {
+        return;
+    }
+    allowProcessing = false;
+    queueCond.notify_all();
+    auto closingThreads = std::move(threads);
+    threads.clear();
+    lock.unlock();
+
+    for (auto &thread : closingThreads) {
+        thread->join();
+    }
+}
+
+size_t AsyncBuildHandler::peekNumThreads() {
+    std::lock_guard<std::mutex> lock(queueMtx);
+    return threads.size();
+}
+
+void AsyncBuildHandler::openThread() {
+    allowProcessing = true;
+    threads.push_back(std::unique_ptr<std::thread>(new std::thread([this] { workerLoop(); })));
+}
+} // namespace OCLRT
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+// Runs program builds requested with a notify callback on runtime-owned worker threads.
+// Workers are started on first use, one per queued build up to the configured thread count.
+class AsyncBuildHandler {
+  public:
+    using BuildTask = std::function<void()>;
+
+    AsyncBuildHandler();
+    virtual ~AsyncBuildHandler();
+    void submit(BuildTask task);
+    // runs all queued builds to completion, then joins the workers
+    void closeThreads();
+
+    size_t peekNumThreads();
+    uint32_t getMaxThreads() const {
+        return maxThreads;
+    }
+
+  protected:
+    void workerLoop();
+    MOCKABLE_VIRTUAL void openThread();
+
+    std::deque<BuildTask> taskQueue;
+    std::vector<std::unique_ptr<std::thread>> threads;
+    std::mutex queueMtx;
+    std::condition_variable queueCond;
+    uint32_t maxThreads = 1;
+    uint32_t idleThreads = 0;
+    bool allowProcessing = false;
+};
+} // namespace OCLRT
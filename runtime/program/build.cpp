@@ -25,6 +25,7 @@
 #include "runtime/compiler_interface/compiler_options.h"
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/platform/platform.h"
+#include "runtime/program/async_build_handler.h"
 #include "runtime/helpers/validators.h"
 #include "program.h"
 #include <cstring>
@@ -61,14 +62,12 @@ cl_int Program::build(
         }
 
         // check to see if a previous build request is in progress
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
+        // the state of the ongoing build (possibly running asynchronously) must not be touched
+        if (!tryStartBuild()) {
+            return CL_INVALID_OPERATION;
         }
 
         if (isCreatedFromBinary == false) {
-            buildStatus = CL_BUILD_IN_PROGRESS;
-
             options = (buildOptions) ? buildOptions : "";
             std::string reraStr = "-cl-intel-gtpin-rera";
             size_t pos = options.find(reraStr);
@@ -86,7 +85,6 @@ cl_int Program::build(
                 break;
             }
 
-            TranslationArgs inputArgs = {};
             if (strcmp(sourceCode.c_str(), "") == 0) {
                 retVal = CL_INVALID_PROGRAM;
                 break;
@@ -97,46 +95,72 @@ cl_int Program::build(
             }
 
             internalOptions.append(platform()->peekCompilerExtensions());
-            inputArgs.pInput = (char *)(sourceCode.c_str());
-            inputArgs.InputSize = (uint32_t)sourceCode.size();
-            inputArgs.pOptions = options.c_str();
-            inputArgs.OptionsSize = (uint32_t)options.length();
-            inputArgs.pInternalOptions = internalOptions.c_str();
-            inputArgs.InternalOptionsSize = (uint32_t)internalOptions.length();
-            inputArgs.pTracingOptions = nullptr;
-            inputArgs.TracingOptionsCount = 0;
-            DBG_LOG(LogApiCalls,
-                    "Build Options", inputArgs.pOptions,
-                    "\nBuild Internal Options", inputArgs.pInternalOptions);
-
-            retVal = pCompilerInterface->build(*this, inputArgs, enableCaching);
-            if (retVal != CL_SUCCESS) {
-                break;
-            }
         }
-        updateNonUniformFlag();
 
-        retVal = processGenBinary();
-        if (retVal != CL_SUCCESS) {
-            break;
+        if ((funcNotify != nullptr) && DebugManager.flags.EnableAsyncProgramBuild.get()) {
+            // keeps the program alive until the notify callback returns, even if released by the application
+            this->incRefInternal();
+            platform()->getAsyncBuildHandler()->submit([this, funcNotify, userData, enableCaching]() {
+                completeBuild(processBuild(enableCaching), funcNotify, userData);
+                this->decRefInternal();
+            });
+            return CL_SUCCESS;
         }
 
-        separateBlockKernels();
+        retVal = processBuild(enableCaching);
     } while (false);
 
+    completeBuild(retVal, funcNotify, userData);
+
+    return retVal;
+}
+
+cl_int Program::processBuild(bool enableCaching) {
+    cl_int retVal = CL_SUCCESS;
+    if (isCreatedFromBinary == false) {
+        TranslationArgs inputArgs = {};
+        inputArgs.pInput = (char *)(sourceCode.c_str());
+        inputArgs.InputSize = (uint32_t)sourceCode.size();
+        inputArgs.pOptions = options.c_str();
+        inputArgs.OptionsSize = (uint32_t)options.length();
+        inputArgs.pInternalOptions = internalOptions.c_str();
+        inputArgs.InternalOptionsSize = (uint32_t)internalOptions.length();
+        inputArgs.pTracingOptions = nullptr;
+        inputArgs.TracingOptionsCount = 0;
+        DBG_LOG(LogApiCalls,
+                "Build Options", inputArgs.pOptions,
+                "\nBuild Internal Options", inputArgs.pInternalOptions);
+
+        retVal = getCompilerInterface()->build(*this, inputArgs, enableCaching);
+        if (retVal != CL_SUCCESS) {
+            return retVal;
+        }
+    }
+    updateNonUniformFlag();
+
+    retVal = processGenBinary();
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    separateBlockKernels();
+    return retVal;
+}
+
+void Program::completeBuild(cl_int retVal,
+                            void(CL_CALLBACK *funcNotify)(cl_program program, void *userData),
+                            void *userData) {
     if (retVal != CL_SUCCESS) {
-        buildStatus = CL_BUILD_ERROR;
         programBinaryType = CL_PROGRAM_BINARY_TYPE_NONE;
+        buildStatus = CL_BUILD_ERROR;
     } else {
-        buildStatus = CL_BUILD_SUCCESS;
         programBinaryType = CL_PROGRAM_BINARY_TYPE_EXECUTABLE;
+        buildStatus = CL_BUILD_SUCCESS;
     }
 
     if (funcNotify != nullptr) {
         (*funcNotify)(this, userData);
     }
-
-    return retVal;
 }
 
 cl_int Program::build(const cl_device_id device, const char *buildOptions, bool enableCaching,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -79,13 +79,11 @@ cl_int Program::compile(
             break;
         }
 
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
+        // the state of the ongoing build (possibly running asynchronously) must not be touched
+        if (!tryStartBuild()) {
+            return CL_INVALID_OPERATION;
         }
 
-        buildStatus = CL_BUILD_IN_PROGRESS;
-
         options = (buildOptions != nullptr) ? buildOptions : "";
         std::string reraStr = "-cl-intel-gtpin-rera";
         size_t pos = options.find(reraStr);
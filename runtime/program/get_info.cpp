@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -47,6 +47,10 @@ cl_int Program::getInfo(cl_program_info paramName, size_t paramValueSize,
         break;
 
     case CL_PROGRAM_BINARIES:
+        if (buildStatus == CL_BUILD_IN_PROGRESS) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
         resolveProgramBinary();
         pSrc = elfBinary;
         retSize = sizeof(void **);
@@ -62,29 +66,34 @@ cl_int Program::getInfo(cl_program_info paramName, size_t paramValueSize,
         break;
 
     case CL_PROGRAM_BINARY_SIZES:
+        if (buildStatus == CL_BUILD_IN_PROGRESS) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
         resolveProgramBinary();
         pSrc = &elfBinarySize;
         retSize = srcSize = sizeof(size_t *);
         break;
 
     case CL_PROGRAM_KERNEL_NAMES:
+        // kernels may be replaced by a build running asynchronously, do not touch them before checking the status
+        if (buildStatus != CL_BUILD_SUCCESS) {
+            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
+        }
         kernelNamesString = getKernelNamesString();
         pSrc = kernelNamesString.c_str();
         retSize = srcSize = kernelNamesString.length() + 1;
+        break;
 
+    case CL_PROGRAM_NUM_KERNELS:
         if (buildStatus != CL_BUILD_SUCCESS) {
             retVal = CL_INVALID_PROGRAM_EXECUTABLE;
+            break;
         }
-        break;
-
-    case CL_PROGRAM_NUM_KERNELS:
         numKernels = kernelInfoArray.size();
         pSrc = &numKernels;
         retSize = srcSize = sizeof(numKernels);
-
-        if (buildStatus != CL_BUILD_SUCCESS) {
-            retVal = CL_INVALID_PROGRAM_EXECUTABLE;
-        }
         break;
 
     case CL_PROGRAM_NUM_DEVICES:
@@ -172,11 +181,16 @@ cl_int Program::getBuildInfo(cl_device_id device, cl_program_build_info paramNam
     }
 
     auto pDev = castToObject<Device>(device);
+    cl_build_status buildStatusValue = buildStatus;
+    // an ongoing build, possibly running on the async build worker, still writes the log and its results
+    bool buildInProgress = (buildStatusValue == CL_BUILD_IN_PROGRESS);
+    cl_program_binary_type binaryTypeValue = buildInProgress ? static_cast<cl_program_binary_type>(CL_PROGRAM_BINARY_TYPE_NONE) : programBinaryType;
+    size_t globalVarTotalSizeValue = buildInProgress ? 0u : globalVarTotalSize;
 
     switch (paramName) {
     case CL_PROGRAM_BUILD_STATUS:
         srcSize = retSize = sizeof(cl_build_status);
-        pSrc = &buildStatus;
+        pSrc = &buildStatusValue;
         break;
 
     case CL_PROGRAM_BUILD_OPTIONS:
@@ -185,7 +199,7 @@ cl_int Program::getBuildInfo(cl_device_id device, cl_program_build_info paramNam
         break;
 
     case CL_PROGRAM_BUILD_LOG: {
-        const char *pBuildLog = getBuildLog(pDev);
+        const char *pBuildLog = buildInProgress ? nullptr : getBuildLog(pDev);
 
         if (pBuildLog != nullptr) {
             pSrc = pBuildLog;
@@ -198,11 +212,11 @@ cl_int Program::getBuildInfo(cl_device_id device, cl_program_build_info paramNam
 
     case CL_PROGRAM_BINARY_TYPE:
         srcSize = retSize = sizeof(cl_program_binary_type);
-        pSrc = &programBinaryType;
+        pSrc = &binaryTypeValue;
         break;
 
     case CL_PROGRAM_BUILD_GLOBAL_VARIABLE_TOTAL_SIZE:
-        pSrc = &globalVarTotalSize;
+        pSrc = &globalVarTotalSizeValue;
         retSize = srcSize = sizeof(size_t);
         break;
 
@@ -241,5 +241,7 @@ struct KernelInfo {
     uint64_t kernelId = 0;
     bool isKernelHeapSubstituted = false;
     GraphicsAllocation *kernelAllocation = nullptr;
+    bool patchListParsingPending = false;
+    bool patchListParsingFailed = false;
 };
 } // namespace OCLRT
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/kernel_info_index.h"
+#include "runtime/helpers/fast_hash.h"
+#include "runtime/helpers/ptr_math.h"
+#include "patch_list.h"
+#include "patch_shared.h"
+
+#include <cstring>
+#include <string>
+
+using namespace iOpenCL;
+
+namespace OCLRT {
+
+namespace {
+const std::string blockKernelNameTag = "_dispatch_";
+
+uint64_t getKernelBlobSize(const SKernelBinaryHeaderCommon *pKernelHeader) {
+    return static_cast<uint64_t>(sizeof(SKernelBinaryHeaderCommon)) +
+           pKernelHeader->KernelNameSize +
+           pKernelHeader->KernelHeapSize +
+           pKernelHeader->GeneralStateHeapSize +
+           pKernelHeader->DynamicStateHeapSize +
+           pKernelHeader->SurfaceStateHeapSize +
+           pKernelHeader->PatchListSize;
+}
+
+uint32_t getKernelFlags(const SKernelBinaryHeaderCommon *pKernelHeader) {
+    auto pName = ptrOffset(reinterpret_cast<const char *>(pKernelHeader), sizeof(SKernelBinaryHeaderCommon));
+    std::string name(pName, strnlen(pName, pKernelHeader->KernelNameSize));
+    if (name.find(blockKernelNameTag) != std::string::npos) {
+        return KernelInfoIndexEntry::RequiresEagerParsing;
+    }
+
+    auto pPatchList = ptrOffset(pName, pKernelHeader->KernelNameSize +
+                                           pKernelHeader->KernelHeapSize +
+                                           pKernelHeader->GeneralStateHeapSize +
+                                           pKernelHeader->DynamicStateHeapSize +
+                                           pKernelHeader->SurfaceStateHeapSize);
+    size_t offset = 0;
+    while (offset + sizeof(SPatchItemHeader) <= pKernelHeader->PatchListSize) {
+        auto pPatch = reinterpret_cast<const SPatchItemHeader *>(ptrOffset(pPatchList, offset));
+        if (pPatch->Size < sizeof(SPatchItemHeader) || offset + pPatch->Size > pKernelHeader->PatchListSize) {
+            // leave malformed patch lists to the full parser, which reports them
+            return KernelInfoIndexEntry::RequiresEagerParsing;
+        }
+        if (pPatch->Token == PATCH_TOKEN_EXECUTION_ENVIRONMENT && pPatch->Size >= sizeof(SPatchExecutionEnvironment)) {
+            auto pExecutionEnvironment = reinterpret_cast<const SPatchExecutionEnvironment *>(pPatch);
+            if (pExecutionEnvironment->HasDeviceEnqueue || pExecutionEnvironment->SubgroupIndependentForwardProgressRequired) {
+                return KernelInfoIndexEntry::RequiresEagerParsing;
+            }
+        }
+        offset += pPatch->Size;
+    }
+    return 0;
+}
+
+template <typename VisitorT>
+bool walkKernels(const void *genBinary, size_t genBinarySize, VisitorT visitor) {
+    if (genBinary == nullptr || genBinarySize < sizeof(SProgramBinaryHeader)) {
+        return false;
+    }
+    auto pProgramHeader = reinterpret_cast<const SProgramBinaryHeader *>(genBinary);
+    if (pProgramHeader->Magic != MAGIC_CL) {
+        return false;
+    }
+
+    uint64_t offset = sizeof(SProgramBinaryHeader) + static_cast<uint64_t>(pProgramHeader->PatchListSize);
+    for (uint32_t i = 0; i < pProgramHeader->NumberOfKernels; i++) {
+        if (offset + sizeof(SKernelBinaryHeaderCommon) > genBinarySize) {
+            return false;
+        }
+        auto pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(ptrOffset(genBinary, static_cast<size_t>(offset)));
+        auto blobSize = getKernelBlobSize(pKernelHeader);
+        if (offset + blobSize > genBinarySize) {
+            return false;
+        }
+        if (!visitor(i, static_cast<uint32_t>(offset), static_cast<uint32_t>(blobSize), pKernelHeader)) {
+            return false;
+        }
+        offset += blobSize;
+    }
+    return true;
+}
+} // namespace
+
+bool KernelInfoIndex::build(const void *genBinary, size_t genBinarySize, std::vector<KernelInfoIndexEntry> &entries) {
+    entries.clear();
+    auto success = walkKernels(genBinary, genBinarySize, [&](uint32_t, uint32_t blobOffset, uint32_t blobSize, const SKernelBinaryHeaderCommon *pKernelHeader) {
+        entries.push_back({blobOffset, blobSize, getKernelFlags(pKernelHeader)});
+        return true;
+    });
+    if (!success) {
+        entries.clear();
+    }
+    return success;
+}
+
+bool KernelInfoIndex::validate(const void *genBinary, size_t genBinarySize, const std::vector<KernelInfoIndexEntry> &entries) {
+    uint32_t numKernels = 0;
+    auto success = walkKernels(genBinary, genBinarySize, [&](uint32_t kernelNum, uint32_t blobOffset, uint32_t blobSize, const SKernelBinaryHeaderCommon *) {
+        numKernels++;
+        return kernelNum < entries.size() &&
+               entries[kernelNum].blobOffset == blobOffset &&
+               entries[kernelNum].blobSize == blobSize;
+    });
+    return success && numKernels == entries.size();
+}
+
+bool KernelInfoIndex::requiresEagerParsing(const std::vector<KernelInfoIndexEntry> &entries) {
+    for (auto &entry : entries) {
+        if (entry.flags & KernelInfoIndexEntry::RequiresEagerParsing) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<char> KernelInfoIndex::serialize(const std::vector<KernelInfoIndexEntry> &entries) {
+    auto entriesSize = entries.size() * sizeof(KernelInfoIndexEntry);
+
+    KernelInfoIndexHeader header = {};
+    header.magic = KernelInfoIndexHeader::magicValue;
+    header.version = KernelInfoIndexHeader::currentVersion;
+    header.numEntries = static_cast<uint32_t>(entries.size());
+    header.checksum = FastHash::hash(reinterpret_cast<const char *>(entries.data()), entriesSize);
+
+    std::vector<char> data(sizeof(header) + entriesSize);
+    memcpy(data.data(), &header, sizeof(header));
+    if (entriesSize > 0) {
+        memcpy(data.data() + sizeof(header), entries.data(), entriesSize);
+    }
+    return data;
+}
+
+bool KernelInfoIndex::deserialize(const char *pData, size_t dataSize, std::vector<KernelInfoIndexEntry> &entries) {
+    KernelInfoIndexHeader header;
+    if (pData == nullptr || dataSize < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, pData, sizeof(header));
+    auto entriesSize = static_cast<uint64_t>(header.numEntries) * sizeof(KernelInfoIndexEntry);
+    if (header.magic != KernelInfoIndexHeader::magicValue ||
+        header.version != KernelInfoIndexHeader::currentVersion ||
+        entriesSize != dataSize - sizeof(header)) {
+        return false;
+    }
+    auto pEntries = pData + sizeof(header);
+    if (FastHash::hash(pEntries, static_cast<size_t>(entriesSize)) != header.checksum) {
+        return false;
+    }
+    entries.resize(header.numEntries);
+    if (entriesSize > 0) {
+        memcpy(entries.data(), pEntries, static_cast<size_t>(entriesSize));
+    }
+    return true;
+}
+} // namespace OCLRT
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OCLRT {
+
+// Location of a single kernel inside a gen binary, enough to parse its patch list later on
+struct KernelInfoIndexEntry {
+    enum Flags : uint32_t {
+        RequiresEagerParsing = 1 << 0, // device enqueue, subgroup forward progress or block kernel
+    };
+
+    uint32_t blobOffset;
+    uint32_t blobSize;
+    uint32_t flags;
+};
+static_assert(sizeof(KernelInfoIndexEntry) == 12, "KernelInfoIndexEntry is part of the on-disk format");
+
+struct KernelInfoIndexHeader {
+    static const uint32_t magicValue = 0x494b4c43; // "CLKI"
+    static const uint32_t currentVersion = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numEntries;
+    uint32_t reserved;
+    uint64_t checksum;
+};
+static_assert(sizeof(KernelInfoIndexHeader) == 24, "KernelInfoIndexHeader is part of the on-disk format");
+
+class KernelInfoIndex {
+  public:
+    static bool build(const void *genBinary, size_t genBinarySize, std::vector<KernelInfoIndexEntry> &entries);
+    static bool validate(const void *genBinary, size_t genBinarySize, const std::vector<KernelInfoIndexEntry> &entries);
+    static bool requiresEagerParsing(const std::vector<KernelInfoIndexEntry> &entries);
+
+    static std::vector<char> serialize(const std::vector<KernelInfoIndexEntry> &entries);
+    static bool deserialize(const char *pData, size_t dataSize, std::vector<KernelInfoIndexEntry> &entries);
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -70,17 +70,15 @@ cl_int Program::link(
             break;
         }
 
-        if (buildStatus == CL_BUILD_IN_PROGRESS) {
-            retVal = CL_INVALID_OPERATION;
-            break;
+        // the state of the ongoing build (possibly running asynchronously) must not be touched
+        if (!tryStartBuild()) {
+            return CL_INVALID_OPERATION;
         }
 
         options = (buildOptions != nullptr) ? buildOptions : "";
 
         isCreateLibrary = (strstr(options.c_str(), "-create-library") != nullptr);
 
-        buildStatus = CL_BUILD_IN_PROGRESS;
-
         pElfWriter = CLElfLib::CElfWriter::create(CLElfLib::EH_TYPE_OPENCL_OBJECTS, CLElfLib::EH_MACHINE_NONE, 0);
 
         StackVec<const Program *, 16> inputProgramsInternal;
@@ -26,6 +26,7 @@
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "runtime/program/kernel_info_index.h"
 #include "patch_list.h"
 #include "patch_shared.h"
 #include "program.h"
@@ -47,7 +48,7 @@ const KernelInfo *Program::getKernelInfo(
     auto it = std::find_if(kernelInfoArray.begin(), kernelInfoArray.end(),
                            [=](const KernelInfo *kInfo) { return (0 == strcmp(kInfo->name.c_str(), kernelName)); });
 
-    return (it != kernelInfoArray.end()) ? *it : nullptr;
+    return (it != kernelInfoArray.end()) ? getParsedKernelInfo(*it) : nullptr;
 }
 
 size_t Program::getNumKernels() const {
@@ -56,7 +57,23 @@ size_t Program::getNumKernels() const {
 
 const KernelInfo *Program::getKernelInfo(size_t ordinal) const {
     DEBUG_BREAK_IF(ordinal >= kernelInfoArray.size());
-    return kernelInfoArray[ordinal];
+    return getParsedKernelInfo(kernelInfoArray[ordinal]);
+}
+
+const KernelInfo *Program::getParsedKernelInfo(KernelInfo *kernelInfo) const {
+    if (!kernelInfosParsedOnDemand) {
+        return kernelInfo;
+    }
+
+    std::lock_guard<std::mutex> lock(kernelInfoParsingMutex);
+    if (kernelInfo->patchListParsingPending) {
+        kernelInfo->patchListParsingPending = false;
+        kernelInfo->patchListParsingFailed = (const_cast<Program *>(this)->parseKernel(*kernelInfo) != CL_SUCCESS);
+        if (kernelInfo->patchListParsingFailed) {
+            kernelInfoParsingFailed = true;
+        }
+    }
+    return kernelInfo->patchListParsingFailed ? nullptr : kernelInfo;
 }
 
 std::string Program::getKernelNamesString() const {
@@ -72,75 +89,90 @@ std::string Program::getKernelNamesString() const {
     return semiColonDelimitedKernelNameStr;
 }
 
-size_t Program::processKernel(
-    const void *pKernelBlob,
-    cl_int &retVal) {
-    size_t sizeProcessed = 0;
+size_t Program::processKernelHeader(const void *pKernelBlob, KernelInfo &kernelInfo) {
+    auto pCurKernelPtr = pKernelBlob;
+    kernelInfo.heapInfo.pBlob = pKernelBlob;
 
-    do {
-        auto pKernelInfo = KernelInfo::create();
-        if (!pKernelInfo) {
-            retVal = CL_OUT_OF_HOST_MEMORY;
-            break;
-        }
+    kernelInfo.heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
 
-        auto pCurKernelPtr = pKernelBlob;
-        pKernelInfo->heapInfo.pBlob = pKernelBlob;
+    std::string readName{reinterpret_cast<const char *>(pCurKernelPtr), kernelInfo.heapInfo.pKernelHeader->KernelNameSize};
+    kernelInfo.name = readName.c_str();
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->KernelNameSize);
 
-        pKernelInfo->heapInfo.pKernelHeader = reinterpret_cast<const SKernelBinaryHeaderCommon *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, sizeof(SKernelBinaryHeaderCommon));
+    kernelInfo.heapInfo.pKernelHeap = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->KernelHeapSize);
 
-        std::string readName{reinterpret_cast<const char *>(pCurKernelPtr), pKernelInfo->heapInfo.pKernelHeader->KernelNameSize};
-        pKernelInfo->name = readName.c_str();
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelNameSize);
+    kernelInfo.heapInfo.pGsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->GeneralStateHeapSize);
 
-        pKernelInfo->heapInfo.pKernelHeap = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->KernelHeapSize);
+    kernelInfo.heapInfo.pDsh = pCurKernelPtr;
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->DynamicStateHeapSize);
 
-        pKernelInfo->heapInfo.pGsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->GeneralStateHeapSize);
+    kernelInfo.heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
+    pCurKernelPtr = ptrOffset(pCurKernelPtr, kernelInfo.heapInfo.pKernelHeader->SurfaceStateHeapSize);
 
-        pKernelInfo->heapInfo.pDsh = pCurKernelPtr;
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->DynamicStateHeapSize);
+    kernelInfo.heapInfo.pPatchList = pCurKernelPtr;
 
-        pKernelInfo->heapInfo.pSsh = const_cast<void *>(pCurKernelPtr);
-        pCurKernelPtr = ptrOffset(pCurKernelPtr, pKernelInfo->heapInfo.pKernelHeader->SurfaceStateHeapSize);
+    auto pKernelHeader = kernelInfo.heapInfo.pKernelHeader;
+    uint32_t kernelSize =
+        pKernelHeader->DynamicStateHeapSize +
+        pKernelHeader->GeneralStateHeapSize +
+        pKernelHeader->KernelHeapSize +
+        pKernelHeader->KernelNameSize +
+        pKernelHeader->PatchListSize +
+        pKernelHeader->SurfaceStateHeapSize;
 
-        pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
+    kernelInfo.heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
 
-        retVal = parsePatchList(*pKernelInfo);
-        if (retVal != CL_SUCCESS) {
-            delete pKernelInfo;
+    return kernelInfo.heapInfo.blobSize;
+}
 
-            sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
-            break;
-        }
+cl_int Program::parseKernel(KernelInfo &kernelInfo) {
+    auto retVal = parsePatchList(kernelInfo);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
 
-        auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
-        auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
+    if (genBinary)
+        kernelInfo.gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
 
-        if (genBinary)
-            pKernelInfo->gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
+    auto pKernel = ptrOffset(kernelInfo.heapInfo.pBlob, sizeof(SKernelBinaryHeaderCommon));
+    auto kernelSize = kernelInfo.heapInfo.blobSize - sizeof(SKernelBinaryHeaderCommon);
 
-        uint32_t kernelSize =
-            pKernelHeader->DynamicStateHeapSize +
-            pKernelHeader->GeneralStateHeapSize +
-            pKernelHeader->KernelHeapSize +
-            pKernelHeader->KernelNameSize +
-            pKernelHeader->PatchListSize +
-            pKernelHeader->SurfaceStateHeapSize;
+    uint32_t kernelCheckSum = kernelInfo.heapInfo.pKernelHeader->CheckSum;
 
-        pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
+    uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
 
-        uint32_t kernelCheckSum = pKernelInfo->heapInfo.pKernelHeader->CheckSum;
+    uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
+    kernelInfo.isValid = (calcCheckSum == kernelCheckSum);
 
-        uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+    return CL_SUCCESS;
+}
 
-        uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
-        pKernelInfo->isValid = (calcCheckSum == kernelCheckSum);
+size_t Program::processKernel(
+    const void *pKernelBlob,
+    cl_int &retVal) {
+    size_t sizeProcessed = 0;
+
+    do {
+        auto pKernelInfo = KernelInfo::create();
+        if (!pKernelInfo) {
+            retVal = CL_OUT_OF_HOST_MEMORY;
+            break;
+        }
+
+        auto kernelBlobSize = processKernelHeader(pKernelBlob, *pKernelInfo);
+
+        retVal = parseKernel(*pKernelInfo);
+        if (retVal != CL_SUCCESS) {
+            sizeProcessed = ptrDiff(pKernelInfo->heapInfo.pPatchList, pKernelBlob);
+            delete pKernelInfo;
+            break;
+        }
 
         retVal = CL_SUCCESS;
-        sizeProcessed = sizeof(SKernelBinaryHeaderCommon) + kernelSize;
+        sizeProcessed = kernelBlobSize;
         kernelInfoArray.push_back(pKernelInfo);
         if (pKernelInfo->hasDeviceEnqueue()) {
             parentKernelInfoArray.push_back(pKernelInfo);
@@ -153,6 +185,26 @@ size_t Program::processKernel(
     return sizeProcessed;
 }
 
+bool Program::processKernelHeadersOnly() {
+    // kernels which affect the whole program (device enqueue, block kernels) need their patch lists up front
+    if (!KernelInfoIndex::validate(genBinary, genBinarySize, kernelInfoIndex) &&
+        !KernelInfoIndex::build(genBinary, genBinarySize, kernelInfoIndex)) {
+        return false;
+    }
+    if (KernelInfoIndex::requiresEagerParsing(kernelInfoIndex)) {
+        return false;
+    }
+
+    for (auto &entry : kernelInfoIndex) {
+        auto pKernelInfo = KernelInfo::create();
+        processKernelHeader(ptrOffset(genBinary, entry.blobOffset), *pKernelInfo);
+        pKernelInfo->patchListParsingPending = true;
+        kernelInfoArray.push_back(pKernelInfo);
+    }
+    kernelInfosParsedOnDemand = true;
+    return true;
+}
+
 cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
     cl_int retVal = CL_SUCCESS;
 
@@ -811,6 +863,7 @@ cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
         auto kernelIsaSize = kernelInfo.heapInfo.pKernelHeader->KernelHeapSize;
         auto kernelAllocation = memoryManager->createInternalGraphicsAllocation(nullptr, kernelIsaSize);
         if (kernelAllocation) {
+            memoryManager->getMemoryUsageTracker().registerAllocation(*kernelAllocation, MemoryUsageType::Internal);
             memcpy_s(kernelAllocation->getUnderlyingBuffer(), kernelIsaSize, kernelInfo.heapInfo.pKernelHeap, kernelIsaSize);
             kernelInfo.kernelAllocation = kernelAllocation;
         } else {
@@ -973,6 +1026,10 @@ cl_int Program::processGenBinary() {
 
         pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pGenBinaryHeader->PatchListSize);
 
+        if (retVal == CL_SUCCESS && DebugManager.flags.EnableLazyKernelInfoParsing.get() && processKernelHeadersOnly()) {
+            break;
+        }
+
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
         for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
 
@@ -100,7 +100,9 @@ Program::~Program() {
     if (context && !isBuiltIn) {
         context->decRefInternal();
     }
-    delete[] genBinary;
+    if (!genBinaryStorage) {
+        delete[] genBinary;
+    }
     genBinary = nullptr;
 
     delete[] llvmBinary;
@@ -264,7 +266,26 @@ cl_int Program::getSource(char *&pBinary, unsigned int &dataSize) const {
 void Program::storeGenBinary(
     const void *pSrc,
     const size_t srcSize) {
+    if (genBinaryStorage) {
+        genBinary = nullptr;
+        genBinaryStorage.reset();
+    }
     storeBinary(genBinary, genBinarySize, pSrc, srcSize);
+    kernelInfoIndex.clear();
+}
+
+void Program::storeGenBinary(
+    std::shared_ptr<void> storage,
+    char *pBinary,
+    const size_t binarySize) {
+    DEBUG_BREAK_IF(!(storage && pBinary && binarySize > 0));
+    if (!genBinaryStorage) {
+        delete[] genBinary;
+    }
+    genBinaryStorage = std::move(storage);
+    genBinary = pBinary;
+    genBinarySize = binarySize;
+    kernelInfoIndex.clear();
 }
 
 void Program::storeLlvmBinary(
@@ -328,6 +349,16 @@ const char *Program::getBuildLog(const Device *pDevice) const {
     return entry;
 }
 
+bool Program::tryStartBuild() {
+    cl_build_status currentStatus = buildStatus;
+    do {
+        if (currentStatus == CL_BUILD_IN_PROGRESS) {
+            return false;
+        }
+    } while (!buildStatus.compare_exchange_strong(currentStatus, CL_BUILD_IN_PROGRESS));
+    return true;
+}
+
 CompilerInterface *Program::getCompilerInterface() const {
     return CompilerInterface::getInstance();
 }
@@ -418,6 +449,8 @@ void Program::cleanCurrentKernelInfo() {
         delete kernelInfo;
     }
     kernelInfoArray.clear();
+    kernelInfosParsedOnDemand = false;
+    kernelInfoParsingFailed = false;
 }
 
 void Program::updateNonUniformFlag() {
@@ -24,6 +24,7 @@
 #include "block_kernel_manager.h"
 #include "elf/reader.h"
 #include "kernel_info.h"
+#include "kernel_info_index.h"
 #include "runtime/api/cl_types.h"
 #include "runtime/device/device.h"
 #include "runtime/helpers/base_object.h"
@@ -31,9 +32,12 @@
 #include "runtime/helpers/string_helpers.h"
 #include "igfxfmid.h"
 #include "patch_list.h"
+#include <atomic>
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
@@ -146,6 +150,8 @@ class Program : public BaseObject<_cl_program> {
     size_t getNumKernels() const;
     const KernelInfo *getKernelInfo(const char *kernelName) const;
     const KernelInfo *getKernelInfo(size_t ordinal) const;
+    // set once a patch list parsed on demand turns out to be invalid, the program is not executable then
+    bool hasKernelInfoParsingFailed() const { return kernelInfoParsingFailed; }
 
     cl_int getInfo(cl_program_info paramName, size_t paramValueSize,
                    void *paramValue, size_t *paramValueSizeRet);
@@ -179,12 +185,23 @@ class Program : public BaseObject<_cl_program> {
     cl_int getSource(char *&pBinary, unsigned int &dataSize) const;
 
     void storeGenBinary(const void *pSrc, const size_t srcSize);
+    // uses the binary in place, storage keeps it alive for the lifetime of the program
+    void storeGenBinary(std::shared_ptr<void> storage, char *pBinary, const size_t binarySize);
 
     char *getGenBinary(size_t &genBinarySize) const {
         genBinarySize = this->genBinarySize;
         return this->genBinary;
     }
 
+    // offsets of kernels within the gen binary, saves scanning it when kernel infos are parsed on demand
+    void setKernelInfoIndex(std::vector<KernelInfoIndexEntry> index) {
+        kernelInfoIndex = std::move(index);
+    }
+
+    const std::vector<KernelInfoIndexEntry> &getKernelInfoIndex() const {
+        return kernelInfoIndex;
+    }
+
     void storeLlvmBinary(const void *pSrc, const size_t srcSize);
 
     void storeDebugData(const void *pSrc, const size_t srcSize);
@@ -197,6 +214,10 @@ class Program : public BaseObject<_cl_program> {
         return programBinaryType;
     }
 
+    cl_build_status getBuildStatus() const {
+        return buildStatus;
+    }
+
     bool getIsSpirV() const {
         return isSpirV;
     }
@@ -262,10 +283,25 @@ class Program : public BaseObject<_cl_program> {
 
     MOCKABLE_VIRTUAL cl_int rebuildProgramFromLLVM();
 
+    // atomically moves buildStatus to CL_BUILD_IN_PROGRESS, fails when another build already owns the program
+    bool tryStartBuild();
+
+    cl_int processBuild(bool enableCaching);
+
+    void completeBuild(cl_int retVal, void(CL_CALLBACK *funcNotify)(cl_program program, void *userData), void *userData);
+
     cl_int parsePatchList(KernelInfo &pKernelInfo);
 
     size_t processKernel(const void *pKernelBlob, cl_int &retVal);
 
+    size_t processKernelHeader(const void *pKernelBlob, KernelInfo &kernelInfo);
+
+    cl_int parseKernel(KernelInfo &kernelInfo);
+
+    bool processKernelHeadersOnly();
+
+    const KernelInfo *getParsedKernelInfo(KernelInfo *kernelInfo) const;
+
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
     bool validateGenBinaryDevice(GFXCORE_FAMILY device) const;
@@ -294,6 +330,7 @@ class Program : public BaseObject<_cl_program> {
 
     char*                     genBinary;
     size_t                    genBinarySize;
+    std::shared_ptr<void>     genBinaryStorage;
 
     char*                     llvmBinary;
     size_t                    llvmBinarySize;
@@ -304,6 +341,10 @@ class Program : public BaseObject<_cl_program> {
     std::vector<KernelInfo*>  kernelInfoArray;
     std::vector<KernelInfo*>  parentKernelInfoArray;
     std::vector<KernelInfo*>  subgroupKernelInfoArray;
+    std::vector<KernelInfoIndexEntry> kernelInfoIndex;
+    bool                      kernelInfosParsedOnDemand = false;
+    mutable std::atomic<bool> kernelInfoParsingFailed{false};
+    mutable std::mutex        kernelInfoParsingMutex;
     BlockKernelManager *      blockKernelManager;
 
     const void*               programScopePatchList;
@@ -314,7 +355,7 @@ class Program : public BaseObject<_cl_program> {
 
     size_t                    globalVarTotalSize;
 
-    cl_build_status           buildStatus;
+    std::atomic<cl_build_status> buildStatus;
     bool                      isCreatedFromBinary;
     bool                      isProgramBinaryResolved;
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+// Counting semaphore bounding how many callers may be inside a section at the same time.
+// Satisfies Lockable (lock/unlock), so it can be used with std::lock_guard and std::unique_lock.
+// A limit of 0 means unlimited - callers are only counted.
+class ConcurrencyLimiter {
+  public:
+    ConcurrencyLimiter() = default;
+    explicit ConcurrencyLimiter(uint32_t limit) : limit(limit) {}
+    ConcurrencyLimiter(const ConcurrencyLimiter &) = delete;
+    ConcurrencyLimiter &operator=(const ConcurrencyLimiter &) = delete;
+
+    void lock() {
+        std::unique_lock<std::mutex> guard(mtx);
+        slotFreed.wait(guard, [this] { return (limit == 0) || (active < limit); });
+        ++active;
+        ++totalEntries;
+        if (active > peakActive) {
+            peakActive = active;
+        }
+    }
+
+    bool try_lock() {
+        std::lock_guard<std::mutex> guard(mtx);
+        if ((limit != 0) && (active >= limit)) {
+            return false;
+        }
+        ++active;
+        ++totalEntries;
+        if (active > peakActive) {
+            peakActive = active;
+        }
+        return true;
+    }
+
+    void unlock() {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            --active;
+        }
+        slotFreed.notify_one();
+    }
+
+    void setLimit(uint32_t newLimit) {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            limit = newLimit;
+        }
+        slotFreed.notify_all();
+    }
+
+    uint32_t getLimit() const {
+        std::lock_guard<std::mutex> guard(mtx);
+        return limit;
+    }
+
+    uint32_t peekActive() const {
+        std::lock_guard<std::mutex> guard(mtx);
+        return active;
+    }
+
+    uint32_t peekPeakActive() const {
+        std::lock_guard<std::mutex> guard(mtx);
+        return peakActive;
+    }
+
+    uint64_t peekTotalEntries() const {
+        std::lock_guard<std::mutex> guard(mtx);
+        return totalEntries;
+    }
+
+  protected:
+    mutable std::mutex mtx;
+    std::condition_variable slotFreed;
+    uint32_t limit = 0;
+    uint32_t active = 0;
+    uint32_t peakActive = 0;
+    uint64_t totalEntries = 0;
+};
+
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -21,6 +21,8 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -29,5 +31,8 @@ namespace OCLRT {
 class Directory {
   public:
     static std::vector<std::string> getFiles(std::string &path);
+    // lastModificationTime is in seconds since the epoch
+    static bool getFileInfo(const std::string &path, size_t &size, uint64_t &lastModificationTime);
+    static bool touchFile(const std::string &path);
 };
 };
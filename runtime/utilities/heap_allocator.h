@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -28,6 +28,7 @@
 #include <algorithm>
 
 #include <vector>
+#include <mutex>
 #include <unordered_map>
 
 namespace OCLRT {
@@ -40,6 +41,19 @@ struct HeapChunk {
 
 bool operator<(const HeapChunk &hc1, const HeapChunk &hc2);
 
+struct HeapStatistics {
+    uint64_t totalSize = 0;
+    uint64_t usedSize = 0;
+    uint64_t freeSize = 0;
+    uint64_t largestFreeBlockSize = 0;
+    size_t freeChunksCount = 0;
+
+    // 0 when all free space is contiguous, approaching 1 when it is split into many small chunks
+    double getFragmentation() const {
+        return freeSize ? 1.0 - static_cast<double>(largestFreeBlockSize) / static_cast<double>(freeSize) : 0.0;
+    }
+};
+
 class HeapAllocator {
   public:
     HeapAllocator(void *address, uint64_t size) : address(address), size(size), availableSize(size), sizeThreshold(defaultSizeThreshold) {
@@ -150,6 +164,21 @@ class HeapAllocator {
         return 1.0 * (size - availableSize) / (size * 1.0);
     }
 
+    void getStatistics(HeapStatistics &stats) {
+        std::lock_guard<std::mutex> lock(mtx);
+        stats.totalSize = size;
+        stats.freeSize = availableSize;
+        stats.usedSize = size - availableSize;
+        stats.largestFreeBlockSize = pRightBound - pLeftBound;
+        stats.freeChunksCount = freedChunksSmall.size() + freedChunksBig.size();
+        for (const auto &chunk : freedChunksSmall) {
+            stats.largestFreeBlockSize = std::max(stats.largestFreeBlockSize, static_cast<uint64_t>(chunk.size));
+        }
+        for (const auto &chunk : freedChunksBig) {
+            stats.largestFreeBlockSize = std::max(stats.largestFreeBlockSize, static_cast<uint64_t>(chunk.size));
+        }
+    }
+
   protected:
     void *address;
     uint64_t size;
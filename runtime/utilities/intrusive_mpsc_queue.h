@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+
+namespace OCLRT {
+
+// Multiple producer, single consumer intrusive queue.
+// Producers push without locking, the consumer detaches all queued nodes at once.
+// Next is the node member used for linking; a node can be in one queue at a time.
+template <typename NodeObjectType, NodeObjectType *NodeObjectType::*Next>
+class IntrusiveMpscQueue {
+  public:
+    // Returns true when the queue was empty before the push,
+    // so that the producer knows the consumer may need to be woken up.
+    bool push(NodeObjectType &node) {
+        auto oldHead = head.load(std::memory_order_relaxed);
+        do {
+            node.*Next = oldHead;
+        } while (!head.compare_exchange_weak(oldHead, &node, std::memory_order_release, std::memory_order_relaxed));
+        return oldHead == nullptr;
+    }
+
+    // Detaches all nodes and returns them in push order
+    NodeObjectType *popAll() {
+        auto node = head.exchange(nullptr, std::memory_order_acquire);
+        NodeObjectType *reversed = nullptr;
+        while (node != nullptr) {
+            auto next = node->*Next;
+            node->*Next = reversed;
+            reversed = node;
+            node = next;
+        }
+        return reversed;
+    }
+
+    bool peekIsEmpty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+
+  protected:
+    std::atomic<NodeObjectType *> head{nullptr};
+};
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,6 +23,8 @@
 #include "runtime/utilities/directory.h"
 #include <cstdio>
 #include <dirent.h>
+#include <sys/stat.h>
+#include <utime.h>
 
 namespace OCLRT {
 
@@ -51,4 +53,18 @@ std::vector<std::string> Directory::getFiles(std::string &path) {
     closedir(dir);
     return files;
 }
+
+bool Directory::getFileInfo(const std::string &path, size_t &size, uint64_t &lastModificationTime) {
+    struct stat fileStat = {};
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+    lastModificationTime = static_cast<uint64_t>(fileStat.st_mtime);
+    return true;
+}
+
+bool Directory::touchFile(const std::string &path) {
+    return utime(path.c_str(), nullptr) == 0;
+}
 };
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace OCLRT {
+
+// Lightweight reader-writer lock for short, read-mostly critical sections.
+// Satisfies both Lockable (lock/unlock) and shared locking (lock_shared/unlock_shared),
+// so it can be used with std::unique_lock and with ReadLock below.
+// A pending writer blocks new readers, so writers are not starved by a steady stream of lookups.
+class ReadWriteLock {
+  public:
+    void lock() {
+        uint32_t expected = state.load(std::memory_order_relaxed);
+        while (true) {
+            if ((expected & writerBit) == 0 &&
+                state.compare_exchange_weak(expected, expected | writerBit, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+            std::this_thread::yield();
+            expected = state.load(std::memory_order_relaxed);
+        }
+        while ((state.load(std::memory_order_acquire) & readersMask) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() {
+        state.store(0, std::memory_order_release);
+    }
+
+    void lock_shared() {
+        uint32_t expected = state.load(std::memory_order_relaxed);
+        while (true) {
+            if ((expected & writerBit) == 0 &&
+                state.compare_exchange_weak(expected, expected + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+            if (expected & writerBit) {
+                std::this_thread::yield();
+                expected = state.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void unlock_shared() {
+        state.fetch_sub(1, std::memory_order_release);
+    }
+
+    uint32_t peekReadersCount() const {
+        return state.load() & readersMask;
+    }
+
+    bool peekWriterActive() const {
+        return (state.load() & writerBit) != 0;
+    }
+
+  protected:
+    static const uint32_t writerBit = 0x80000000u;
+    static const uint32_t readersMask = ~writerBit;
+    std::atomic<uint32_t> state{0};
+};
+
+class ReadLock {
+  public:
+    ReadLock(ReadWriteLock &rwLock) : rwLock(rwLock) {
+        rwLock.lock_shared();
+    }
+    ~ReadLock() {
+        rwLock.unlock_shared();
+    }
+    ReadLock(const ReadLock &) = delete;
+    ReadLock &operator=(const ReadLock &) = delete;
+
+  protected:
+    ReadWriteLock &rwLock;
+};
+
+} // namespace OCLRT
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,10 +24,12 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/memory_manager/memory_manager.h"
-#include "runtime/utilities/idlist.h"
 #include "runtime/utilities/tag_allocator_base.h"
 
+#include <atomic>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -35,7 +37,7 @@ namespace OCLRT {
 class GraphicsAllocation;
 
 template <typename TagType>
-struct TagNode : public IDNode<TagNode<TagType>> {
+struct TagNode {
   public:
     TagType *tag;
     GraphicsAllocation *getGraphicsAllocation() {
@@ -45,11 +47,18 @@ struct TagNode : public IDNode<TagNode<TagType>> {
   protected:
     TagNode() = default;
     GraphicsAllocation *gfxAllocation;
+    uint32_t nodeId = 0;
+    std::atomic<uint32_t> nextFreeNodeId{0};
 
     template <typename TagType2>
     friend class TagAllocator;
 };
 
+// Free tags are kept on a lock-free stack (Treiber stack) so getTag / returnTag never block.
+// Nodes are addressed by 1-based ids packed together with a version counter into a single
+// 64-bit head, which protects pops against ABA. allocationsMutex is only taken to add a pool.
+// Ids are resolved through pool segments of doubling size that are never reallocated, so
+// unlimited allocators keep growing while lock-free readers index the pools added so far.
 template <typename TagType>
 class TagAllocator : public TagAllocatorBase {
   public:
@@ -74,6 +83,10 @@ class TagAllocator : public TagAllocatorBase {
     }
 
     void cleanUpResources() override {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        freeTagsHead.store(0);
+        usedTagsCount.store(0);
+
         size_t size = gfxAllocations.size();
 
         for (uint32_t i = 0; i < size; ++i) {
@@ -86,70 +99,203 @@ class TagAllocator : public TagAllocatorBase {
             delete[] tagPoolMemory[i];
         }
         tagPoolMemory.clear();
+        for (auto &segment : tagPoolSegments) {
+            segment.reset();
+        }
+        tagPoolCount.store(0);
     }
 
     NodeType *getTag() {
-        NodeType *node = freeTags.removeFrontOne().release();
-        if (!node) {
-            populateFreeTags();
-            node = freeTags.removeFrontOne().release();
+        NodeType *node = popFreeTag();
+        while (!node) {
+            if (!populateFreeTags()) {
+                node = popFreeTag();
+                break;
+            }
+            node = popFreeTag();
         }
         if (node)
-            usedTags.pushFrontOne(*node);
+            usedTagsCount++;
         return node;
     }
 
     void returnTag(NodeType *node) {
-        NodeType *usedNode = usedTags.removeOne(*node).release();
-        DEBUG_BREAK_IF(usedNode == nullptr);
-        ((void)(usedNode));
-        freeTags.pushFrontOne(*node);
+        DEBUG_BREAK_IF(usedTagsCount.load() == 0);
+        usedTagsCount--;
+        pushFreeTags(*node, *node);
     }
+
+    // Allocates tag pools up front (up to maxTagPoolCount), so first enqueues do not pay for it
+    void preallocateTagPools(size_t poolCount) {
+        while (tagPoolCount.load() < poolCount) {
+            if (!addTagPool()) {
+                break;
+            }
+        }
+    }
+
     size_t peekMaxTagPoolCount() { return maxTagPoolCount; }
+    size_t peekTagPoolCount() { return tagPoolCount.load(); }
+    size_t peekUsedTagsCount() { return usedTagsCount.load(); }
 
   protected:
-    IDList<NodeType> freeTags;
-    IDList<NodeType> usedTags;
+    static const size_t tagPoolsInFirstSegment = 16;
+    static const size_t maxTagPoolSegments = 32;
+
     std::vector<GraphicsAllocation *> gfxAllocations;
     std::vector<NodeType *> tagPoolMemory;
+    std::unique_ptr<NodeType *[]> tagPoolSegments[maxTagPoolSegments];
 
     MemoryManager *memoryManager;
     const size_t maxTagPoolCount;
     size_t tagCount;
     size_t tagAlignment;
+    size_t nodesPerPool = 0;
 
+    std::atomic<uint64_t> freeTagsHead{0};
+    std::atomic<size_t> tagPoolCount{0};
+    std::atomic<size_t> usedTagsCount{0};
     std::mutex allocationsMutex;
 
-    void populateFreeTags() {
+    static uint64_t packHead(uint32_t nodeId, uint32_t version) {
+        return (static_cast<uint64_t>(version) << 32) | nodeId;
+    }
+
+    static uint32_t getHeadVersion(uint64_t head) {
+        return static_cast<uint32_t>(head >> 32);
+    }
 
+    // segment n holds tagPoolsInFirstSegment << n pools
+    static size_t getSegmentIndex(size_t poolIndex) {
+        size_t segmentIndex = 0;
+        for (size_t segmentsStart = poolIndex / tagPoolsInFirstSegment + 1; segmentsStart > 1; segmentsStart >>= 1) {
+            segmentIndex++;
+        }
+        return segmentIndex;
+    }
+
+    static size_t getSegmentStart(size_t segmentIndex) {
+        return tagPoolsInFirstSegment * ((static_cast<size_t>(1) << segmentIndex) - 1);
+    }
+
+    NodeType *getNode(uint32_t nodeId) const {
+        DEBUG_BREAK_IF(nodeId == 0);
+        size_t index = nodeId - 1;
+        size_t poolIndex = index / nodesPerPool;
+        size_t segmentIndex = getSegmentIndex(poolIndex);
+        return &tagPoolSegments[segmentIndex][poolIndex - getSegmentStart(segmentIndex)][index % nodesPerPool];
+    }
+
+    NodeType *peekFreeTagsHead() const {
+        uint32_t nodeId = static_cast<uint32_t>(freeTagsHead.load());
+        return nodeId ? getNode(nodeId) : nullptr;
+    }
+
+    NodeType *peekNextFreeTag(NodeType *node) const {
+        uint32_t nextNodeId = node->nextFreeNodeId.load();
+        return nextNodeId ? getNode(nextNodeId) : nullptr;
+    }
+
+    NodeType *popFreeTag() {
+        uint64_t head = freeTagsHead.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t nodeId = static_cast<uint32_t>(head);
+            if (nodeId == 0) {
+                return nullptr;
+            }
+            NodeType *node = getNode(nodeId);
+            uint64_t newHead = packHead(node->nextFreeNodeId.load(std::memory_order_relaxed), getHeadVersion(head) + 1);
+            if (freeTagsHead.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire)) {
+                return node;
+            }
+        }
+    }
+
+    // first..last must already be linked through nextFreeNodeId
+    void pushFreeTags(NodeType &first, NodeType &last) {
+        uint64_t head = freeTagsHead.load(std::memory_order_relaxed);
+        uint64_t newHead;
+        do {
+            last.nextFreeNodeId.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            newHead = packHead(first.nodeId, getHeadVersion(head) + 1);
+        } while (!freeTagsHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Returns false when no more pools can be added. When another thread has refilled the free
+    // stack while this one was waiting for the lock, no pool is added but true is returned.
+    bool populateFreeTags() {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        if (static_cast<uint32_t>(freeTagsHead.load()) != 0) {
+            return true;
+        }
+        return addTagPoolLocked();
+    }
+
+    bool addTagPool() {
+        std::unique_lock<std::mutex> lock(allocationsMutex);
+        return addTagPoolLocked();
+    }
+
+    bool addTagPoolLocked() {
         size_t tagSize = sizeof(TagType);
         tagSize = alignUp(tagSize, tagAlignment);
         size_t allocationSizeRequired = tagCount * tagSize;
 
-        std::unique_lock<std::mutex> lock(allocationsMutex);
-
-        size_t tagPoolCount = gfxAllocations.size();
-        if (tagPoolCount < maxTagPoolCount || maxTagPoolCount == 0) {
-            GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
-            gfxAllocations.push_back(graphicsAllocation);
+        size_t poolIndex = gfxAllocations.size();
+        if (maxTagPoolCount && poolIndex >= maxTagPoolCount) {
+            return false;
+        }
+        size_t segmentIndex = getSegmentIndex(poolIndex);
+        if (segmentIndex >= maxTagPoolSegments) {
+            return false;
+        }
+        GraphicsAllocation *graphicsAllocation = memoryManager->allocateGraphicsMemory(allocationSizeRequired);
+        if (!graphicsAllocation) {
+            return false;
+        }
+        memoryManager->getMemoryUsageTracker().registerAllocation(*graphicsAllocation, MemoryUsageType::TimestampTag);
 
-            uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
-            uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
-            uintptr_t End = Start + Size;
-            size_t nodeCount = Size / tagSize;
+        uintptr_t Size = graphicsAllocation->getUnderlyingBufferSize();
+        uintptr_t Start = reinterpret_cast<uintptr_t>(graphicsAllocation->getUnderlyingBuffer());
+        uintptr_t End = Start + Size;
+        size_t nodeCount = Size / tagSize;
+        if (nodesPerPool == 0) {
+            nodesPerPool = nodeCount;
+        }
+        if (nodesPerPool == 0) {
+            memoryManager->freeGraphicsMemory(graphicsAllocation);
+            return false;
+        }
+        // node ids are computed from a fixed pool stride and have to fit in 32 bits
+        DEBUG_BREAK_IF(nodeCount < nodesPerPool);
+        nodeCount = nodesPerPool;
+        if ((poolIndex + 1) * nodesPerPool >= std::numeric_limits<uint32_t>::max()) {
+            memoryManager->freeGraphicsMemory(graphicsAllocation);
+            return false;
+        }
+        if (!tagPoolSegments[segmentIndex]) {
+            tagPoolSegments[segmentIndex].reset(new NodeType *[tagPoolsInFirstSegment << segmentIndex]);
+        }
 
-            NodeType *nodesMemory = new NodeType[nodeCount];
+        NodeType *nodesMemory = new NodeType[nodeCount];
+        uint32_t firstNodeId = static_cast<uint32_t>(poolIndex * nodesPerPool + 1);
 
-            for (size_t i = 0; i < nodeCount; ++i) {
-                nodesMemory[i].gfxAllocation = graphicsAllocation;
-                nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
-                freeTags.pushTailOne(nodesMemory[i]);
-                Start += tagSize;
-            }
-            DEBUG_BREAK_IF(Start > End);
-            ((void)(End));
-            tagPoolMemory.push_back(nodesMemory);
+        for (size_t i = 0; i < nodeCount; ++i) {
+            nodesMemory[i].gfxAllocation = graphicsAllocation;
+            nodesMemory[i].tag = reinterpret_cast<TagType *>(Start);
+            nodesMemory[i].nodeId = firstNodeId + static_cast<uint32_t>(i);
+            nodesMemory[i].nextFreeNodeId.store(nodesMemory[i].nodeId + 1, std::memory_order_relaxed);
+            Start += tagSize;
         }
+        DEBUG_BREAK_IF(Start > End);
+        ((void)(End));
+
+        gfxAllocations.push_back(graphicsAllocation);
+        tagPoolMemory.push_back(nodesMemory);
+        tagPoolSegments[segmentIndex][poolIndex - getSegmentStart(segmentIndex)] = nodesMemory;
+        tagPoolCount++;
+        pushFreeTags(nodesMemory[0], nodesMemory[nodeCount - 1]);
+        return true;
     }
 };
 } // namespace OCLRT
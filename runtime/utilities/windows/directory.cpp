@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -51,4 +51,28 @@ std::vector<std::string> Directory::getFiles(std::string &path) {
     FindClose(hFind);
     return files;
 }
+
+bool Directory::getFileInfo(const std::string &path, size_t &size, uint64_t &lastModificationTime) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+    if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes) == 0) {
+        return false;
+    }
+    size = static_cast<size_t>((static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow);
+    // FILETIME counts 100ns intervals since 1601
+    uint64_t fileTime = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+    lastModificationTime = (fileTime - 116444736000000000ull) / 10000000ull;
+    return true;
+}
+
+bool Directory::touchFile(const std::string &path) {
+    HANDLE hFile = CreateFileA(path.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    auto result = SetFileTime(hFile, nullptr, nullptr, &now);
+    CloseHandle(hFile);
+    return result != 0;
+}
 };
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -112,6 +112,32 @@ TEST_F(clCreateKernelTests, invalidKernel) {
     delete pMockProg;
 }
 
+TEST_F(clCreateKernelTests, givenProgramWithBuildInProgressWhenCreatingKernelThenInvalidProgramExecutableIsReturned) {
+    cl_kernel kernel = nullptr;
+    KernelInfo *pKernelInfo = KernelInfo::create();
+    pKernelInfo->isValid = true;
+    pKernelInfo->name = "CopyBuffer";
+
+    MockProgram *pMockProg = new MockProgram(pContext, false);
+    pMockProg->addKernelInfo(pKernelInfo);
+    pMockProg->SetBuildStatus(CL_BUILD_IN_PROGRESS);
+
+    kernel = clCreateKernel(
+        pMockProg,
+        "CopyBuffer",
+        &retVal);
+
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+    EXPECT_EQ(nullptr, kernel);
+
+    cl_uint numKernelsRet = 0;
+    retVal = clCreateKernelsInProgram(pMockProg, 1, &kernel, &numKernelsRet);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+    EXPECT_EQ(nullptr, kernel);
+
+    delete pMockProg;
+}
+
 TEST_F(clCreateKernelTests, invalidParams) {
     cl_kernel kernel = nullptr;
     cl_program pProgram = nullptr;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -121,6 +121,25 @@ TEST_F(clGetDeviceInfoTests, givenNeoDeviceWhenAskedForDriverVersionThenNeoIsRet
     EXPECT_EQ((cl_uint)CL_DEVICE_DRIVER_VERSION_INTEL_NEO1, driverVersion);
 }
 
+TEST_F(clGetDeviceInfoTests, givenMemoryUsageQueryWhenGettingDeviceInfoThenMemoryUsageIsReturned) {
+    size_t paramRetSize = 0;
+    cl_device_memory_usage_intel memoryUsage = {};
+
+    retVal = clGetDeviceInfo(devices[0], CL_DEVICE_MEMORY_USAGE_INTEL, 0, nullptr, &paramRetSize);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(sizeof(cl_device_memory_usage_intel), paramRetSize);
+
+    retVal = clGetDeviceInfo(devices[0], CL_DEVICE_MEMORY_USAGE_INTEL, sizeof(memoryUsage), &memoryUsage, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    cl_ulong bytesPerType = 0;
+    for (auto &counters : memoryUsage.per_type) {
+        bytesPerType += counters.bytes;
+        EXPECT_GE(counters.peak_bytes, counters.bytes);
+    }
+    EXPECT_EQ(memoryUsage.total.bytes, bytesPerType);
+}
+
 //------------------------------------------------------------------------------
 struct GetDeviceInfoP : public api_fixture,
                         public ::testing::TestWithParam<uint32_t /*cl_device_info*/> {
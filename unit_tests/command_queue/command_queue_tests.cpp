@@ -27,6 +27,7 @@
 #include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/options.h"
+#include "runtime/utilities/tag_allocator.h"
 
 #include "unit_tests/command_queue/command_queue_fixture.h"
 #include "unit_tests/command_stream/command_stream_fixture.h"
@@ -34,6 +35,7 @@
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/fixtures/buffer_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/libult/ult_command_stream_receiver.h"
 #include "unit_tests/mocks/mock_memory_manager.h"
 #include "unit_tests/mocks/mock_command_queue.h"
@@ -844,3 +846,24 @@ TEST(CommandQueue, givenEnqueueReleaseSharedObjectsWhenIncorrectArgumentsThenRet
     result = cmdQ.enqueueReleaseSharedObjects(numObjects, memObjects, 0, nullptr, nullptr, 0);
     EXPECT_EQ(result, CL_INVALID_MEM_OBJECT);
 }
+
+TEST(CommandQueue, givenProfilingTagPoolsToPreallocateWhenProfilingQueueIsCreatedThenTimestampTagPoolsAreAllocated) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ProfilingTagPoolsToPreallocate.set(3);
+    auto mockDevice = std::unique_ptr<MockDevice>(MockDevice::create<MockDevice>(nullptr));
+    MockContext context;
+    cl_queue_properties props[] = {CL_QUEUE_PROPERTIES, CL_QUEUE_PROFILING_ENABLE, 0};
+
+    MockCommandQueue cmdQ(&context, mockDevice.get(), props);
+    EXPECT_EQ(3u, mockDevice->getMemoryManager()->getEventTsAllocator()->peekTagPoolCount());
+}
+
+TEST(CommandQueue, givenProfilingTagPoolsToPreallocateWhenQueueWithoutProfilingIsCreatedThenNoTagPoolsAreAllocated) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ProfilingTagPoolsToPreallocate.set(3);
+    auto mockDevice = std::unique_ptr<MockDevice>(MockDevice::create<MockDevice>(nullptr));
+    MockContext context;
+
+    MockCommandQueue cmdQ(&context, mockDevice.get(), nullptr);
+    EXPECT_EQ(1u, mockDevice->getMemoryManager()->getEventTsAllocator()->peekTagPoolCount());
+}
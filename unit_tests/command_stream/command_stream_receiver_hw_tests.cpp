@@ -2824,9 +2824,35 @@ HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenSusbsequ
 
 struct MockedMemoryManager : public OsAgnosticMemoryManager {
     bool isMemoryBudgetExhausted() const override { return budgetExhausted; }
+    void evictColdAllocations() override { evictColdAllocationsCalled++; }
     bool budgetExhausted = false;
+    uint32_t evictColdAllocationsCalled = 0;
 };
 
+HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrWhenTaskIsFlushedThenMemoryManagerIsAskedToEvictColdAllocations) {
+    CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
+    auto &commandStream = commandQueue.getCS(4096u);
+
+    std::unique_ptr<MockedMemoryManager> mockedMemoryManager(new MockedMemoryManager());
+    std::unique_ptr<MockCsrHw2<FamilyType>> mockCsr(new MockCsrHw2<FamilyType>(*platformDevices[0]));
+
+    mockedMemoryManager->device = pDevice;
+    mockCsr->setMemoryManager(mockedMemoryManager.get());
+    mockCsr->setTagAllocation(pDevice->getTagAllocation());
+
+    DispatchFlags dispatchFlags;
+    mockCsr->flushTask(commandStream,
+                       0,
+                       dsh,
+                       ih,
+                       ioh,
+                       ssh,
+                       taskLevel,
+                       dispatchFlags);
+
+    EXPECT_EQ(1u, mockedMemoryManager->evictColdAllocationsCalled);
+}
+
 HWTEST_F(CommandStreamReceiverFlushTaskTests, givenCsrInBatchingModeWhenTotalResourceUsedExhaustsTheBudgetThenDoImplicitFlush) {
     CommandQueueHw<FamilyType> commandQueue(nullptr, pDevice, 0);
     auto &commandStream = commandQueue.getCS(4096u);
@@ -242,6 +242,37 @@ TEST_F(CommandStreamReceiverTest, makeResidentWithoutParametersDoesNothing) {
     EXPECT_EQ(0u, residencyAllocations.size());
 }
 
+HWTEST_F(CommandStreamReceiverTest, givenResidencyBudgetWhenAllocationIsMadeResidentThenItIsTrackedAsUsedByNextSubmission) {
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto *memoryManager = csr.getMemoryManager();
+    auto &lruResidencyManager = memoryManager->getLruResidencyManager();
+    lruResidencyManager.setBudget(MemoryConstants::megaByte);
+
+    auto graphicsAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize);
+    csr.makeResident(*graphicsAllocation);
+
+    EXPECT_TRUE(lruResidencyManager.isTracked(*graphicsAllocation));
+    EXPECT_EQ(csr.peekTaskCount() + 1, lruResidencyManager.getLastUsedTaskCount(*graphicsAllocation));
+    EXPECT_EQ(MemoryConstants::pageSize, lruResidencyManager.getWorkingSetSize());
+
+    memoryManager->clearResidencyAllocations();
+    memoryManager->freeGraphicsMemory(graphicsAllocation);
+    EXPECT_EQ(0u, lruResidencyManager.getTrackedAllocationsCount());
+}
+
+HWTEST_F(CommandStreamReceiverTest, givenNoResidencyBudgetWhenAllocationIsMadeResidentThenItIsNotTracked) {
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto *memoryManager = csr.getMemoryManager();
+
+    auto graphicsAllocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize);
+    csr.makeResident(*graphicsAllocation);
+
+    EXPECT_FALSE(memoryManager->getLruResidencyManager().isTracked(*graphicsAllocation));
+
+    memoryManager->clearResidencyAllocations();
+    memoryManager->freeGraphicsMemory(graphicsAllocation);
+}
+
 HWTEST_F(CommandStreamReceiverTest, givenDefaultCommandStreamReceiverThenDefaultDispatchingPolicyIsImmediateSubmission) {
     auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
     EXPECT_EQ(CommandStreamReceiver::DispatchMode::ImmediateDispatch, csr.dispatchMode);
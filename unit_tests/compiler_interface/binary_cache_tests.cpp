@@ -20,13 +20,21 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <runtime/helpers/fast_hash.h>
 #include <runtime/helpers/hash.h>
 #include <runtime/helpers/hw_info.h>
+#include <runtime/helpers/options.h>
 #include <runtime/compiler_interface/binary_cache.h>
 #include "runtime/compiler_interface/compiler_interface.h"
 #include <runtime/helpers/string.h>
+#include <runtime/platform/extensions.h>
+#include <runtime/sharings/sharing_factory.h>
 #include <runtime/helpers/aligned_memory.h>
+#include <runtime/helpers/file_io.h>
+#include <runtime/utilities/directory.h>
+#include "patch_shared.h"
 #include <unit_tests/global_environment.h>
+#include <unit_tests/helpers/debug_manager_state_restore.h>
 #include <unit_tests/fixtures/device_fixture.h>
 #include <unit_tests/fixtures/memory_management_fixture.h>
 #include <unit_tests/mocks/mock_context.h>
@@ -34,6 +42,7 @@
 
 #include <memory>
 #include <array>
+#include <limits>
 #include <list>
 
 #include "test.h"
@@ -102,6 +111,32 @@ class BinaryCacheMock : public BinaryCache {
     bool loadResult = false;
 };
 
+class BinaryCacheKeyRecorder : public BinaryCacheMock {
+  public:
+    bool loadCachedBinary(const std::string kernelFileHash, Program &program) override {
+        recordedKeys.push_back(kernelFileHash);
+        return BinaryCacheMock::loadCachedBinary(kernelFileHash, program);
+    }
+
+    std::vector<std::string> recordedKeys;
+};
+
+class SharingsDisabledScope : public SharingFactory {
+  public:
+    SharingsDisabledScope() {
+        memcpy_s(savedState, sizeof(savedState), sharingContextBuilder, sizeof(sharingContextBuilder));
+        for (auto &builder : sharingContextBuilder) {
+            builder = nullptr;
+        }
+    }
+    ~SharingsDisabledScope() {
+        memcpy_s(sharingContextBuilder, sizeof(sharingContextBuilder), savedState, sizeof(savedState));
+    }
+
+  protected:
+    decltype(SharingFactory::sharingContextBuilder) savedState;
+};
+
 class CompilerInterfaceCachedFixture : public MemoryManagementFixture,
                                        public DeviceFixture {
   public:
@@ -221,6 +256,87 @@ TEST_F(BinaryCacheHashTests, hashShortBuffers) {
     }
 }
 
+TEST(FastHashTest, givenBuffersOfEveryLengthWhenHashedThenResultsAreUniqueAndRepeatable) {
+    char data[256];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<char>(i * 7 + 1);
+    }
+
+    std::set<uint64_t> hashes;
+    for (size_t i = 0; i <= sizeof(data); i++) {
+        auto res = FastHash::hash(data, i);
+        EXPECT_TRUE(hashes.insert(res).second) << "failed: " << i << " bytes";
+        EXPECT_EQ(res, FastHash::hash(data, i));
+    }
+}
+
+TEST(FastHashTest, givenMisalignedBufferWhenHashedThenResultMatchesAlignedCopy) {
+    auto originalPtr = alignedMalloc(1024, MemoryConstants::pageSize);
+    char aligned[100];
+    for (size_t i = 0; i < sizeof(aligned); i++) {
+        aligned[i] = static_cast<char>(i);
+    }
+    char *misalignedPtr = reinterpret_cast<char *>(originalPtr) + 3;
+    memcpy(misalignedPtr, aligned, sizeof(aligned));
+
+    for (size_t size : {1u, 5u, 17u, 49u, 100u}) {
+        EXPECT_EQ(FastHash::hash(aligned, size), FastHash::hash(misalignedPtr, size));
+    }
+    alignedFree(originalPtr);
+}
+
+TEST(FastHashTest, givenSameBytesSplitDifferentlyWhenUpdatedThenResultsDiffer) {
+    FastHash hash1;
+    hash1.update("ab", 2);
+    hash1.update("c", 1);
+
+    FastHash hash2;
+    hash2.update("a", 1);
+    hash2.update("bc", 2);
+
+    FastHash hash3(1);
+    hash3.update("a", 1);
+    hash3.update("bc", 2);
+
+    EXPECT_NE(hash1.finish(), hash2.finish());
+    EXPECT_NE(hash2.finish(), hash3.finish());
+}
+
+TEST_F(BinaryCacheHashTests, givenCacheKeyWhenItIsGeneratedThenItCarriesKeyVersion) {
+    HardwareInfo hwInfo = *platformDevices[0];
+    std::string input = "__kernel void k() {}";
+    std::string options = "-cl-opt-disable";
+    auto key = cache->getCachedFileName(hwInfo, ArrayRef<const char>(input.c_str(), input.size()),
+                                        ArrayRef<const char>(options.c_str(), options.size()),
+                                        ArrayRef<const char>(options.c_str(), options.size()));
+
+    std::string expectedPrefix = "v" + std::to_string(BinaryCache::cacheKeyVersion) + "-";
+    EXPECT_EQ(0u, key.find(expectedPrefix));
+    EXPECT_EQ(expectedPrefix.size() + 2 * sizeof(uint64_t), key.size());
+}
+
+TEST_F(BinaryCacheHashTests, givenSemanticallyEqualOptionsWhenCacheKeyIsGeneratedThenKeysAreEqualOnlyWithCanonicalization) {
+    DebugManagerStateRestore restorer;
+    HardwareInfo hwInfo = *platformDevices[0];
+    std::string input = "__kernel void k() {}";
+    std::string options = "-cl-mad-enable -cl-fast-relaxed-math -D B=2 -DA";
+    std::string reorderedOptions = " -DA -cl-fast-relaxed-math  -DB=2 -cl-mad-enable";
+    std::string internalOptions = "-cl-intel-gtpin-rera -cl-ext=-all,+cl_khr_fp64";
+    std::string differentOptions = "-cl-mad-enable -cl-fast-relaxed-math -D B=3 -DA";
+    auto getKey = [&](const std::string &opts) {
+        return cache->getCachedFileName(hwInfo, ArrayRef<const char>(input.c_str(), input.size()),
+                                        ArrayRef<const char>(opts.c_str(), opts.size()),
+                                        ArrayRef<const char>(internalOptions.c_str(), internalOptions.size()));
+    };
+
+    DebugManager.flags.EnableBinaryCacheOptionsCanonicalization.set(true);
+    EXPECT_EQ(getKey(options), getKey(reorderedOptions));
+    EXPECT_NE(getKey(options), getKey(differentOptions));
+
+    DebugManager.flags.EnableBinaryCacheOptionsCanonicalization.set(false);
+    EXPECT_NE(getKey(options), getKey(reorderedOptions));
+}
+
 TEST_F(BinaryCacheHashTests, testUnique) {
     static const size_t bufSize = 64;
     TranslationArgs args;
@@ -348,6 +464,232 @@ TEST_F(BinaryCacheTests, cacheThenLoad) {
     EXPECT_TRUE(ret);
 }
 
+TEST(BinaryCacheFileTest, givenPackedCacheFileWhenItIsUnpackedThenOriginalBinaryIsReturned) {
+    const char binary[] = "kernel_binary";
+    auto file = BinaryCache::packCacheFile(binary, sizeof(binary));
+    EXPECT_EQ(sizeof(BinaryCacheFileHeader) + sizeof(binary), file.size());
+
+    const char *pBinary = nullptr;
+    size_t binarySize = 0;
+    EXPECT_TRUE(BinaryCache::unpackCacheFile(file.data(), file.size(), pBinary, binarySize));
+    ASSERT_EQ(sizeof(binary), binarySize);
+    EXPECT_EQ(0, memcmp(binary, pBinary, binarySize));
+}
+
+TEST(BinaryCacheFileTest, givenTruncatedOrCorruptedCacheFileWhenItIsUnpackedThenFalseIsReturned) {
+    const char binary[] = "kernel_binary";
+    auto file = BinaryCache::packCacheFile(binary, sizeof(binary));
+    const char *pBinary = nullptr;
+    size_t binarySize = 0;
+
+    EXPECT_FALSE(BinaryCache::unpackCacheFile(file.data(), file.size() - 1, pBinary, binarySize));
+    EXPECT_FALSE(BinaryCache::unpackCacheFile(file.data(), sizeof(BinaryCacheFileHeader) - 1, pBinary, binarySize));
+    EXPECT_FALSE(BinaryCache::unpackCacheFile(binary, sizeof(binary), pBinary, binarySize));
+
+    file[sizeof(BinaryCacheFileHeader) + 2] ^= 0x1;
+    EXPECT_FALSE(BinaryCache::unpackCacheFile(file.data(), file.size(), pBinary, binarySize));
+    EXPECT_EQ(nullptr, pBinary);
+}
+
+TEST_F(BinaryCacheTests, givenCorruptedCacheFileWhenBinaryIsLoadedThenLoadFailsAndFileIsRemoved) {
+    MockProgram program;
+    auto filePath = BinaryCache::getCacheFilePath("CORRUPTED_HASH");
+    const char garbage[] = "not a cached binary";
+    writeDataToFile(filePath.c_str(), garbage, sizeof(garbage));
+    ASSERT_TRUE(fileExists(filePath));
+
+    EXPECT_FALSE(cache->loadCachedBinary("CORRUPTED_HASH", program));
+    EXPECT_FALSE(fileExists(filePath));
+}
+
+TEST_F(BinaryCacheTests, givenCachedBinaryWhenItIsLoadedThenFileContainsHeaderAndNoTemporaryFileIsLeft) {
+    const char binary[] = "published_binary";
+    EXPECT_TRUE(cache->cacheBinary("PUBLISHED_HASH", binary, sizeof(binary)));
+
+    void *pFile = nullptr;
+    auto fileSize = loadDataFromFile(BinaryCache::getCacheFilePath("PUBLISHED_HASH").c_str(), pFile);
+    EXPECT_EQ(sizeof(BinaryCacheFileHeader) + sizeof(binary), fileSize);
+    deleteDataReadFromFile(pFile);
+
+    std::string cacheLocation = CL_CACHE_LOCATION;
+    for (auto &file : Directory::getFiles(cacheLocation)) {
+        EXPECT_EQ(std::string::npos, file.find("PUBLISHED_HASH.cl_cache.")) << file;
+    }
+}
+
+TEST_F(BinaryCacheTests, givenGenBinaryWhenItIsCachedAndLoadedThenKernelInfoIndexIsRestored) {
+    const char kernelName[] = "abc";
+    iOpenCL::SProgramBinaryHeader programHeader = {};
+    programHeader.Magic = iOpenCL::MAGIC_CL;
+    programHeader.NumberOfKernels = 1;
+    iOpenCL::SKernelBinaryHeaderCommon kernelHeader = {};
+    kernelHeader.KernelNameSize = sizeof(kernelName);
+
+    std::vector<char> binary(sizeof(programHeader) + sizeof(kernelHeader) + sizeof(kernelName));
+    memcpy(binary.data(), &programHeader, sizeof(programHeader));
+    memcpy(binary.data() + sizeof(programHeader), &kernelHeader, sizeof(kernelHeader));
+    memcpy(binary.data() + sizeof(programHeader) + sizeof(kernelHeader), kernelName, sizeof(kernelName));
+
+    EXPECT_TRUE(cache->cacheBinary("INDEXED_HASH", binary.data(), static_cast<uint32_t>(binary.size())));
+    BinaryCache::getMemoryTier().clear();
+
+    MockProgram program;
+    EXPECT_TRUE(cache->loadCachedBinary("INDEXED_HASH", program));
+    auto &kernelInfoIndex = program.getKernelInfoIndex();
+    ASSERT_EQ(1u, kernelInfoIndex.size());
+    EXPECT_EQ(sizeof(programHeader), kernelInfoIndex[0].blobOffset);
+    EXPECT_EQ(sizeof(kernelHeader) + sizeof(kernelName), kernelInfoIndex[0].blobSize);
+    EXPECT_EQ(0u, kernelInfoIndex[0].flags);
+}
+
+TEST_F(BinaryCacheTests, givenCacheSizeLimitWhenFilesAreEvictedThenCacheFilesAreRemovedOnlyWhenLimitIsExceeded) {
+    const char binary[] = "evicted_binary";
+    EXPECT_TRUE(cache->cacheBinary("EVICTED_HASH", binary, sizeof(binary)));
+    auto filePath = BinaryCache::getCacheFilePath("EVICTED_HASH");
+
+    EXPECT_EQ(0u, BinaryCache::evictFiles(CL_CACHE_LOCATION, std::numeric_limits<uint64_t>::max()));
+    EXPECT_TRUE(fileExists(filePath));
+
+    EXPECT_LE(1u, BinaryCache::evictFiles(CL_CACHE_LOCATION, 0));
+    EXPECT_FALSE(fileExists(filePath));
+}
+
+TEST(BinaryCacheFileTest, givenCacheFilesWhenTheyAreVerifiedThenStaleCorruptedAndUnloadableEntriesAreReported) {
+    const char kernelName[] = "abc";
+    iOpenCL::SProgramBinaryHeader programHeader = {};
+    programHeader.Magic = iOpenCL::MAGIC_CL;
+    programHeader.Version = iOpenCL::CURRENT_ICBE_VERSION;
+    programHeader.Device = platformDevices[0]->pPlatform->eRenderCoreFamily;
+    programHeader.NumberOfKernels = 1;
+    iOpenCL::SKernelBinaryHeaderCommon kernelHeader = {};
+    kernelHeader.KernelNameSize = sizeof(kernelName);
+
+    std::vector<char> binary(sizeof(programHeader) + sizeof(kernelHeader) + sizeof(kernelName));
+    memcpy(binary.data(), &programHeader, sizeof(programHeader));
+    memcpy(binary.data() + sizeof(programHeader), &kernelHeader, sizeof(kernelHeader));
+    memcpy(binary.data() + sizeof(programHeader) + sizeof(kernelHeader), kernelName, sizeof(kernelName));
+
+    auto key = "v" + std::to_string(BinaryCache::cacheKeyVersion) + "-0123456789abcdef";
+    auto filePath = BinaryCache::getCacheFilePath(CL_CACHE_LOCATION, key);
+    auto file = BinaryCache::packCacheFile(binary.data(), binary.size());
+    ASSERT_TRUE(BinaryCache::publishFile(filePath, file.data(), file.size()));
+    EXPECT_EQ(CacheFileStatus::Valid, BinaryCache::verifyCacheFile(filePath, platformDevices[0]));
+
+    auto staleFilePath = BinaryCache::getCacheFilePath(CL_CACHE_LOCATION, "STALE_HASH");
+    ASSERT_TRUE(BinaryCache::publishFile(staleFilePath, file.data(), file.size()));
+    EXPECT_EQ(CacheFileStatus::StaleKey, BinaryCache::verifyCacheFile(staleFilePath));
+    std::remove(staleFilePath.c_str());
+
+    auto otherDevice = *platformDevices[0];
+    auto otherPlatform = *otherDevice.pPlatform;
+    otherPlatform.eRenderCoreFamily = static_cast<GFXCORE_FAMILY>(otherPlatform.eRenderCoreFamily + 1);
+    otherDevice.pPlatform = &otherPlatform;
+    EXPECT_EQ(CacheFileStatus::OtherDevice, BinaryCache::verifyCacheFile(filePath, &otherDevice));
+
+    reinterpret_cast<iOpenCL::SProgramBinaryHeader *>(binary.data())->Version = iOpenCL::CURRENT_ICBE_VERSION - 1;
+    file = BinaryCache::packCacheFile(binary.data(), binary.size());
+    ASSERT_TRUE(BinaryCache::publishFile(filePath, file.data(), file.size()));
+    EXPECT_EQ(CacheFileStatus::Unloadable, BinaryCache::verifyCacheFile(filePath));
+
+    file[sizeof(BinaryCacheFileHeader) + 2] ^= 0x1;
+    ASSERT_TRUE(BinaryCache::publishFile(filePath, file.data(), file.size()));
+    EXPECT_EQ(CacheFileStatus::Corrupted, BinaryCache::verifyCacheFile(filePath));
+    std::remove(filePath.c_str());
+}
+
+TEST_F(BinaryCacheTests, givenMappedLoadEnabledWhenCachedBinaryIsLoadedThenProgramUsesMappedFileWithoutCopy) {
+    DebugManagerStateRestore dbgRestore;
+    const char binary[] = "mapped_binary";
+    EXPECT_TRUE(cache->cacheBinary("MAPPED_HASH", binary, sizeof(binary)));
+
+    DebugManager.flags.EnableMappedBinaryCacheLoad.set(true);
+    {
+        MockProgram program;
+        EXPECT_TRUE(cache->loadCachedBinary("MAPPED_HASH", program));
+        EXPECT_NE(nullptr, program.genBinaryStorage);
+
+        size_t genBinarySize = 0;
+        auto genBinary = program.getGenBinary(genBinarySize);
+        ASSERT_EQ(sizeof(binary), genBinarySize);
+        EXPECT_EQ(0, memcmp(binary, genBinary, sizeof(binary)));
+
+        program.storeGenBinary(binary, sizeof(binary));
+        EXPECT_EQ(nullptr, program.genBinaryStorage);
+    }
+
+    DebugManager.flags.EnableMappedBinaryCacheLoad.set(false);
+    MockProgram program;
+    EXPECT_TRUE(cache->loadCachedBinary("MAPPED_HASH", program));
+    EXPECT_EQ(nullptr, program.genBinaryStorage);
+}
+
+TEST(BinaryCacheMemoryTierTest, givenInsertedBinaryWhenItIsFoundThenSameContentIsReturnedAndHitIsCounted) {
+    BinaryCacheMemoryTier memoryTier;
+    memoryTier.setBudget(BinaryCacheMemoryTier::numShards * 64);
+
+    const char binary[] = "binary";
+    memoryTier.insert("hash", binary, sizeof(binary));
+
+    auto found = memoryTier.find("hash");
+    ASSERT_NE(nullptr, found);
+    ASSERT_EQ(sizeof(binary), found->size());
+    EXPECT_EQ(0, memcmp(binary, found->data(), sizeof(binary)));
+    EXPECT_EQ(nullptr, memoryTier.find("other_hash"));
+
+    auto stats = memoryTier.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.insertions);
+    EXPECT_EQ(sizeof(binary), stats.bytesServed);
+    EXPECT_EQ(sizeof(binary), stats.cachedBytes);
+}
+
+TEST(BinaryCacheMemoryTierTest, givenShardBudgetExceededWhenBinaryIsInsertedThenLeastRecentlyUsedBinariesAreEvicted) {
+    BinaryCacheMemoryTier memoryTier;
+    memoryTier.setBudget(BinaryCacheMemoryTier::numShards * 64);
+
+    char binary[40] = {};
+    for (int i = 0; i < 64; i++) {
+        memoryTier.insert(std::to_string(i), binary, sizeof(binary));
+    }
+    auto stats = memoryTier.getStats();
+    EXPECT_EQ(64u, stats.insertions);
+    EXPECT_LE(stats.cachedBytes, BinaryCacheMemoryTier::numShards * 64u);
+    EXPECT_EQ(stats.insertions * sizeof(binary), stats.cachedBytes + stats.evictions * sizeof(binary));
+    EXPECT_NE(nullptr, memoryTier.find("63"));
+
+    char largeBinary[65] = {};
+    memoryTier.insert("large", largeBinary, sizeof(largeBinary));
+    EXPECT_EQ(nullptr, memoryTier.find("large"));
+
+    memoryTier.setBudget(0);
+    EXPECT_EQ(0u, memoryTier.getStats().cachedBytes);
+    EXPECT_EQ(nullptr, memoryTier.find("63"));
+}
+
+TEST(BinaryCacheMemoryTierTest, givenMemoryTierEnabledWhenCachedBinaryIsLoadedAgainThenItIsServedFromMemory) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.BinaryCacheMemoryTierSizeInMegabytes.set(1);
+    BinaryCache cache;
+    auto &memoryTier = BinaryCache::getMemoryTier();
+    EXPECT_EQ(MemoryConstants::megaByte, memoryTier.getBudget());
+
+    const char binary[] = "memory_tier_binary";
+    EXPECT_TRUE(cache.cacheBinary("MEMORY_TIER_HASH", binary, sizeof(binary)));
+
+    auto hitsBefore = memoryTier.getStats().hits;
+    MockProgram program;
+    EXPECT_TRUE(cache.loadCachedBinary("MEMORY_TIER_HASH", program));
+    EXPECT_EQ(hitsBefore + 1, memoryTier.getStats().hits);
+
+    size_t genBinarySize = 0;
+    auto genBinary = program.getGenBinary(genBinarySize);
+    ASSERT_EQ(sizeof(binary), genBinarySize);
+    EXPECT_EQ(0, memcmp(binary, genBinary, sizeof(binary)));
+
+    memoryTier.setBudget(0);
+}
+
 TEST_F(CompilerInterfaceCachedTests, canInjectCache) {
     std::unique_ptr<BinaryCache> cache(new BinaryCache());
     auto res1 = pCompilerInterface->replaceBinaryCache(cache.get());
@@ -447,3 +789,52 @@ TEST_F(CompilerInterfaceCachedTests, builtThenCached) {
     gEnvironment->fclPopDebugVars();
     gEnvironment->igcPopDebugVars();
 }
+
+TEST_F(CompilerInterfaceCachedTests, givenProgramBuiltFromSourceWhenCacheIsQueriedThenKeyMatchesTheOneOfflineCompilerWrites) {
+    // sharings depend on the host, without them the device exposes what cloc derives from the hardware info
+    SharingsDisabledScope sharingsDisabled;
+    pDevice->initializeCaps();
+
+    MockContext context(pDevice, true);
+    MockProgram program(&context, false);
+    BinaryCacheKeyRecorder cache;
+
+    // the extensions are appended the way Program::build takes them from the platform
+    const std::string options = "-cl-fast-relaxed-math";
+    program.SetSourceCode("__kernel void k() {}");
+    program.setBuildOptions(options.c_str());
+    program.getInternalOptions().append(convertEnabledExtensionsToCompilerInternalOptions(pDevice->getDeviceInfo().deviceExtensions));
+
+    MockCompilerDebugVars fclDebugVars;
+    fclDebugVars.fileName = gEnvironment->fclGetMockFile();
+    gEnvironment->fclPushDebugVars(fclDebugVars);
+
+    MockCompilerDebugVars igcDebugVars;
+    igcDebugVars.fileName = gEnvironment->igcGetMockFile();
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    auto compilerInterface = CompilerInterface::getInstance();
+    ASSERT_NE(nullptr, compilerInterface);
+    auto res1 = compilerInterface->replaceBinaryCache(&cache);
+    program.processBuild(true);
+    compilerInterface->replaceBinaryCache(res1);
+    CompilerInterface::shutdown();
+
+    gEnvironment->fclPopDebugVars();
+    gEnvironment->igcPopDebugVars();
+
+    ASSERT_EQ(1u, cache.recordedKeys.size());
+    ASSERT_NE(nullptr, program.GetLLVMBinary());
+
+    // cloc -cache_dir -device <device>, the OS extension is what -sharing_extensions is given on Windows
+    const auto &hwInfo = pDevice->getHardwareInfo();
+    std::string clocExtensions = getExtensionsList(hwInfo);
+#if defined(_WIN32)
+    clocExtensions += "cl_intel_simultaneous_sharing ";
+#endif
+    auto clocInternalOptions = BinaryCache::getProgramInternalOptions(hwInfo, pDevice->getDeviceInfo().force32BitAddressess, "", clocExtensions);
+    auto clocKey = BinaryCache::getCachedFileName(hwInfo, ArrayRef<const char>(program.GetLLVMBinary(), program.GetLLVMBinarySize()),
+                                                  ArrayRef<const char>(options.c_str(), options.size()),
+                                                  ArrayRef<const char>(clocInternalOptions.c_str(), clocInternalOptions.size()));
+    EXPECT_EQ(clocKey, cache.recordedKeys[0]);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -28,6 +28,7 @@
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/global_environment.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/test_files.h"
 #include "unit_tests/helpers/memory_management.h"
 #include "unit_tests/mocks/mock_cif.h"
@@ -37,6 +38,8 @@
 
 #include "gmock/gmock-matchers.h"
 
+#include <thread>
+
 using namespace OCLRT;
 
 #if defined(_WIN32)
@@ -222,6 +225,35 @@ TEST_F(CompilerInterfaceTest, CompileClToIsa) {
     EXPECT_EQ(CL_SUCCESS, retVal);
 }
 
+TEST_F(CompilerInterfaceTest, whenBuildIsInvokedThenEachTranslationTakesAndReleasesTranslationSlot) {
+    auto &limiter = pCompilerInterface->getTranslationLimiter();
+    limiter.setLimit(1);
+    auto entriesBefore = limiter.peekTotalEntries();
+
+    retVal = pCompilerInterface->build(*pProgram, inputArgs, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    EXPECT_EQ(entriesBefore + 2, limiter.peekTotalEntries());
+    EXPECT_EQ(0u, limiter.peekActive());
+    EXPECT_EQ(1u, limiter.peekPeakActive());
+}
+
+TEST_F(CompilerInterfaceTest, givenCompilerConcurrencyLimitFlagWhenCompilerInterfaceIsInitializedThenTranslationLimiterUsesIt) {
+    DebugManagerStateRestore restorer;
+
+    DebugManager.flags.CompilerConcurrencyLimit.set(3);
+    EXPECT_EQ(3u, MockCompilerInterface::getTranslationConcurrencyLimit());
+    MockCompilerInterface limitedCompilerInterface;
+    EXPECT_TRUE(limitedCompilerInterface.initialize());
+    EXPECT_EQ(3u, limitedCompilerInterface.getTranslationLimiter().getLimit());
+
+    DebugManager.flags.CompilerConcurrencyLimit.set(-1);
+    EXPECT_EQ(0u, MockCompilerInterface::getTranslationConcurrencyLimit());
+
+    DebugManager.flags.CompilerConcurrencyLimit.set(0);
+    EXPECT_EQ(std::thread::hardware_concurrency(), MockCompilerInterface::getTranslationConcurrencyLimit());
+}
+
 TEST_F(CompilerInterfaceTest, WhenBuildIsInvokedThenFclReceivesListOfExtensionsInInternalOptions) {
     std::string receivedInternalOptions;
 
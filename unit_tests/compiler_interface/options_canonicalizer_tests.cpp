@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/compiler_interface/options_canonicalizer.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace OCLRT;
+
+namespace {
+std::string canonicalize(const char *options) {
+    return OptionsCanonicalizer::canonicalize(options, strlen(options));
+}
+} // namespace
+
+TEST(OptionsCanonicalizerTest, givenReorderedFlagsAndExtraWhitespaceWhenCanonicalizedThenResultsAreEqual) {
+    auto canonical = canonicalize("-cl-mad-enable -cl-fast-relaxed-math");
+    EXPECT_EQ(canonical, canonicalize("  -cl-fast-relaxed-math\t-cl-mad-enable  "));
+    EXPECT_EQ(canonical, canonicalize("-cl-fast-relaxed-math -cl-mad-enable -cl-mad-enable"));
+    EXPECT_EQ("-cl-fast-relaxed-math -cl-mad-enable", canonical);
+}
+
+TEST(OptionsCanonicalizerTest, givenEmptyOrTerminatedOptionsWhenCanonicalizedThenTerminatorsAndWhitespaceAreDropped) {
+    EXPECT_EQ("", canonicalize(""));
+    EXPECT_EQ("", canonicalize("   "));
+    const char terminated[] = "-g -w";
+    EXPECT_EQ("-g -w", OptionsCanonicalizer::canonicalize(terminated, sizeof(terminated)));
+}
+
+TEST(OptionsCanonicalizerTest, givenDefinitionsWhenCanonicalizedThenTheyAreFoldedDeduplicatedAndSorted) {
+    auto canonical = canonicalize("-D B=2 -DA -DB=2");
+    EXPECT_EQ("-DA -DB=2", canonical);
+    EXPECT_EQ(canonical, canonicalize("-DA -D B=2"));
+}
+
+TEST(OptionsCanonicalizerTest, givenRedefinedMacroWhenCanonicalizedThenDefinitionOrderIsKept) {
+    EXPECT_EQ("-DA=2 -DA=1 -DA=2", canonicalize("-DA=2 -DA=1 -DA=2"));
+    EXPECT_NE(canonicalize("-DA=1 -DA=2"), canonicalize("-DA=2 -DA=1"));
+}
+
+TEST(OptionsCanonicalizerTest, givenUndefinitionWhenCanonicalizedThenDefinitionsStayInPlace) {
+    EXPECT_EQ("-cl-mad-enable -DA -U A -DB", canonicalize("-DA -U A -cl-mad-enable -D B"));
+    EXPECT_NE(canonicalize("-DA -UA"), canonicalize("-UA -DA"));
+}
+
+TEST(OptionsCanonicalizerTest, givenUnknownOptionsWhenCanonicalizedThenTheirOrderIsKept) {
+    EXPECT_EQ("-cl-opt-disable -I dir1 -I dir2 -cl-std=CL2.0 --unknown",
+              canonicalize("-I dir1 -cl-opt-disable -I dir2 -cl-std=CL2.0 --unknown"));
+    EXPECT_NE(canonicalize("-I dir2 -I dir1"), canonicalize("-I dir1 -I dir2"));
+    EXPECT_EQ("-cl-ext=-all,+cl_khr_fp64 -cl-intel-gtpin-rera", canonicalize("-cl-ext=-all,+cl_khr_fp64   -cl-intel-gtpin-rera"));
+}
+
+TEST(OptionsCanonicalizerTest, givenQuotedOrEscapedOptionsWhenCanonicalizedThenTheyAreReturnedVerbatim) {
+    EXPECT_EQ("-cl-mad-enable -DA=\"x y\" -g", canonicalize("-cl-mad-enable -DA=\"x y\" -g"));
+    EXPECT_EQ("-I dir\\ name  -g", canonicalize("-I dir\\ name  -g"));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -23,6 +23,8 @@
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/helpers/options.h"
+#include "runtime/indirect_heap/indirect_heap.h"
+#include "runtime/memory_manager/memory_manager.h"
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/device_queue/device_queue.h"
 #include "unit_tests/fixtures/platform_fixture.h"
@@ -262,6 +264,77 @@ TEST_F(ContextTest, GivenInteropSyncParamWhenCreateContextThenSetContextParam) {
     delete context;
 }
 
+TEST_F(ContextTest, givenWarmUpContextResourcesDebugVariableWhenContextIsCreatedThenHeapsAndCommandBuffersArePreallocatedOnReuseList) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.WarmUpContextResources.set(1);
+    auto memoryManager = context->getMM();
+    uint64_t reuseListBytesBefore = 0;
+    auto reuseListAllocationsBefore = memoryManager->allocationsForReuse.countAllocations(reuseListBytesBefore);
+
+    auto warmContext = Context::create<WhiteBoxContext>(properties, DeviceVector(devices, num_devices), nullptr, nullptr, retVal);
+    ASSERT_NE(nullptr, warmContext);
+
+    uint64_t reuseListBytes = 0;
+    auto reuseListAllocations = memoryManager->allocationsForReuse.countAllocations(reuseListBytes);
+    EXPECT_EQ(reuseListAllocationsBefore + IndirectHeap::NUM_TYPES - 1 + 2 + 1, reuseListAllocations);
+    EXPECT_LE(reuseListBytesBefore + optimalInstructionHeapSize + 6 * defaultHeapSize, reuseListBytes);
+
+    auto heapAllocation = memoryManager->obtainReusableAllocation(defaultHeapSize);
+    ASSERT_NE(nullptr, heapAllocation);
+    EXPECT_GT(optimalInstructionHeapSize, heapAllocation->getUnderlyingBufferSize());
+    memoryManager->freeGraphicsMemory(heapAllocation.release());
+    delete warmContext;
+}
+
+TEST_F(ContextTest, givenWarmedUpContextWhenAnotherContextWarmsUpThenReuseListDoesNotGrow) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.WarmUpContextResources.set(1);
+    auto memoryManager = context->getMM();
+
+    auto warmContext = Context::create<WhiteBoxContext>(properties, DeviceVector(devices, num_devices), nullptr, nullptr, retVal);
+    ASSERT_NE(nullptr, warmContext);
+    uint64_t reuseListBytes = 0;
+    auto reuseListAllocations = memoryManager->allocationsForReuse.countAllocations(reuseListBytes);
+
+    auto secondWarmContext = Context::create<WhiteBoxContext>(properties, DeviceVector(devices, num_devices), nullptr, nullptr, retVal);
+    ASSERT_NE(nullptr, secondWarmContext);
+    uint64_t reuseListBytesAfter = 0;
+    EXPECT_EQ(reuseListAllocations, memoryManager->allocationsForReuse.countAllocations(reuseListBytesAfter));
+    EXPECT_EQ(reuseListBytes, reuseListBytesAfter);
+
+    delete secondWarmContext;
+    delete warmContext;
+}
+
+TEST_F(ContextTest, givenWarmUpContextPropertyWhenContextIsCreatedThenResourcesArePreallocated) {
+    cl_context_properties warmUpProperties[] = {CL_CONTEXT_PLATFORM, properties[1],
+                                                CL_CONTEXT_WARM_UP_RESOURCES_INTEL, 1, 0};
+    auto memoryManager = context->getMM();
+    uint64_t reuseListBytes = 0;
+    auto reuseListAllocationsBefore = memoryManager->allocationsForReuse.countAllocations(reuseListBytes);
+
+    auto warmContext = Context::create<WhiteBoxContext>(warmUpProperties, DeviceVector(devices, num_devices), nullptr, nullptr, retVal);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(nullptr, warmContext);
+    EXPECT_LT(reuseListAllocationsBefore, memoryManager->allocationsForReuse.countAllocations(reuseListBytes));
+    delete warmContext;
+}
+
+TEST_F(ContextTest, givenWarmUpDisabledByDebugVariableWhenContextPropertyRequestsItThenNothingIsPreallocated) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.WarmUpContextResources.set(0);
+    cl_context_properties warmUpProperties[] = {CL_CONTEXT_PLATFORM, properties[1],
+                                                CL_CONTEXT_WARM_UP_RESOURCES_INTEL, 1, 0};
+    auto memoryManager = context->getMM();
+    uint64_t reuseListBytes = 0;
+    auto reuseListAllocationsBefore = memoryManager->allocationsForReuse.countAllocations(reuseListBytes);
+
+    auto warmContext = Context::create<WhiteBoxContext>(warmUpProperties, DeviceVector(devices, num_devices), nullptr, nullptr, retVal);
+    ASSERT_NE(nullptr, warmContext);
+    EXPECT_EQ(reuseListAllocationsBefore, memoryManager->allocationsForReuse.countAllocations(reuseListBytes));
+    delete warmContext;
+}
+
 class ContextWithAsyncDeleterTest : public ::testing::WithParamInterface<bool>,
                                     public ::testing::Test {
   public:
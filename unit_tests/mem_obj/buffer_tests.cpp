@@ -672,6 +672,43 @@ INSTANTIATE_TEST_CASE_P(
     BufferCalculateHostPtrSize,
     testing::ValuesIn(Inputs));
 
+TEST(BufferSvmPoolTests, givenPooledSvmPointerWhenBufferIsCreatedWithUseHostPtrThenBufferAddressesItsSuballocation) {
+    DebugManagerStateRestore dbgRestorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+
+    auto svmManager = context.getSVMAllocsManager();
+    auto ptr1 = svmManager->createSVMAlloc(MemoryConstants::pageSize);
+    auto ptr2 = svmManager->createSVMAlloc(MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, ptr1);
+    ASSERT_NE(nullptr, ptr2);
+    auto poolAllocation = svmManager->getSVMAlloc(ptr2);
+    ASSERT_EQ(poolAllocation, svmManager->getSVMAlloc(ptr1));
+    auto expectedOffset = ptrDiff(ptr2, poolAllocation->getUnderlyingBuffer());
+    EXPECT_NE(0u, expectedOffset);
+
+    auto buffer = Buffer::create(&context, CL_MEM_USE_HOST_PTR, MemoryConstants::pageSize, ptr2, retVal);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_TRUE(buffer->isMemObjWithHostPtrSVM());
+    EXPECT_EQ(poolAllocation, buffer->getGraphicsAllocation());
+    EXPECT_EQ(ptr2, buffer->getCpuAddress());
+    EXPECT_EQ(expectedOffset, buffer->getOffset());
+
+    size_t memObjOffset = 1;
+    EXPECT_EQ(CL_SUCCESS, buffer->getMemObjectInfo(CL_MEM_OFFSET, sizeof(memObjOffset), &memObjOffset, nullptr));
+    EXPECT_EQ(0u, memObjOffset);
+    delete buffer;
+
+    buffer = Buffer::create(&context, CL_MEM_USE_HOST_PTR, 2 * MemoryConstants::pageSize, ptr2, retVal);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_FALSE(buffer->isMemObjWithHostPtrSVM());
+    delete buffer;
+
+    svmManager->freeSVMAlloc(ptr1);
+    svmManager->freeSVMAlloc(ptr2);
+}
+
 TEST(Buffers64on32Tests, given32BitBufferCreatedWithUseHostPtrFlagThatIsZeroCopyWhenAskedForStorageThenHostPtrIsReturned) {
     DebugManagerStateRestore dbgRestorer;
     {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -24,6 +24,7 @@
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "unit_tests/fixtures/device_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_context.h"
 #include "unit_tests/mocks/mock_gmm.h"
 #include "test.h"
@@ -266,6 +267,49 @@ TEST_F(Image2dFromBufferTest, givenMemoryManagerSupportingVirtualPaddingWhenImag
     imageDesc.mem_object = storeMem;
     clReleaseMemObject(buffer2);
 }
+TEST_F(Image2dFromBufferTest, givenPaddedAllocationReuseEnabledWhenImagesAreRecreatedFromTheSameBufferThenPaddedAllocationIsReused) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnablePaddedAllocationReuse.set(true);
+    imageFormat.image_channel_data_type = CL_FLOAT;
+    imageFormat.image_channel_order = CL_RGBA;
+    imageDesc.image_width = 29;
+    imageDesc.image_height = 29;
+    imageDesc.image_row_pitch = 512;
+
+    auto bufferSize = imageDesc.image_row_pitch * imageDesc.image_height;
+    auto buffer2 = clCreateBuffer(&context, CL_MEM_READ_WRITE, bufferSize, nullptr, nullptr);
+    auto storeMem = imageDesc.mem_object;
+    imageDesc.mem_object = buffer2;
+
+    auto memoryManager = context.getMemoryManager();
+    memoryManager->setVirtualPaddingSupport(true);
+
+    auto buffer = castToObject<Buffer>(imageDesc.mem_object);
+    auto bufferGraphicsAllocation = buffer->getGraphicsAllocation();
+
+    std::unique_ptr<Image> imageFromBuffer(createImage());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    auto paddedAllocation = imageFromBuffer->getGraphicsAllocation();
+    EXPECT_NE(bufferGraphicsAllocation, paddedAllocation);
+
+    std::unique_ptr<Image> imageFromBuffer2(createImage());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(paddedAllocation, imageFromBuffer2->getGraphicsAllocation());
+    EXPECT_EQ(2u, paddedAllocation->peekPaddedUseCount());
+
+    imageFromBuffer.reset();
+    imageFromBuffer2.reset();
+    EXPECT_EQ(0u, paddedAllocation->peekPaddedUseCount());
+
+    std::unique_ptr<Image> imageFromBuffer3(createImage());
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(paddedAllocation, imageFromBuffer3->getGraphicsAllocation());
+    imageFromBuffer3.reset();
+
+    imageDesc.mem_object = storeMem;
+    clReleaseMemObject(buffer2);
+}
+
 TEST_F(Image2dFromBufferTest, givenMemoryManagerSupportingVirtualPaddingWhen1DImageFromBufferImageIsCreatedThenVirtualPaddingIsNotApplied) {
     imageFormat.image_channel_data_type = CL_FLOAT;
     imageFormat.image_channel_order = CL_RGBA;
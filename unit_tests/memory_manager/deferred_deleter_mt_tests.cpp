@@ -23,6 +23,7 @@
 #include "unit_tests/mocks/mock_deferred_deleter.h"
 #include "unit_tests/mocks/mock_deferrable_deletion.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "gtest/gtest.h"
 
 using namespace OCLRT;
@@ -248,3 +249,125 @@ TEST_F(DeferredDeleterTest, givenDeferredDeleterWhenNonBlockingDrainIsCalledThen
     EXPECT_EQ(0, deleter->areElementsReleasedCalled);
     EXPECT_EQ(1, deleter->drainCalled);
 }
+
+namespace {
+class OrderRecordingDeletion : public DeferrableDeletion {
+  public:
+    OrderRecordingDeletion(std::vector<int> &order, int id) : order(order), id(id) {}
+    void apply() override {
+        order.push_back(id);
+    }
+    std::vector<int> &order;
+    int id;
+};
+
+struct FencedDeletionRecord {
+    int waitForFenceCalled = 0;
+    bool appliedWithSignaledFence = false;
+};
+
+class FencedDeletion : public DeferrableDeletion {
+  public:
+    FencedDeletion(FencedDeletionRecord &record, uint64_t fenceValue) : record(record), fenceValue(fenceValue) {}
+    void apply() override {
+        record.appliedWithSignaledFence = fenceSignaled;
+    }
+    uint64_t getFenceValue() const override {
+        return fenceValue;
+    }
+    void waitForFence() override {
+        record.waitForFenceCalled++;
+    }
+    FencedDeletionRecord &record;
+    uint64_t fenceValue;
+};
+
+class DeferredDeleterWithWorkers : public DeferredDeleter {
+  public:
+    size_t getHelperWorkersCount() const {
+        return helperWorkers.size();
+    }
+    uint32_t getWorkersCount() const {
+        return workersCount;
+    }
+};
+} // namespace
+
+TEST_F(DeferredDeleterTest, givenHighPriorityDeletionWhenQueueIsClearedThenItIsAppliedBeforeRegularDeletions) {
+    std::vector<int> order;
+    deleter->DeferredDeleter::deferDeletion(new OrderRecordingDeletion(order, 0));
+    deleter->DeferredDeleter::deferDeletion(new OrderRecordingDeletion(order, 1));
+    auto highPriorityDeletion = new OrderRecordingDeletion(order, 2);
+    highPriorityDeletion->setHighPriority(true);
+    deleter->DeferredDeleter::deferDeletion(highPriorityDeletion);
+
+    deleter->drain();
+
+    ASSERT_EQ(3u, order.size());
+    EXPECT_EQ(2, order[0]);
+    EXPECT_EQ(0, order[1]);
+    EXPECT_EQ(1, order[2]);
+    EXPECT_EQ(1u, deleter->getStats().highPriorityDeletionsCompleted);
+}
+
+TEST_F(DeferredDeleterTest, givenMoreDeletionsThanBatchSizeWhenQueueIsClearedThenTheyAreAppliedInBatchesAndCounted) {
+    const size_t deletionsCount = DeferredDeleter::maxBatchSize + 10;
+    for (size_t i = 0; i < deletionsCount; i++) {
+        deleter->DeferredDeleter::deferDeletion(createDeletion());
+    }
+    EXPECT_EQ(deletionsCount, deleter->getStats().queueDepth);
+
+    deleter->drain();
+
+    auto stats = deleter->getStats();
+    EXPECT_EQ(deletionsCount, stats.deletionsCompleted);
+    EXPECT_EQ(2u, stats.batchesCompleted);
+    EXPECT_EQ(0u, stats.queueDepth);
+    EXPECT_EQ(deletionsCount, stats.maxQueueDepth);
+    EXPECT_LE(stats.maxLatencyInUs, stats.totalLatencyInUs);
+}
+
+TEST_F(DeferredDeleterTest, givenBatchWithFencesWhenQueueIsClearedThenOnlyTheLatestFenceIsWaitedFor) {
+    FencedDeletionRecord records[3];
+    deleter->DeferredDeleter::deferDeletion(new FencedDeletion(records[0], 3));
+    deleter->DeferredDeleter::deferDeletion(new FencedDeletion(records[1], 7));
+    deleter->DeferredDeleter::deferDeletion(new FencedDeletion(records[2], 5));
+
+    deleter->drain();
+
+    EXPECT_EQ(1u, deleter->getStats().batchesCompleted);
+    EXPECT_EQ(0, records[0].waitForFenceCalled);
+    EXPECT_EQ(1, records[1].waitForFenceCalled);
+    EXPECT_EQ(0, records[2].waitForFenceCalled);
+    for (auto &record : records) {
+        EXPECT_TRUE(record.appliedWithSignaledFence);
+    }
+}
+
+TEST(DeferredDeleterWorkersTest, givenWorkersCountSetWhenClientIsAddedThenWorkerPoolIsStartedAndReleasesAllDeletions) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.DeferredDeleterWorkersCount.set(3);
+    DeferredDeleterWithWorkers deleter;
+    EXPECT_EQ(3u, deleter.getWorkersCount());
+
+    deleter.addClient();
+    EXPECT_EQ(2u, deleter.getHelperWorkersCount());
+
+    const size_t deletionsCount = 4 * DeferredDeleter::maxBatchSize;
+    for (size_t i = 0; i < deletionsCount; i++) {
+        deleter.deferDeletion(new MockDeferrableDeletion());
+    }
+    deleter.drain(true);
+    EXPECT_EQ(deletionsCount, deleter.getStats().deletionsCompleted);
+
+    deleter.removeClient();
+    EXPECT_EQ(0u, deleter.getHelperWorkersCount());
+}
+
+TEST(DeferredDeleterWorkersTest, givenOutOfRangeWorkersCountWhenDeleterIsCreatedThenItIsClamped) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.DeferredDeleterWorkersCount.set(0);
+    EXPECT_EQ(1u, DeferredDeleterWithWorkers().getWorkersCount());
+    DebugManager.flags.DeferredDeleterWorkersCount.set(100);
+    EXPECT_EQ(DeferredDeleter::maxWorkersCount, DeferredDeleterWithWorkers().getWorkersCount());
+}
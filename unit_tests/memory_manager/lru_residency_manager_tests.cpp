@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/lru_residency_manager.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+TEST(LruResidencyManagerTest, givenDefaultManagerThenItIsDisabledAndBudgetIsNotExceeded) {
+    LruResidencyManager lruResidencyManager;
+    EXPECT_FALSE(lruResidencyManager.isEnabled());
+    EXPECT_FALSE(lruResidencyManager.isBudgetExceeded());
+    EXPECT_EQ(0u, lruResidencyManager.getBudget());
+    EXPECT_EQ(0u, lruResidencyManager.getTrackedAllocationsCount());
+}
+
+TEST(LruResidencyManagerTest, givenAllocationsUsedBySubmissionWhenMarkedUsedThenResidentBytesAndWorkingSetAreUpdated) {
+    LruResidencyManager lruResidencyManager;
+    GraphicsAllocation allocation1(nullptr, 4096);
+    GraphicsAllocation allocation2(nullptr, 8192);
+
+    lruResidencyManager.markUsed(allocation1, 1);
+    lruResidencyManager.markUsed(allocation2, 1);
+    EXPECT_EQ(12288u, lruResidencyManager.getResidentBytes());
+    EXPECT_EQ(12288u, lruResidencyManager.getWorkingSetSize());
+    EXPECT_EQ(1u, lruResidencyManager.getWorkingSetTaskCount());
+
+    lruResidencyManager.markUsed(allocation1, 2);
+    EXPECT_EQ(12288u, lruResidencyManager.getResidentBytes());
+    EXPECT_EQ(4096u, lruResidencyManager.getWorkingSetSize());
+    EXPECT_EQ(2u, lruResidencyManager.getLastUsedTaskCount(allocation1));
+    EXPECT_EQ(1u, lruResidencyManager.getLastUsedTaskCount(allocation2));
+
+    lruResidencyManager.markUsed(allocation1, 2);
+    EXPECT_EQ(4096u, lruResidencyManager.getWorkingSetSize());
+    EXPECT_EQ(2u, lruResidencyManager.getTrackedAllocationsCount());
+}
+
+TEST(LruResidencyManagerTest, givenTrackedAllocationWhenRemovedThenItIsNoLongerTracked) {
+    LruResidencyManager lruResidencyManager;
+    GraphicsAllocation allocation(nullptr, 4096);
+
+    lruResidencyManager.markUsed(allocation, 1);
+    EXPECT_TRUE(lruResidencyManager.isTracked(allocation));
+
+    lruResidencyManager.remove(allocation);
+    EXPECT_FALSE(lruResidencyManager.isTracked(allocation));
+    EXPECT_EQ(0u, lruResidencyManager.getResidentBytes());
+    EXPECT_EQ(ObjectNotUsed, lruResidencyManager.getLastUsedTaskCount(allocation));
+
+    lruResidencyManager.remove(allocation);
+    EXPECT_EQ(0u, lruResidencyManager.getTrackedAllocationsCount());
+}
+
+TEST(LruResidencyManagerTest, givenBudgetExceededWhenEvictingThenLeastRecentlyUsedAllocationsAreEvictedFirst) {
+    LruResidencyManager lruResidencyManager;
+    lruResidencyManager.setBudget(8192);
+    GraphicsAllocation allocation1(nullptr, 4096);
+    GraphicsAllocation allocation2(nullptr, 4096);
+    GraphicsAllocation allocation3(nullptr, 4096);
+
+    lruResidencyManager.markUsed(allocation1, 1);
+    lruResidencyManager.markUsed(allocation2, 1);
+    lruResidencyManager.markUsed(allocation1, 2);
+    lruResidencyManager.markUsed(allocation3, 3);
+    EXPECT_TRUE(lruResidencyManager.isBudgetExceeded());
+
+    ResidencyContainer evicted;
+    EXPECT_EQ(1u, lruResidencyManager.evictColdAllocations([&](GraphicsAllocation &allocation) {
+        evicted.push_back(&allocation);
+        return true;
+    }));
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ(&allocation2, evicted[0]);
+    EXPECT_FALSE(lruResidencyManager.isTracked(allocation2));
+    EXPECT_FALSE(lruResidencyManager.isBudgetExceeded());
+    EXPECT_EQ(8192u, lruResidencyManager.getResidentBytes());
+    EXPECT_EQ(4096u, lruResidencyManager.getEvictedBytes());
+}
+
+TEST(LruResidencyManagerTest, givenBudgetExceededWhenAllocationCannotBeEvictedYetThenEvictionStops) {
+    LruResidencyManager lruResidencyManager;
+    lruResidencyManager.setBudget(4096);
+    GraphicsAllocation allocation1(nullptr, 4096);
+    GraphicsAllocation allocation2(nullptr, 4096);
+    GraphicsAllocation allocation3(nullptr, 4096);
+
+    lruResidencyManager.markUsed(allocation1, 1);
+    lruResidencyManager.markUsed(allocation2, 2);
+    lruResidencyManager.markUsed(allocation3, 3);
+
+    uint32_t evictCalls = 0;
+    EXPECT_EQ(0u, lruResidencyManager.evictColdAllocations([&](GraphicsAllocation &allocation) {
+        evictCalls++;
+        return false;
+    }));
+    EXPECT_EQ(1u, evictCalls);
+    EXPECT_TRUE(lruResidencyManager.isTracked(allocation1));
+    EXPECT_TRUE(lruResidencyManager.isBudgetExceeded());
+
+    ResidencyContainer evicted;
+    EXPECT_EQ(2u, lruResidencyManager.evictColdAllocations([&](GraphicsAllocation &allocation) {
+        evicted.push_back(&allocation);
+        return true;
+    }));
+    ASSERT_EQ(2u, evicted.size());
+    EXPECT_EQ(&allocation1, evicted[0]);
+    EXPECT_EQ(&allocation2, evicted[1]);
+}
+
+TEST(LruResidencyManagerTest, givenWorkingSetOfLatestSubmissionAboveBudgetWhenEvictingThenWorkingSetIsKept) {
+    LruResidencyManager lruResidencyManager;
+    lruResidencyManager.setBudget(4096);
+    GraphicsAllocation allocation1(nullptr, 4096);
+    GraphicsAllocation allocation2(nullptr, 4096);
+
+    lruResidencyManager.markUsed(allocation1, 1);
+    lruResidencyManager.markUsed(allocation2, 1);
+
+    EXPECT_EQ(0u, lruResidencyManager.evictColdAllocations([](GraphicsAllocation &allocation) { return true; }));
+    EXPECT_EQ(2u, lruResidencyManager.getTrackedAllocationsCount());
+}
+
+TEST(LruResidencyManagerTest, givenResidencyBudgetDebugVariableWhenOsAgnosticMemoryManagerIsCreatedThenTrackingStaysDisabled) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.ResidencyBudgetInMegabytes.set(16);
+    OsAgnosticMemoryManager memoryManager;
+    EXPECT_FALSE(memoryManager.getLruResidencyManager().isEnabled());
+    EXPECT_FALSE(memoryManager.isMemoryBudgetExhausted());
+}
+
+TEST(LruResidencyManagerTest, givenTrackedAllocationsWhenTheyAreFreedThenTheyAreRemovedFromTracking) {
+    OsAgnosticMemoryManager memoryManager;
+    auto &lruResidencyManager = memoryManager.getLruResidencyManager();
+    lruResidencyManager.setBudget(MemoryConstants::pageSize);
+
+    auto allocation1 = memoryManager.allocateGraphicsMemory(MemoryConstants::pageSize);
+    auto allocation2 = memoryManager.allocateGraphicsMemory(MemoryConstants::pageSize);
+    lruResidencyManager.markUsed(*allocation1, 1);
+    lruResidencyManager.markUsed(*allocation2, 1);
+    EXPECT_TRUE(lruResidencyManager.isBudgetExceeded());
+
+    memoryManager.freeGraphicsMemory(allocation1);
+    EXPECT_FALSE(lruResidencyManager.isBudgetExceeded());
+    EXPECT_EQ(1u, lruResidencyManager.getTrackedAllocationsCount());
+
+    memoryManager.freeGraphicsMemory(allocation2);
+    EXPECT_EQ(0u, lruResidencyManager.getTrackedAllocationsCount());
+}
@@ -888,6 +888,53 @@ TEST(OsAgnosticMemoryManager, givenDefaultMemoryManagerWhenTwoGraphicsAllocation
     memoryManager.freeGraphicsMemory(graphicsAllocation);
 }
 
+TEST(OsAgnosticMemoryManager, givenPaddedAllocationReuseEnabledWhenSameSourceIsPaddedToSameSizeThenCachedPaddedAllocationIsReturned) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnablePaddedAllocationReuse.set(true);
+    OsAgnosticMemoryManager memoryManager;
+    auto graphicsAllocation = memoryManager.allocateGraphicsMemory(4096u, MemoryConstants::pageSize);
+
+    auto paddedGraphicsAllocation = memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 8192u);
+    ASSERT_NE(nullptr, paddedGraphicsAllocation);
+    EXPECT_EQ(graphicsAllocation, paddedGraphicsAllocation->peekPaddingSource());
+    EXPECT_EQ(1u, paddedGraphicsAllocation->peekPaddedUseCount());
+
+    auto paddedGraphicsAllocation2 = memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 8192u);
+    EXPECT_EQ(paddedGraphicsAllocation, paddedGraphicsAllocation2);
+    EXPECT_EQ(2u, paddedGraphicsAllocation->peekPaddedUseCount());
+
+    auto paddedGraphicsAllocation3 = memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 16384u);
+    EXPECT_NE(paddedGraphicsAllocation, paddedGraphicsAllocation3);
+    EXPECT_EQ(2u, graphicsAllocation->peekPaddedAllocations().size());
+
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation);
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation2);
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation3);
+    EXPECT_EQ(0u, paddedGraphicsAllocation->peekPaddedUseCount());
+
+    //released padded allocation stays cached on its source
+    EXPECT_EQ(paddedGraphicsAllocation, memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 8192u));
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation);
+
+    //freeing the source frees cached padded allocations
+    memoryManager.freeGraphicsMemory(graphicsAllocation);
+}
+
+TEST(OsAgnosticMemoryManager, givenDefaultSettingsWhenSameSourceIsPaddedTwiceThenNewPaddedAllocationsAreCreated) {
+    OsAgnosticMemoryManager memoryManager;
+    auto graphicsAllocation = memoryManager.allocateGraphicsMemory(4096u, MemoryConstants::pageSize);
+
+    auto paddedGraphicsAllocation = memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 8192u);
+    auto paddedGraphicsAllocation2 = memoryManager.createGraphicsAllocationWithPadding(graphicsAllocation, 8192u);
+    EXPECT_NE(paddedGraphicsAllocation, paddedGraphicsAllocation2);
+    EXPECT_EQ(nullptr, paddedGraphicsAllocation->peekPaddingSource());
+    EXPECT_TRUE(graphicsAllocation->peekPaddedAllocations().empty());
+
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation2);
+    memoryManager.freeGraphicsMemory(paddedGraphicsAllocation);
+    memoryManager.freeGraphicsMemory(graphicsAllocation);
+}
+
 TEST(OsAgnosticMemoryManager, pleaseDetectLeak) {
     void *ptr = new int[10];
     EXPECT_NE(nullptr, ptr);
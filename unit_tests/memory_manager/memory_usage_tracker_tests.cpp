@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/file_io.h"
+#include "runtime/memory_manager/memory_usage_tracker.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+
+using namespace OCLRT;
+
+TEST(MemoryUsageTrackerTest, givenAllocationsRegisteredWithTypesThenPerTypeAndTotalCountersAreUpdated) {
+    MemoryUsageTracker tracker;
+    GraphicsAllocation buffer(nullptr, 4096);
+    GraphicsAllocation image(nullptr, 8192);
+
+    tracker.registerAllocation(buffer, MemoryUsageType::Buffer);
+    tracker.registerAllocation(image, MemoryUsageType::Image);
+
+    auto bufferCounters = tracker.getCounters(MemoryUsageType::Buffer);
+    EXPECT_EQ(4096u, bufferCounters.bytes);
+    EXPECT_EQ(1u, bufferCounters.allocations);
+    EXPECT_EQ(8192u, tracker.getCounters(MemoryUsageType::Image).bytes);
+    EXPECT_EQ(0u, tracker.getCounters(MemoryUsageType::Heap).bytes);
+
+    auto totalCounters = tracker.getTotalCounters();
+    EXPECT_EQ(12288u, totalCounters.bytes);
+    EXPECT_EQ(2u, totalCounters.allocations);
+
+    tracker.unregisterAllocation(buffer);
+    tracker.unregisterAllocation(image);
+}
+
+TEST(MemoryUsageTrackerTest, givenTrackedAllocationWhenRegisteredAgainThenItIsCountedOnceWithFirstType) {
+    MemoryUsageTracker tracker;
+    GraphicsAllocation allocation(nullptr, 4096);
+
+    tracker.registerAllocation(allocation, MemoryUsageType::Buffer);
+    tracker.registerAllocation(allocation, MemoryUsageType::Image);
+
+    EXPECT_TRUE(tracker.isTracked(allocation));
+    EXPECT_EQ(4096u, tracker.getCounters(MemoryUsageType::Buffer).bytes);
+    EXPECT_EQ(0u, tracker.getCounters(MemoryUsageType::Image).bytes);
+    EXPECT_EQ(1u, tracker.getTotalCounters().allocations);
+
+    tracker.unregisterAllocation(allocation);
+}
+
+TEST(MemoryUsageTrackerTest, givenUnregisteredAllocationsThenCurrentCountersDropButPeakIsKept) {
+    MemoryUsageTracker tracker;
+    GraphicsAllocation allocation1(nullptr, 4096);
+    GraphicsAllocation allocation2(nullptr, 4096);
+
+    tracker.registerAllocation(allocation1, MemoryUsageType::Heap);
+    tracker.registerAllocation(allocation2, MemoryUsageType::Heap);
+    tracker.unregisterAllocation(allocation1);
+    tracker.unregisterAllocation(allocation2);
+    tracker.unregisterAllocation(allocation2);
+
+    EXPECT_FALSE(tracker.isTracked(allocation1));
+    auto counters = tracker.getCounters(MemoryUsageType::Heap);
+    EXPECT_EQ(0u, counters.bytes);
+    EXPECT_EQ(0u, counters.allocations);
+    EXPECT_EQ(8192u, counters.peakBytes);
+    EXPECT_EQ(8192u, tracker.getTotalCounters().peakBytes);
+}
+
+TEST(MemoryUsageTrackerTest, givenSnapshotWhenFormattedThenEveryTypeIsListed) {
+    MemoryUsageSnapshot snapshot;
+    snapshot.perType[static_cast<size_t>(MemoryUsageType::Svm)].bytes = 123;
+    snapshot.osHandles = 7;
+
+    auto dump = MemoryUsageTracker::formatSnapshot(snapshot);
+    for (size_t i = 0; i < memoryUsageTypeCount; i++) {
+        EXPECT_NE(std::string::npos, dump.find(MemoryUsageTracker::getTypeName(static_cast<MemoryUsageType>(i))));
+    }
+    EXPECT_NE(std::string::npos, dump.find("Svm 123 0 0"));
+    EXPECT_NE(std::string::npos, dump.find("OsHandles 7"));
+}
+
+TEST(MemoryUsageTrackerTest, givenNumaNodeInSnapshotWhenFormattedThenPlacementIsListed) {
+    MemoryUsageSnapshot snapshot;
+    EXPECT_EQ(std::string::npos, MemoryUsageTracker::formatSnapshot(snapshot).find("NumaNode"));
+
+    snapshot.numaNode = 1;
+    snapshot.numaPlacedBytes = 8192;
+    snapshot.numaFailedPlacements = 2;
+    auto dump = MemoryUsageTracker::formatSnapshot(snapshot);
+    EXPECT_NE(std::string::npos, dump.find("NumaNode 1 placedBytes 8192 failedPlacements 2"));
+}
+
+TEST(MemoryUsageTrackerTest, givenHugePagesInSnapshotWhenFormattedThenBackedBytesAreListedNextToAdvisedOnes) {
+    MemoryUsageSnapshot snapshot;
+    EXPECT_EQ(std::string::npos, MemoryUsageTracker::formatSnapshot(snapshot).find("HugePages"));
+
+    snapshot.hugePageAdvisedBytes = 4194304;
+    snapshot.hugePageBackedBytes = 2097152;
+    auto dump = MemoryUsageTracker::formatSnapshot(snapshot);
+    EXPECT_NE(std::string::npos, dump.find("HugePages advisedBytes 4194304 backedBytes 2097152"));
+}
+
+TEST(MemoryUsageTrackerTest, givenDumpRequestThenEachTrackerSeesItOnce) {
+    MemoryUsageTracker tracker1;
+    MemoryUsageTracker tracker2;
+    EXPECT_FALSE(tracker1.isDumpRequested());
+
+    MemoryUsageTracker::requestDump();
+    EXPECT_TRUE(tracker1.isDumpRequested());
+    EXPECT_FALSE(tracker1.isDumpRequested());
+    EXPECT_TRUE(tracker2.isDumpRequested());
+}
+
+TEST(MemoryUsageTrackerTest, givenSvmAllocationWhenFreedThroughMemoryManagerThenItIsUnregistered) {
+    OsAgnosticMemoryManager memoryManager;
+    auto allocation = memoryManager.allocateGraphicsMemoryForSVM(4096, false);
+    ASSERT_NE(nullptr, allocation);
+
+    auto &tracker = memoryManager.getMemoryUsageTracker();
+    EXPECT_EQ(allocation->getUnderlyingBufferSize(), tracker.getCounters(MemoryUsageType::Svm).bytes);
+    EXPECT_EQ(1u, tracker.getCounters(MemoryUsageType::Svm).allocations);
+
+    memoryManager.freeGraphicsMemory(allocation);
+    EXPECT_EQ(0u, tracker.getCounters(MemoryUsageType::Svm).bytes);
+    EXPECT_EQ(0u, tracker.getTotalCounters().allocations);
+}
+
+TEST(MemoryUsageTrackerTest, givenAllocationsOnReuseListWhenGettingMemoryUsageThenReuseListIsReported) {
+    OsAgnosticMemoryManager memoryManager;
+    auto allocation = memoryManager.allocateGraphicsMemory(4096);
+    memoryManager.storeAllocation(std::unique_ptr<GraphicsAllocation>(allocation), REUSABLE_ALLOCATION);
+
+    MemoryUsageSnapshot snapshot;
+    memoryManager.getMemoryUsage(snapshot);
+    EXPECT_EQ(1u, snapshot.reuseListAllocations);
+    EXPECT_EQ(allocation->getUnderlyingBufferSize(), snapshot.reuseListBytes);
+    EXPECT_EQ(0u, snapshot.hostPtrFragments);
+}
+
+TEST(MemoryUsageTrackerTest, givenMemoryUsageDumpFileWhenDumpingThenUsageIsAppendedToFile) {
+    DebugManagerStateRestore dbgRestore;
+    std::string fileName = "memory_usage_dump_test.txt";
+    std::remove(fileName.c_str());
+    DebugManager.flags.MemoryUsageDumpFile.set(fileName);
+
+    {
+        OsAgnosticMemoryManager memoryManager;
+        auto allocation = memoryManager.allocateGraphicsMemoryForSVM(4096, false);
+        memoryManager.dumpMemoryUsage();
+        memoryManager.freeGraphicsMemory(allocation);
+    }
+
+    void *data = nullptr;
+    auto dataSize = loadDataFromFile(fileName.c_str(), data);
+    ASSERT_NE(0u, dataSize);
+    std::string dump(static_cast<char *>(data), dataSize);
+    deleteDataReadFromFile(data);
+    std::remove(fileName.c_str());
+
+    auto firstDump = dump.find("Svm 4096 1 4096");
+    EXPECT_NE(std::string::npos, firstDump);
+    // usage is dumped again when memory manager is destroyed
+    EXPECT_NE(std::string::npos, dump.find("Svm 0 0 4096", firstDump));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,12 +25,14 @@
 #include "runtime/event/event.h"
 #include "runtime/memory_manager/svm_memory_manager.h"
 #include "runtime/utilities/tag_allocator.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/memory_management.h"
 #include "unit_tests/utilities/containers_tests_helpers.h"
 #include "unit_tests/fixtures/memory_allocator_fixture.h"
 #include "unit_tests/mocks/mock_context.h"
 
 #include <future>
+#include <vector>
 
 using namespace OCLRT;
 
@@ -145,3 +147,186 @@ TEST_F(SVMMemoryAllocatorTest, WhenCouldNotAllocateInMemoryManagerThenReturnsNul
         EXPECT_EQ(0U, svmM.GetSVMAllocs().getNumAllocs());
     }
 }
+
+TEST_F(SVMMemoryAllocatorTest, givenMultipleSVMAllocsWhenInteriorPointersAreQueriedThenOwningAllocationIsReturned) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr1 = (char *)svmM.createSVMAlloc(4096);
+        char *ptr2 = (char *)svmM.createSVMAlloc(8192);
+        ASSERT_NE(nullptr, ptr1);
+        ASSERT_NE(nullptr, ptr2);
+
+        auto ga1 = svmM.getSVMAlloc(ptr1);
+        auto ga2 = svmM.getSVMAlloc(ptr2);
+        EXPECT_NE(ga1, ga2);
+        EXPECT_EQ(ga1, svmM.getSVMAlloc(ptr1 + 4095));
+        EXPECT_EQ(ga2, svmM.getSVMAlloc(ptr2 + 4096));
+        EXPECT_EQ(ga2, svmM.getSVMAlloc(ptr2 + 8191));
+
+        svmM.freeSVMAlloc(ptr1);
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr1 + 100));
+        EXPECT_EQ(ga2, svmM.getSVMAlloc(ptr2 + 100));
+
+        svmM.freeSVMAlloc(ptr2);
+        EXPECT_EQ(0u, svmM.getNumAllocs());
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolDisabledWhenSmallSVMAllocsAreCreatedThenEachHasSeparateAllocation) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(false);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        void *ptr1 = svmM.createSVMAlloc(64);
+        void *ptr2 = svmM.createSVMAlloc(64);
+
+        EXPECT_NE(svmM.getSVMAlloc(ptr1), svmM.getSVMAlloc(ptr2));
+        EXPECT_EQ(0u, svmM.getNumPools());
+
+        svmM.freeSVMAlloc(ptr1);
+        svmM.freeSVMAlloc(ptr2);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolEnabledWhenSmallSVMAllocsAreCreatedThenTheyShareOnePoolAllocation) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr1 = (char *)svmM.createSVMAlloc(64);
+        char *ptr2 = (char *)svmM.createSVMAlloc(100, true);
+        char *ptr3 = (char *)svmM.createSVMAlloc(SVMAllocsManager::svmPoolAllocationThreshold);
+        ASSERT_NE(nullptr, ptr1);
+        ASSERT_NE(nullptr, ptr2);
+        ASSERT_NE(nullptr, ptr3);
+        EXPECT_NE(ptr1, ptr3);
+
+        auto ga1 = svmM.getSVMAlloc(ptr1);
+        auto ga2 = svmM.getSVMAlloc(ptr2);
+        auto ga3 = svmM.getSVMAlloc(ptr3);
+        EXPECT_EQ(ga1, ga3);
+        EXPECT_NE(ga1, ga2);
+        EXPECT_FALSE(ga1->isCoherent());
+        EXPECT_TRUE(ga2->isCoherent());
+        EXPECT_EQ(SVMAllocsManager::svmPoolSize, ga1->getUnderlyingBufferSize());
+        EXPECT_EQ(2u, svmM.getNumPools());
+        EXPECT_EQ(3u, svmM.getNumAllocs());
+
+        EXPECT_EQ(ga1, svmM.getSVMAlloc(ptr1 + 63));
+
+        svmM.freeSVMAlloc(ptr1);
+        EXPECT_EQ(nullptr, svmM.getSVMAlloc(ptr1));
+        EXPECT_EQ(ga3, svmM.getSVMAlloc(ptr3));
+        EXPECT_EQ(2u, svmM.getNumPools());
+
+        svmM.freeSVMAlloc(ptr3);
+        svmM.freeSVMAlloc(ptr2);
+        EXPECT_EQ(2u, svmM.getNumPools());
+        EXPECT_EQ(0u, svmM.getNumAllocs());
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolEnabledWhenPoolsBecomeEmptyThenOnlyOneEmptyPoolIsKept) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        std::vector<void *> ptrs;
+        while (svmM.getNumPools() < 2) {
+            ptrs.push_back(svmM.createSVMAlloc(SVMAllocsManager::svmPoolAllocationThreshold));
+            ASSERT_NE(nullptr, ptrs.back());
+        }
+
+        for (auto ptr : ptrs) {
+            svmM.freeSVMAlloc(ptr);
+        }
+        EXPECT_EQ(1u, svmM.getNumPools());
+
+        auto ptr = svmM.createSVMAlloc(64);
+        EXPECT_EQ(1u, svmM.getNumPools());
+        svmM.freeSVMAlloc(ptr);
+        EXPECT_EQ(1u, svmM.getNumPools());
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolEnabledWhenRangeIsQueriedThenSuballocationBaseAndSizeAreReturned) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *ptr1 = (char *)svmM.createSVMAlloc(64);
+        char *ptr2 = (char *)svmM.createSVMAlloc(64);
+        ASSERT_NE(nullptr, ptr1);
+        ASSERT_NE(nullptr, ptr2);
+
+        SVMAllocsManager::MapBasedAllocationTracker::AllocationRange range = {};
+        EXPECT_TRUE(svmM.getSVMAllocRange(ptr2 + 32, range));
+        EXPECT_EQ(ptr2, range.basePtr);
+        EXPECT_EQ(MemoryConstants::pageSize, range.size);
+        EXPECT_EQ(svmM.getSVMAlloc(ptr1), range.allocation);
+        EXPECT_NE(range.allocation->getUnderlyingBuffer(), range.basePtr);
+
+        svmM.freeSVMAlloc(ptr2);
+        EXPECT_FALSE(svmM.getSVMAllocRange(ptr2, range));
+        svmM.freeSVMAlloc(ptr1);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolEnabledWhenAllocationIsAboveThresholdThenItIsNotPooled) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        auto size = SVMAllocsManager::svmPoolAllocationThreshold + 1;
+        void *ptr = svmM.createSVMAlloc(size);
+        ASSERT_NE(nullptr, ptr);
+
+        auto ga = svmM.getSVMAlloc(ptr);
+        EXPECT_EQ(ptr, ga->getUnderlyingBuffer());
+        EXPECT_EQ(0u, svmM.getNumPools());
+
+        svmM.freeSVMAlloc(ptr);
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenSvmAllocationPoolEnabledWhenManagerIsDestroyedWithLiveSmallAllocsThenPoolsAreReleased) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableSvmAllocationPool.set(true);
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        EXPECT_NE(nullptr, svmM.createSVMAlloc(64));
+        EXPECT_EQ(1u, svmM.getNumPools());
+    }
+}
+
+TEST_F(SVMMemoryAllocatorTest, givenConcurrentLookupsWhenAllocationsAreCreatedAndFreedThenLookupsStayConsistent) {
+    OsAgnosticMemoryManager umm;
+    {
+        SVMAllocsManager svmM(&umm);
+        char *persistentPtr = (char *)svmM.createSVMAlloc(4096);
+        auto persistentAlloc = svmM.getSVMAlloc(persistentPtr);
+        std::atomic<bool> done(false);
+
+        auto reader = std::async(std::launch::async, [&]() {
+            while (!done) {
+                EXPECT_EQ(persistentAlloc, svmM.getSVMAlloc(persistentPtr + 128));
+            }
+        });
+
+        for (int i = 0; i < 100; i++) {
+            auto ptr = svmM.createSVMAlloc(4096);
+            svmM.freeSVMAlloc(ptr);
+        }
+        done = true;
+        reader.get();
+
+        svmM.freeSVMAlloc(persistentPtr);
+    }
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
+#include "runtime/memory_manager/zeroed_allocation_pool.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+using namespace OCLRT;
+
+namespace {
+bool isZeroed(GraphicsAllocation *allocation) {
+    auto bytes = reinterpret_cast<const uint8_t *>(allocation->getUnderlyingBuffer());
+    for (size_t i = 0; i < allocation->getUnderlyingBufferSize(); i++) {
+        if (bytes[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class ThreadRecordingMemoryManager : public OsAgnosticMemoryManager {
+  public:
+    using OsAgnosticMemoryManager::allocateGraphicsMemory;
+    GraphicsAllocation *allocateGraphicsMemory(size_t size, size_t alignment, bool forcePin, bool uncacheable) override {
+        if (std::this_thread::get_id() == callingThread) {
+            allocationsOnCallingThread++;
+        }
+        return OsAgnosticMemoryManager::allocateGraphicsMemory(size, alignment, forcePin, uncacheable);
+    }
+    std::thread::id callingThread = std::this_thread::get_id();
+    std::atomic<int> allocationsOnCallingThread{0};
+};
+} // namespace
+
+TEST(ZeroedAllocationPoolTest, givenDisabledPoolWhenZeroedAllocationIsRequestedThenItIsZeroedSynchronously) {
+    OsAgnosticMemoryManager memoryManager;
+    auto &pool = memoryManager.getZeroedAllocationPool();
+    EXPECT_EQ(0u, pool.getAllocationsPerSize());
+
+    auto allocation = memoryManager.allocateZeroedGraphicsMemory(MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_TRUE(isZeroed(allocation));
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(MemoryConstants::pageSize, stats.bytesZeroedSynchronously);
+    EXPECT_EQ(0u, stats.bytesZeroedAsynchronously);
+    EXPECT_EQ(0u, stats.poolHits);
+    EXPECT_EQ(0u, stats.poolMisses);
+    EXPECT_EQ(0u, pool.peekPooledAllocationsCount(MemoryConstants::pageSize));
+
+    memoryManager.freeGraphicsMemory(allocation);
+}
+
+TEST(ZeroedAllocationPoolTest, givenEnabledPoolWhenSizeIsRequestedFirstTimeThenPoolIsRefilledInBackgroundAndNextRequestIsServedFromPool) {
+    OsAgnosticMemoryManager memoryManager;
+    auto &pool = memoryManager.getZeroedAllocationPool();
+    pool.setAllocationsPerSize(2);
+    auto size = 2 * MemoryConstants::pageSize;
+
+    auto allocation = memoryManager.allocateZeroedGraphicsMemory(size);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_TRUE(isZeroed(allocation));
+    pool.drain();
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(1u, stats.poolMisses);
+    EXPECT_EQ(size, stats.bytesZeroedSynchronously);
+    EXPECT_EQ(2 * size, stats.bytesZeroedAsynchronously);
+    EXPECT_EQ(2u, pool.peekPooledAllocationsCount(size));
+
+    auto pooledAllocation = memoryManager.allocateZeroedGraphicsMemory(size);
+    ASSERT_NE(nullptr, pooledAllocation);
+    EXPECT_TRUE(isZeroed(pooledAllocation));
+    pool.drain();
+
+    stats = pool.getStats();
+    EXPECT_EQ(1u, stats.poolHits);
+    EXPECT_EQ(size, stats.bytesZeroedSynchronously);
+    EXPECT_EQ(3 * size, stats.bytesZeroedAsynchronously);
+    EXPECT_EQ(2u, pool.peekPooledAllocationsCount(size));
+
+    memoryManager.freeGraphicsMemory(pooledAllocation);
+    memoryManager.freeGraphicsMemory(allocation);
+}
+
+TEST(ZeroedAllocationPoolTest, givenPooledAllocationsWhenMemoryManagerIsDestroyedThenTheyAreReleased) {
+    auto memoryManager = new OsAgnosticMemoryManager;
+    auto &pool = memoryManager->getZeroedAllocationPool();
+    pool.setAllocationsPerSize(4);
+
+    auto allocation = memoryManager->allocateZeroedGraphicsMemory(MemoryConstants::pageSize);
+    memoryManager->freeGraphicsMemory(allocation);
+
+    // pooled and still pending allocations are freed in applyCommonCleanup
+    delete memoryManager;
+}
+
+TEST(ZeroedAllocationPoolTest, givenPoolSizeDebugVariableWhenMemoryManagerIsCreatedThenPoolIsEnabled) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ZeroedAllocationPoolSize.set(3);
+    OsAgnosticMemoryManager memoryManager;
+    EXPECT_EQ(3u, memoryManager.getZeroedAllocationPool().getAllocationsPerSize());
+}
+
+TEST(ZeroedAllocationPoolTest, givenEnabledPoolWhenRefillIsNeededThenPooledAllocationsAreCreatedOffTheCallingThread) {
+    ThreadRecordingMemoryManager memoryManager;
+    auto &pool = memoryManager.getZeroedAllocationPool();
+    pool.setAllocationsPerSize(3);
+
+    auto allocation = memoryManager.allocateZeroedGraphicsMemory(MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    pool.drain();
+
+    EXPECT_EQ(1, memoryManager.allocationsOnCallingThread.load());
+    EXPECT_EQ(3u, pool.peekPooledAllocationsCount(MemoryConstants::pageSize));
+    memoryManager.freeGraphicsMemory(allocation);
+}
+
+TEST(ZeroedAllocationPoolTest, givenSizeAboveMaxPooledSizeWhenZeroedAllocationIsRequestedThenItIsNotPooled) {
+    OsAgnosticMemoryManager memoryManager;
+    auto &pool = memoryManager.getZeroedAllocationPool();
+    pool.setAllocationsPerSize(1);
+    auto size = ZeroedAllocationPool::maxPooledAllocationSize + MemoryConstants::pageSize;
+
+    auto allocation = memoryManager.allocateZeroedGraphicsMemory(size);
+    ASSERT_NE(nullptr, allocation);
+    pool.drain();
+
+    auto stats = pool.getStats();
+    EXPECT_EQ(0u, stats.poolMisses);
+    EXPECT_EQ(0u, stats.bytesZeroedAsynchronously);
+    EXPECT_EQ(0u, pool.peekPooledAllocationsCount(size));
+    memoryManager.freeGraphicsMemory(allocation);
+}
+
+TEST(ZeroedAllocationPoolTest, givenMaxPooledSizesWhenNewSizeIsRequestedThenItIsNotPooled) {
+    OsAgnosticMemoryManager memoryManager;
+    auto &pool = memoryManager.getZeroedAllocationPool();
+    pool.setAllocationsPerSize(1);
+
+    for (size_t i = 1; i <= ZeroedAllocationPool::maxPooledSizesCount + 1; i++) {
+        auto allocation = memoryManager.allocateZeroedGraphicsMemory(i * MemoryConstants::pageSize);
+        ASSERT_NE(nullptr, allocation);
+        memoryManager.freeGraphicsMemory(allocation);
+    }
+    pool.drain();
+
+    EXPECT_EQ(ZeroedAllocationPool::maxPooledSizesCount, pool.getStats().poolMisses);
+    EXPECT_EQ(1u, pool.peekPooledAllocationsCount(ZeroedAllocationPool::maxPooledSizesCount * MemoryConstants::pageSize));
+    EXPECT_EQ(0u, pool.peekPooledAllocationsCount((ZeroedAllocationPool::maxPooledSizesCount + 1) * MemoryConstants::pageSize));
+}
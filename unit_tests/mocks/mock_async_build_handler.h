@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "runtime/program/async_build_handler.h"
+
+using namespace OCLRT;
+
+class MockAsyncBuildHandler : public AsyncBuildHandler {
+  public:
+    using AsyncBuildHandler::maxThreads;
+    using AsyncBuildHandler::taskQueue;
+    using AsyncBuildHandler::threads;
+
+    MockAsyncBuildHandler(bool allowThreadCreating = false) : allowThreadCreating(allowThreadCreating) {}
+
+    ~MockAsyncBuildHandler() override {
+        if (!allowThreadCreating) {
+            runPendingTasks(); // queued builds still own program references
+        }
+    }
+
+    void openThread() override {
+        openThreadCalled++;
+        if (allowThreadCreating) {
+            AsyncBuildHandler::openThread();
+        }
+    }
+
+    size_t runPendingTasks() {
+        size_t tasksRun = 0;
+        while (!taskQueue.empty()) {
+            auto task = std::move(taskQueue.front());
+            taskQueue.pop_front();
+            task();
+            tasksRun++;
+        }
+        return tasksRun;
+    }
+
+    uint32_t openThreadCalled = 0;
+    bool allowThreadCreating = false;
+};
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -239,6 +239,12 @@ class MockCompilerInterface : public CompilerInterface {
         return CompilerInterface::initialize();
     }
 
+    ConcurrencyLimiter &getTranslationLimiter() {
+        return this->translationLimiter;
+    }
+
+    using CompilerInterface::getTranslationConcurrencyLimit;
+
     CIF::CIFMain *GetIgcMain() {
         return this->igcMain.get();
     }
@@ -35,7 +35,9 @@ class GraphicsAllocation;
 ////////////////////////////////////////////////////////////////////////////////
 class MockProgram : public Program {
   public:
+    using Program::genBinaryStorage;
     using Program::isKernelDebugEnabled;
+    using Program::processBuild;
 
     MockProgram() : Program() {}
     MockProgram(Context *context, bool isBuiltinKernel) : Program(context, isBuiltinKernel) {}
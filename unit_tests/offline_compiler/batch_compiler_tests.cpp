@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "environment.h"
+#include "mock/mock_batch_compiler.h"
+#include "runtime/helpers/file_io.h"
+#include "gtest/gtest.h"
+#include <CL/cl.h>
+#include <cstdio>
+#include <memory>
+
+#define ARRAY_COUNT(x) (sizeof(x) / sizeof(x[0]))
+
+extern Environment *gEnvironment;
+
+namespace OCLRT {
+
+TEST(BatchCompilerTest, givenBatchArgumentWhenCheckingCommandLineThenBatchModeIsDetected) {
+    const char *batchArgv[] = {"cloc", "-q", "-batch", "manifest.txt"};
+    const char *singleArgv[] = {"cloc", "-file", "test_files/copybuffer.cl", "-device", "skl"};
+
+    EXPECT_TRUE(BatchCompiler::isBatchCommandLine(ARRAY_COUNT(batchArgv), batchArgv));
+    EXPECT_FALSE(BatchCompiler::isBatchCommandLine(ARRAY_COUNT(singleArgv), singleArgv));
+}
+
+TEST(BatchCompilerTest, givenManifestWithCommentsAndOptionsWhenParsedThenJobsAreCreatedInOrder) {
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    std::string manifest = "# device file options\n"
+                           "\n"
+                           "skl test_files/copybuffer.cl\r\n"
+                           "  bxt   test_files/simple_kernels.cl  -cl-opt-disable -DX=1  \n";
+
+    EXPECT_EQ(CL_SUCCESS, mockBatchCompiler->parseManifest(manifest));
+
+    auto &jobs = mockBatchCompiler->getJobs();
+    ASSERT_EQ(2u, jobs.size());
+    EXPECT_EQ(2u, mockBatchCompiler->getResults().size());
+
+    EXPECT_STREQ("skl", jobs[0].deviceName.c_str());
+    EXPECT_STREQ("test_files/copybuffer.cl", jobs[0].inputFile.c_str());
+    EXPECT_STREQ("", jobs[0].options.c_str());
+    EXPECT_EQ(3u, jobs[0].manifestLine);
+
+    EXPECT_STREQ("bxt", jobs[1].deviceName.c_str());
+    EXPECT_STREQ("test_files/simple_kernels.cl", jobs[1].inputFile.c_str());
+    EXPECT_STREQ("-cl-opt-disable -DX=1", jobs[1].options.c_str());
+    EXPECT_EQ(4u, jobs[1].manifestLine);
+}
+
+TEST(BatchCompilerTest, givenManifestLineWithoutInputFileWhenParsedThenErrorIsReturned) {
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, mockBatchCompiler->parseManifest("skl test_files/copybuffer.cl\nskl\n"));
+    EXPECT_EQ(INVALID_FILE, mockBatchCompiler->parseManifest("# nothing to do\n"));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_STRNE("", output.c_str());
+}
+
+TEST(BatchCompilerTest, givenManifestJobsWritingTheSameOutputWhenParsedThenErrorIsReturnedUnlessOptionsNameSeparatesThem) {
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    std::string manifest = "skl test_files/copybuffer.cl -DX=1\n"
+                           "skl test_files/copybuffer.cl -DX=2\n"
+                           "bxt test_files/copybuffer.cl -DX=1\n";
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, mockBatchCompiler->parseManifest(manifest));
+    EXPECT_EQ(INVALID_FILE, mockBatchCompiler->parseManifest("skl test_files/copybuffer.cl\nskl other_dir/copybuffer.cl\n"));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(std::string::npos, output.find("lines 1 and 2"));
+
+    mockBatchCompiler->useOptionsSuffix = true;
+    EXPECT_EQ(CL_SUCCESS, mockBatchCompiler->parseManifest(manifest));
+    EXPECT_EQ(3u, mockBatchCompiler->getJobs().size());
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, mockBatchCompiler->parseManifest("skl test_files/copybuffer.cl -DX=1\nskl test_files/copybuffer.cl -DX=1\n"));
+    testing::internal::GetCapturedStdout();
+}
+
+TEST(BatchCompilerTest, givenPerJobArgumentsOnCommandLineWhenParsedThenErrorIsReturned) {
+    const char *argv[] = {"cloc", "-batch", "test_files/copybuffer.cl", "-device", "skl"};
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_COMMAND_LINE, mockBatchCompiler->parseCommandLine(ARRAY_COUNT(argv), argv));
+    testing::internal::GetCapturedStdout();
+}
+
+TEST(BatchCompilerTest, givenCommonArgumentsWhenParsedThenTheyAreForwardedToEveryJob) {
+    const char *argv[] = {"cloc", "-batch", "test_files/copybuffer.cl", "-threads", "3", "-64", "-out_dir", "offline_compiler_test"};
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+
+    EXPECT_EQ(CL_SUCCESS, mockBatchCompiler->parseCommandLine(ARRAY_COUNT(argv), argv));
+    EXPECT_EQ(3u, mockBatchCompiler->numThreads);
+    ASSERT_EQ(3u, mockBatchCompiler->commonArgs.size());
+    EXPECT_STREQ("-64", mockBatchCompiler->commonArgs[0].c_str());
+    EXPECT_STREQ("-out_dir", mockBatchCompiler->commonArgs[1].c_str());
+    EXPECT_STREQ("offline_compiler_test", mockBatchCompiler->commonArgs[2].c_str());
+    EXPECT_STREQ("offline_compiler_test/batch_summary.txt", mockBatchCompiler->summaryFile.c_str());
+}
+
+TEST(BatchCompilerTest, givenMissingManifestWhenCreatingThenNullptrIsReturned) {
+    const char *argv[] = {"cloc", "-batch", "test_files/no_such_manifest.txt"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    auto pBatchCompiler = BatchCompiler::create(ARRAY_COUNT(argv), argv, retVal);
+    testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(nullptr, pBatchCompiler);
+    EXPECT_EQ(INVALID_FILE, retVal);
+}
+
+TEST(BatchCompilerTest, givenFailingJobWhenBatchIsBuiltThenRemainingJobsAreCompiledAndSummaryIsWritten) {
+    std::string manifestFile = "batch_compiler_test_manifest.txt";
+    std::string summaryFile = "batch_compiler_test_summary.txt";
+    std::string manifest = gEnvironment->devicePrefix + " test_files/no_such_file.cl\n" +
+                           gEnvironment->devicePrefix + " test_files/copybuffer.cl\n";
+    writeDataToFile(manifestFile.c_str(), manifest.c_str(), manifest.size());
+
+    const char *argv[] = {
+        "cloc",
+        "-batch",
+        manifestFile.c_str(),
+        "-threads",
+        "2",
+        "-summary",
+        summaryFile.c_str(),
+        "-out_dir",
+        "offline_compiler_test",
+        "-q"};
+
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    int retVal = mockBatchCompiler->initialize(ARRAY_COUNT(argv), argv);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, mockBatchCompiler->libraries);
+
+    testing::internal::CaptureStdout();
+    retVal = mockBatchCompiler->build();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(CL_BUILD_PROGRAM_FAILURE, retVal);
+
+    auto &results = mockBatchCompiler->getResults();
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(INVALID_FILE, results[0].retVal);
+    EXPECT_EQ(CL_SUCCESS, results[1].retVal);
+    EXPECT_LE(0.0, results[1].buildTimeMs);
+
+    std::string outputBase = "offline_compiler_test/copybuffer_" + gEnvironment->devicePrefix;
+    EXPECT_TRUE(fileExists(outputBase + ".bin"));
+    EXPECT_TRUE(fileExists(outputBase + ".gen"));
+
+    void *pSummary = nullptr;
+    size_t summarySize = loadDataFromFile(summaryFile.c_str(), pSummary);
+    ASSERT_NE(0u, summarySize);
+    std::string summary(static_cast<char *>(pSummary), summarySize);
+    deleteDataReadFromFile(pSummary);
+    EXPECT_NE(std::string::npos, summary.find("no_such_file.cl\tfailed"));
+    EXPECT_NE(std::string::npos, summary.find("copybuffer.cl\tok"));
+    EXPECT_NE(std::string::npos, summary.find("# jobs: 2, failed: 1"));
+
+    std::remove(manifestFile.c_str());
+    std::remove(summaryFile.c_str());
+}
+
+TEST(BatchCompilerTest, givenSummaryInMissingDirectoryWhenBatchIsBuiltThenDirectoryIsCreatedAndSummaryIsWritten) {
+    std::string manifestFile = "batch_compiler_test_manifest_summary_dir.txt";
+    std::string summaryFile = "offline_compiler_test/batch_summary_dir/summary.txt";
+    std::string manifest = gEnvironment->devicePrefix + " test_files/no_such_file.cl\n";
+    writeDataToFile(manifestFile.c_str(), manifest.c_str(), manifest.size());
+
+    const char *argv[] = {
+        "cloc",
+        "-batch",
+        manifestFile.c_str(),
+        "-summary",
+        summaryFile.c_str(),
+        "-q"};
+
+    auto mockBatchCompiler = std::unique_ptr<MockBatchCompiler>(new MockBatchCompiler());
+    int retVal = mockBatchCompiler->initialize(ARRAY_COUNT(argv), argv);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    testing::internal::CaptureStdout();
+    retVal = mockBatchCompiler->build();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(CL_BUILD_PROGRAM_FAILURE, retVal);
+    EXPECT_TRUE(fileExists(summaryFile));
+
+    std::remove(summaryFile.c_str());
+    std::remove(manifestFile.c_str());
+}
+} // namespace OCLRT
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "environment.h"
+#include "offline_compiler/cache_verifier.h"
+#include "offline_compiler/offline_compiler.h"
+#include "runtime/compiler_interface/binary_cache.h"
+#include "runtime/helpers/file_io.h"
+#include "patch_shared.h"
+#include "gtest/gtest.h"
+#include <CL/cl.h>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#define ARRAY_COUNT(x) (sizeof(x) / sizeof(x[0]))
+
+extern Environment *gEnvironment;
+
+namespace OCLRT {
+
+class CacheVerifierTests : public ::testing::Test {
+  public:
+    void SetUp() override {
+        createDirectoryTree(cacheDirectory);
+
+        iOpenCL::SProgramBinaryHeader programHeader = {};
+        programHeader.Magic = iOpenCL::MAGIC_CL;
+        programHeader.Version = iOpenCL::CURRENT_ICBE_VERSION;
+        std::vector<char> binary(reinterpret_cast<char *>(&programHeader), reinterpret_cast<char *>(&programHeader) + sizeof(programHeader));
+        auto file = BinaryCache::createCacheFile(binary.data(), binary.size());
+
+        auto keyPrefix = "v" + std::to_string(BinaryCache::cacheKeyVersion) + "-";
+        validEntry = BinaryCache::getCacheFilePath(cacheDirectory, keyPrefix + "0000000000000001");
+        corruptedEntry = BinaryCache::getCacheFilePath(cacheDirectory, keyPrefix + "0000000000000002");
+        staleEntry = BinaryCache::getCacheFilePath(cacheDirectory, "0123456789abcdef0123456789abcdef");
+
+        writeDataToFile(validEntry.c_str(), file.data(), file.size());
+        writeDataToFile(staleEntry.c_str(), file.data(), file.size());
+        file.back() ^= 0x1;
+        writeDataToFile(corruptedEntry.c_str(), file.data(), file.size());
+    }
+
+    void TearDown() override {
+        std::remove(validEntry.c_str());
+        std::remove(corruptedEntry.c_str());
+        std::remove(staleEntry.c_str());
+    }
+
+    const std::string cacheDirectory = "offline_compiler_test/verified_cache";
+    std::string validEntry;
+    std::string corruptedEntry;
+    std::string staleEntry;
+};
+
+TEST_F(CacheVerifierTests, givenVerifyArgumentWhenCheckingCommandLineThenVerifyModeIsDetected) {
+    const char *verifyArgv[] = {"cloc", "-verify_cache", "cl_cache"};
+    const char *buildArgv[] = {"cloc", "-file", "test_files/copybuffer.cl", "-cache_dir", "cl_cache"};
+
+    EXPECT_TRUE(CacheVerifier::isVerifyCommandLine(ARRAY_COUNT(verifyArgv), verifyArgv));
+    EXPECT_FALSE(CacheVerifier::isVerifyCommandLine(ARRAY_COUNT(buildArgv), buildArgv));
+}
+
+TEST_F(CacheVerifierTests, givenInvalidArgumentsWhenCreatingThenNullptrIsReturned) {
+    const char *missingDirArgv[] = {"cloc", "-verify_cache"};
+    const char *invalidDeviceArgv[] = {"cloc", "-verify_cache", "cl_cache", "-device", "invalid_device"};
+    int retVal = CL_SUCCESS;
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(nullptr, CacheVerifier::create(ARRAY_COUNT(missingDirArgv), missingDirArgv, retVal));
+    EXPECT_EQ(INVALID_COMMAND_LINE, retVal);
+    EXPECT_EQ(nullptr, CacheVerifier::create(ARRAY_COUNT(invalidDeviceArgv), invalidDeviceArgv, retVal));
+    EXPECT_EQ(CL_INVALID_DEVICE, retVal);
+    testing::internal::GetCapturedStdout();
+}
+
+TEST_F(CacheVerifierTests, givenCacheWithInvalidEntriesWhenVerifiedThenTheyAreReportedAndKept) {
+    const char *argv[] = {"cloc", "-verify_cache", cacheDirectory.c_str()};
+    int retVal = CL_SUCCESS;
+    auto pCacheVerifier = std::unique_ptr<CacheVerifier>(CacheVerifier::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pCacheVerifier);
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_FILE, pCacheVerifier->verify());
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(1u, pCacheVerifier->getNumEntries(CacheFileStatus::Valid));
+    EXPECT_EQ(1u, pCacheVerifier->getNumEntries(CacheFileStatus::StaleKey));
+    EXPECT_EQ(1u, pCacheVerifier->getNumEntries(CacheFileStatus::Corrupted));
+    EXPECT_NE(std::string::npos, output.find(corruptedEntry + ": corrupted"));
+    EXPECT_NE(std::string::npos, output.find(staleEntry + ": stale key"));
+    EXPECT_TRUE(fileExists(corruptedEntry));
+    EXPECT_TRUE(fileExists(staleEntry));
+}
+
+TEST_F(CacheVerifierTests, givenPruneOptionWhenCacheIsVerifiedThenOnlyInvalidEntriesAreRemoved) {
+    const char *argv[] = {"cloc", "-verify_cache", cacheDirectory.c_str(), "-prune", "-q"};
+    int retVal = CL_SUCCESS;
+    auto pCacheVerifier = std::unique_ptr<CacheVerifier>(CacheVerifier::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pCacheVerifier);
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(CL_SUCCESS, pCacheVerifier->verify());
+    testing::internal::GetCapturedStdout();
+
+    EXPECT_TRUE(fileExists(validEntry));
+    EXPECT_FALSE(fileExists(corruptedEntry));
+    EXPECT_FALSE(fileExists(staleEntry));
+}
+
+TEST_F(CacheVerifierTests, givenDeviceAndPruneOptionsWhenCacheHoldsEntriesOfOtherDeviceThenTheyAreReportedAndKept) {
+    // entries written by the fixture carry no device in their header
+    const char *argv[] = {"cloc", "-verify_cache", cacheDirectory.c_str(), "-device", gEnvironment->devicePrefix.c_str(), "-prune"};
+    int retVal = CL_SUCCESS;
+    auto pCacheVerifier = std::unique_ptr<CacheVerifier>(CacheVerifier::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pCacheVerifier);
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(CL_SUCCESS, pCacheVerifier->verify());
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(0u, pCacheVerifier->getNumEntries(CacheFileStatus::Valid));
+    EXPECT_EQ(1u, pCacheVerifier->getNumEntries(CacheFileStatus::OtherDevice));
+    EXPECT_EQ(0u, pCacheVerifier->getNumEntries(CacheFileStatus::Unloadable));
+    EXPECT_NE(std::string::npos, output.find(validEntry + ": other device\n"));
+    EXPECT_TRUE(fileExists(validEntry));
+    EXPECT_FALSE(fileExists(corruptedEntry));
+    EXPECT_FALSE(fileExists(staleEntry));
+}
+} // namespace OCLRT
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "offline_compiler/batch_compiler.h"
+#include <string>
+
+namespace OCLRT {
+
+class MockBatchCompiler : public BatchCompiler {
+  public:
+    using BatchCompiler::commonArgs;
+    using BatchCompiler::libraries;
+    using BatchCompiler::numThreads;
+    using BatchCompiler::summaryFile;
+    using BatchCompiler::useOptionsSuffix;
+
+    MockBatchCompiler() : BatchCompiler() {
+    }
+
+    int initialize(uint32_t numArgs, const char **argv) {
+        return BatchCompiler::initialize(numArgs, argv);
+    }
+
+    int parseCommandLine(uint32_t numArgs, const char **argv) {
+        return BatchCompiler::parseCommandLine(numArgs, argv);
+    }
+
+    int parseManifest(const std::string &manifest) {
+        return BatchCompiler::parseManifest(manifest);
+    }
+};
+} // namespace OCLRT
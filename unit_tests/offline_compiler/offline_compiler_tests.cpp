@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -25,9 +25,11 @@
 #include "mock/mock_offline_compiler.h"
 #include "offline_compiler_tests.h"
 #include "runtime/helpers/hw_info.h"
+#include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/helpers/options.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/directory.h"
 #include "gmock/gmock.h"
 
 #include <algorithm>
@@ -631,4 +633,99 @@ TEST(OfflineCompilerTest, givenInternalOptionsWhenCmdLineParsedThenOptionsAreApp
     EXPECT_THAT(internalOptions, ::testing::HasSubstr(std::string("myInternalOptions")));
 }
 
+TEST(OfflineCompilerTest, givenCacheDirOptionWhenCmdLineParsedThenInternalOptionsMatchTheRuntimeOnes) {
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-cache_dir",
+        "offline_compiler_test/cl_cache",
+        "-64",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    EXPECT_EQ(CL_SUCCESS, mockOfflineCompiler->parseCommandLine(ARRAY_COUNT(argv), argv));
+    EXPECT_STREQ("offline_compiler_test/cl_cache", mockOfflineCompiler->cacheDirectory.c_str());
+
+    std::string internalOptions = mockOfflineCompiler->getInternalOptions();
+    EXPECT_EQ(0u, internalOptions.find("-ocl-version="));
+    EXPECT_THAT(internalOptions, ::testing::HasSubstr(std::string("-fpreserve-vec3-type -cl-ext=-all,+")));
+    EXPECT_EQ(std::string::npos, internalOptions.find("-m64"));
+}
+
+TEST(OfflineCompilerTest, givenSharingExtensionsOptionWhenCmdLineParsedThenTheyAreEnabledAfterTheDeviceOnes) {
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-cache_dir",
+        "offline_compiler_test/cl_cache",
+        "-sharing_extensions",
+        "cl_intel_va_api_media_sharing",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    EXPECT_EQ(CL_SUCCESS, mockOfflineCompiler->parseCommandLine(ARRAY_COUNT(argv), argv));
+
+    std::string internalOptions = mockOfflineCompiler->getInternalOptions();
+    auto expectedSuffix = std::string(",+cl_intel_va_api_media_sharing");
+    ASSERT_LT(expectedSuffix.size(), internalOptions.size());
+    EXPECT_EQ(expectedSuffix, internalOptions.substr(internalOptions.size() - expectedSuffix.size()));
+}
+
+TEST(OfflineCompilerTest, givenCacheDirAndLlvmTextOptionsWhenCmdLineParsedThenErrorIsReturned) {
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-cache_dir",
+        "offline_compiler_test/cl_cache",
+        "-llvm_text",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    auto mockOfflineCompiler = std::unique_ptr<MockOfflineCompiler>(new MockOfflineCompiler());
+    ASSERT_NE(nullptr, mockOfflineCompiler);
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(INVALID_COMMAND_LINE, mockOfflineCompiler->parseCommandLine(ARRAY_COUNT(argv), argv));
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(0u, output.size());
+}
+
+TEST(OfflineCompilerTest, givenCacheDirOptionWhenSourceIsBuiltThenBinaryCacheEntryIsWritten) {
+    const char *argv[] = {
+        "cloc",
+        "-file",
+        "test_files/copybuffer.cl",
+        "-cache_dir",
+        "offline_compiler_test/cl_cache",
+        "-q",
+        "-device",
+        gEnvironment->devicePrefix.c_str()};
+
+    int retVal = CL_SUCCESS;
+    auto pOfflineCompiler = std::unique_ptr<OfflineCompiler>(OfflineCompiler::create(ARRAY_COUNT(argv), argv, retVal));
+    ASSERT_NE(nullptr, pOfflineCompiler);
+
+    EXPECT_EQ(CL_SUCCESS, pOfflineCompiler->build());
+
+    std::vector<std::string> cacheEntries;
+    for (auto &file : Directory::getFiles("offline_compiler_test/cl_cache")) {
+        if (file.find(".cl_cache") != std::string::npos) {
+            cacheEntries.push_back(file);
+        }
+    }
+    ASSERT_EQ(1u, cacheEntries.size());
+    EXPECT_NE(CacheFileStatus::StaleKey, BinaryCache::verifyCacheFile(cacheEntries[0]));
+    EXPECT_NE(CacheFileStatus::Corrupted, BinaryCache::verifyCacheFile(cacheEntries[0]));
+
+    std::remove(cacheEntries[0].c_str());
+}
 } // namespace OCLRT
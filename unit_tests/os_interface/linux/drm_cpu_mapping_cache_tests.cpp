@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/drm_cpu_mapping_cache.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+std::vector<void *> unmappedAddresses;
+
+int munmapRecording(void *addr, size_t length) noexcept {
+    unmappedAddresses.push_back(addr);
+    return 0;
+}
+
+BufferObject *fakeBo(uintptr_t value) {
+    return reinterpret_cast<BufferObject *>(value);
+}
+
+DrmCpuMappingCache::Mapping fakeMapping(uintptr_t address, size_t size) {
+    DrmCpuMappingCache::Mapping mapping;
+    mapping.cpuAddress = reinterpret_cast<void *>(address);
+    mapping.size = size;
+    return mapping;
+}
+} // namespace
+
+struct DrmCpuMappingCacheTest : public ::testing::Test {
+    void SetUp() override {
+        unmappedAddresses.clear();
+    }
+    DrmCpuMappingCache::MunmapFunction munmapFunction = munmapRecording;
+};
+
+TEST_F(DrmCpuMappingCacheTest, givenReleasedMappingWhenBoIsAcquiredAgainThenSameMappingIsReturnedWithoutUnmapping) {
+    DrmCpuMappingCache cache(0x10000, munmapFunction);
+    DrmCpuMappingCache::Mapping mapping = fakeMapping(0x1000, 0x1000);
+    mapping.domainSet = true;
+
+    EXPECT_FALSE(cache.acquire(fakeBo(1), mapping));
+    cache.markLocked(fakeBo(1), mapping);
+    EXPECT_TRUE(cache.release(fakeBo(1), 5u));
+    EXPECT_EQ(1u, cache.peekCachedMappingsCount());
+
+    DrmCpuMappingCache::Mapping cached;
+    EXPECT_TRUE(cache.acquire(fakeBo(1), cached));
+    EXPECT_EQ(mapping.cpuAddress, cached.cpuAddress);
+    EXPECT_EQ(5u, cached.domainTaskCount);
+    EXPECT_TRUE(cached.domainSet);
+    EXPECT_TRUE(unmappedAddresses.empty());
+    EXPECT_EQ(1u, cache.getStats().mmapCallsAvoided);
+
+    cache.markLocked(fakeBo(1), cached);
+    cache.evict(fakeBo(1));
+    ASSERT_EQ(1u, unmappedAddresses.size());
+    EXPECT_FALSE(cache.release(fakeBo(1), 5u));
+}
+
+TEST_F(DrmCpuMappingCacheTest, givenBudgetExceededWhenMappingIsReleasedThenLeastRecentlyUsedMappingIsUnmapped) {
+    DrmCpuMappingCache cache(0x2000, munmapFunction);
+
+    cache.markLocked(fakeBo(1), fakeMapping(0x1000, 0x1000));
+    cache.release(fakeBo(1), 0u);
+    cache.markLocked(fakeBo(2), fakeMapping(0x2000, 0x1000));
+    cache.release(fakeBo(2), 0u);
+
+    DrmCpuMappingCache::Mapping mapping;
+    EXPECT_TRUE(cache.acquire(fakeBo(1), mapping));
+    cache.markLocked(fakeBo(1), mapping);
+    cache.release(fakeBo(1), 0u);
+
+    cache.markLocked(fakeBo(3), fakeMapping(0x3000, 0x1000));
+    cache.release(fakeBo(3), 0u);
+
+    ASSERT_EQ(1u, unmappedAddresses.size());
+    EXPECT_EQ(reinterpret_cast<void *>(0x2000), unmappedAddresses[0]);
+    EXPECT_FALSE(cache.acquire(fakeBo(2), mapping));
+    EXPECT_EQ(2u, cache.peekCachedMappingsCount());
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.mappingsEvicted);
+    EXPECT_EQ(0x2000u, stats.cachedBytes);
+
+    cache.evictAll();
+    EXPECT_EQ(3u, unmappedAddresses.size());
+    EXPECT_EQ(0u, cache.getStats().cachedBytes);
+}
+
+TEST_F(DrmCpuMappingCacheTest, givenMappingLargerThanBudgetWhenReleasedThenItIsUnmappedImmediately) {
+    DrmCpuMappingCache cache(0x1000, munmapFunction);
+    cache.markLocked(fakeBo(1), fakeMapping(0x1000, 0x2000));
+    EXPECT_TRUE(cache.release(fakeBo(1), 0u));
+    EXPECT_EQ(1u, unmappedAddresses.size());
+    EXPECT_EQ(0u, cache.peekCachedMappingsCount());
+}
@@ -22,6 +22,8 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -179,3 +181,69 @@ TEST_F(DrmGemCloseWorkerTests, givenAllocationWhenAskedForUnreferenceWithForceFl
 
     delete worker;
 }
+
+TEST_F(DrmGemCloseWorkerTests, givenCommandBuffersSharingResidencyWhenBatchIsClosedThenSharedObjectReferencesAreReleasedTogether) {
+    this->drmMock->gem_close_expected = 4;
+
+    auto worker = new DrmGemCloseWorker(*mm);
+    auto sharedBo = new BufferObjectWrapper(this->drmMock, 1);
+
+    // hold ioctls so that all command buffers end up in a single batch
+    std::unique_lock<std::mutex> ioctlLock(this->drmMock->mutex);
+    for (int i = 0; i < 3; i++) {
+        auto bo = new BufferObjectWrapper(this->drmMock, 2 + i);
+        sharedBo->reference();
+        bo->getResidency()->push_back(sharedBo);
+        worker->push(new DrmAllocationWrapper(bo));
+    }
+    EXPECT_FALSE(worker->isEmpty());
+    ioctlLock.unlock();
+
+    worker->close(true);
+    EXPECT_TRUE(worker->isEmpty());
+    EXPECT_LE(1u, worker->getBatchesCount());
+    EXPECT_GE(2u, worker->getBatchesCount());
+    EXPECT_EQ(1u, sharedBo->getRefCount());
+    EXPECT_EQ(3, this->drmMock->gem_close_cnt.load());
+
+    mm->unreference(sharedBo);
+    delete worker;
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenWorkerFallingBehindWhenPendingCountReachesThresholdThenBackPressureIsSignalled) {
+    this->drmMock->gem_close_expected = DrmGemCloseWorker::backPressureThreshold;
+
+    auto worker = new DrmGemCloseWorker(*mm);
+    EXPECT_FALSE(worker->isBackPressured());
+
+    std::unique_lock<std::mutex> ioctlLock(this->drmMock->mutex);
+    for (uint32_t i = 0; i < DrmGemCloseWorker::backPressureThreshold; i++) {
+        auto bo = new BufferObjectWrapper(this->drmMock, 1);
+        worker->push(new DrmAllocationWrapper(bo));
+    }
+    EXPECT_TRUE(worker->isBackPressured());
+    EXPECT_EQ(1u, worker->getBackPressureEventsCount());
+    ioctlLock.unlock();
+
+    worker->close(true);
+    EXPECT_FALSE(worker->isBackPressured());
+    delete worker;
+}
+
+TEST_F(DrmGemCloseWorkerTests, givenBackPressuredWorkerWhenSubmitterIsThrottledThenItWaitsUntilWorkerCatchesUp) {
+    this->drmMock->gem_close_expected = DrmGemCloseWorker::backPressureThreshold;
+    EXPECT_FALSE(mm->throttleOnCloseWorkerBackPressure());
+
+    std::unique_lock<std::mutex> ioctlLock(this->drmMock->mutex);
+    for (uint32_t i = 0; i < DrmGemCloseWorker::backPressureThreshold; i++) {
+        auto bo = new BufferObjectWrapper(this->drmMock, 1);
+        mm->push(new DrmAllocationWrapper(bo));
+    }
+
+    auto throttled = std::async(std::launch::async, [this]() { return mm->throttleOnCloseWorkerBackPressure(); });
+    EXPECT_EQ(std::future_status::timeout, throttled.wait_for(std::chrono::milliseconds(10)));
+    ioctlLock.unlock();
+
+    EXPECT_TRUE(throttled.get());
+    mm->waitForDeletions();
+}
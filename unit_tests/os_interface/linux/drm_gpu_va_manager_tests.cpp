@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/os_interface/linux/drm_gpu_va_manager.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+namespace {
+int gpuVaMmapCalls = 0;
+int gpuVaMunmapCalls = 0;
+
+void *gpuVaMmapFailing(void *addr, size_t length, int prot, int flags, int fd, off_t offset) noexcept {
+    gpuVaMmapCalls++;
+    return MAP_FAILED;
+}
+
+int gpuVaMunmapCounting(void *addr, size_t length) noexcept {
+    gpuVaMunmapCalls++;
+    return munmap(addr, length);
+}
+} // namespace
+
+TEST(DrmGpuVaManagerTest, givenRangeSizeWhenManagerIsCreatedThenSingleRangeIsReservedAndReleasedOnDestruction) {
+    gpuVaMunmapCalls = 0;
+    {
+        DrmGpuVaManager gpuVaManager(64 * MemoryConstants::megaByte, mmap, gpuVaMunmapCounting);
+        ASSERT_TRUE(gpuVaManager.isInitialized());
+        EXPECT_NE(0u, gpuVaManager.getBase());
+        EXPECT_EQ(64 * MemoryConstants::megaByte, gpuVaManager.getRangeSize());
+    }
+    EXPECT_EQ(1, gpuVaMunmapCalls);
+}
+
+TEST(DrmGpuVaManagerTest, givenFailingMmapWhenManagerIsCreatedThenItIsNotInitializedAndReturnsNoAddresses) {
+    gpuVaMmapCalls = 0;
+    gpuVaMunmapCalls = 0;
+    {
+        DrmGpuVaManager gpuVaManager(64 * MemoryConstants::megaByte, gpuVaMmapFailing, gpuVaMunmapCounting);
+        EXPECT_FALSE(gpuVaManager.isInitialized());
+        size_t size = MemoryConstants::pageSize;
+        EXPECT_EQ(nullptr, gpuVaManager.reserve(size));
+    }
+    EXPECT_EQ(1, gpuVaMmapCalls);
+    EXPECT_EQ(0, gpuVaMunmapCalls);
+}
+
+TEST(DrmGpuVaManagerTest, givenInitializedManagerWhenAddressesAreReservedThenTheyAreDistinctAndInRange) {
+    DrmGpuVaManager gpuVaManager(64 * MemoryConstants::megaByte, mmap, munmap);
+    ASSERT_TRUE(gpuVaManager.isInitialized());
+
+    size_t size1 = MemoryConstants::pageSize;
+    size_t size2 = 3 * MemoryConstants::pageSize;
+    auto address1 = gpuVaManager.reserve(size1);
+    auto address2 = gpuVaManager.reserve(size2);
+    ASSERT_NE(nullptr, address1);
+    ASSERT_NE(nullptr, address2);
+    EXPECT_NE(address1, address2);
+    EXPECT_TRUE(gpuVaManager.isInRange(address1));
+    EXPECT_TRUE(gpuVaManager.isInRange(address2));
+    EXPECT_FALSE(gpuVaManager.isInRange(reinterpret_cast<void *>(gpuVaManager.getBase() + gpuVaManager.getRangeSize())));
+
+    HeapStatistics stats;
+    EXPECT_TRUE(gpuVaManager.getStatistics(stats));
+    EXPECT_EQ(size1 + size2, stats.usedSize);
+
+    gpuVaManager.release(address1, size1);
+    gpuVaManager.release(address2, size2);
+    EXPECT_TRUE(gpuVaManager.getStatistics(stats));
+    EXPECT_EQ(0u, stats.usedSize);
+}
@@ -31,6 +31,8 @@
 #include "runtime/os_interface/linux/drm_allocation.h"
 #include "runtime/os_interface/linux/drm_buffer_object.h"
 #include "runtime/os_interface/linux/drm_command_stream.h"
+#include "runtime/os_interface/linux/drm_cpu_mapping_cache.h"
+#include "runtime/os_interface/linux/drm_gpu_va_manager.h"
 #include "runtime/os_interface/linux/drm_memory_manager.h"
 #include "runtime/utilities/tag_allocator.h"
 #include "runtime/mem_obj/buffer.h"
@@ -49,6 +51,7 @@
 #include "gtest/gtest.h"
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 using namespace OCLRT;
 
@@ -56,6 +59,8 @@ static off_t lseekReturn = 4096u;
 static int lseekCalledCount = 0;
 static int mmapMockCallCount = 0;
 static int munmapMockCallCount = 0;
+static int madviseMockCallCount = 0;
+static int madviseMockReturn = 0;
 
 off_t lseekMock(int fd, off_t offset, int whence) noexcept {
     lseekCalledCount++;
@@ -72,6 +77,11 @@ int munmapMock(void *addr, size_t length) noexcept {
     return 0;
 }
 
+int madviseMock(void *addr, size_t length, int advice) noexcept {
+    madviseMockCallCount++;
+    return madviseMockReturn;
+}
+
 int closeMock(int) {
     return 0;
 }
@@ -79,27 +89,34 @@ int closeMock(int) {
 class TestedDrmMemoryManager : public DrmMemoryManager {
   public:
     using DrmMemoryManager::allocUserptr;
+    using DrmMemoryManager::countTransparentHugePageBytes;
     using DrmMemoryManager::setDomainCpu;
 
     TestedDrmMemoryManager(Drm *drm) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, false, false) {
         this->lseekFunction = &lseekMock;
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
+        this->madviseFunction = &madviseMock;
         this->closeFunction = &closeMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockCallCount = 0;
+        madviseMockReturn = 0;
     };
     TestedDrmMemoryManager(Drm *drm, bool allowForcePin, bool validateHostPtrMemory) : DrmMemoryManager(drm, gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers, allowForcePin, validateHostPtrMemory) {
         this->lseekFunction = &lseekMock;
         this->mmapFunction = &mmapMock;
         this->munmapFunction = &munmapMock;
+        this->madviseFunction = &madviseMock;
         this->closeFunction = &closeMock;
         lseekReturn = 4096;
         lseekCalledCount = 0;
         mmapMockCallCount = 0;
         munmapMockCallCount = 0;
+        madviseMockCallCount = 0;
+        madviseMockReturn = 0;
     }
 
     void unreference(BufferObject *bo) {
@@ -184,6 +201,121 @@ TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenforcePinAllowedWhenMem
     delete mm;
 }
 
+class DrmMockWithNumaNode : public DrmMockCustom {
+  public:
+    int getNumaNode() override {
+        return numaNode;
+    }
+    int numaNode = -1;
+};
+
+TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenDeviceOnNumaNodeWhenMemoryManagerIsCreatedThenHostMemoryIsPlacedOnThatNode) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.OverrideNumaNode.set(-1);
+    DrmMockWithNumaNode drm;
+    drm.numaNode = 1;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(&drm));
+    EXPECT_TRUE(mm->getNumaPolicy().isEnabled());
+    EXPECT_EQ(1, mm->getNumaPolicy().getPreferredNode());
+}
+
+TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenDeviceWithoutNumaNodeWhenMemoryManagerIsCreatedThenNumaPlacementIsDisabled) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.OverrideNumaNode.set(-1);
+    DrmMockWithNumaNode drm;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(&drm));
+    EXPECT_FALSE(mm->getNumaPolicy().isEnabled());
+}
+
+TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenOverrideNumaNodeSetWhenMemoryManagerIsCreatedThenItTakesPrecedenceOverDetectedNode) {
+    DebugManagerStateRestore dbgRestore;
+    DrmMockWithNumaNode drm;
+    drm.numaNode = 1;
+
+    DebugManager.flags.OverrideNumaNode.set(0);
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(&drm));
+    EXPECT_EQ(0, mm->getNumaPolicy().getPreferredNode());
+
+    DebugManager.flags.OverrideNumaNode.set(-2);
+    mm.reset(new TestedDrmMemoryManager(&drm));
+    EXPECT_FALSE(mm->getNumaPolicy().isEnabled());
+}
+
+TEST_F(DrmMemoryManagerTest, givenNumaNodeWhenAllocationIsCreatedThenItIsMmappedAndPlaced) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.OverrideNumaNode.set(0);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    ASSERT_TRUE(mm->getNumaPolicy().isEnabled());
+    auto allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = allocation->getBO();
+    ASSERT_NE(nullptr, bo);
+
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, munmapMockCallCount);
+    EXPECT_EQ(MMAP_ALLOCATOR, bo->peekAllocationType());
+    EXPECT_EQ(MemoryConstants::pageSize, bo->peekSize());
+    // mocked mapping is not backed, so mbind may fail, but placement has to be attempted
+    auto &numaPolicy = mm->getNumaPolicy();
+    EXPECT_EQ(1u, numaPolicy.getFailedPlacementsCount() + numaPolicy.getPlacedBytes() / MemoryConstants::pageSize);
+
+    mm->freeGraphicsMemory(allocation);
+    EXPECT_EQ(1, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenNumaNodeWhenAllocationWithLargeAlignmentIsCreatedThenUnalignedPartsOfMappingAreReturned) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.OverrideNumaNode.set(0);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    auto allocation = mm->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize64k);
+    ASSERT_NE(nullptr, allocation);
+
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(2, munmapMockCallCount);
+    EXPECT_TRUE(isAligned<MemoryConstants::pageSize64k>(allocation->getUnderlyingBuffer()));
+    EXPECT_EQ(MMAP_ALLOCATOR, allocation->getBO()->peekAllocationType());
+
+    mm->freeGraphicsMemory(allocation);
+    EXPECT_EQ(3, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerTest, givenNumaPlacementDisabledWhenAllocationIsCreatedThenItIsNotMmapped) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    ASSERT_FALSE(memoryManager->getNumaPolicy().isEnabled());
+    auto allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_NE(MMAP_ALLOCATOR, allocation->getBO()->peekAllocationType());
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(0, munmapMockCallCount);
+}
+
+TEST_F(DrmMemoryManagerWithExplicitExpectationsTest, givenNumaNodeWhenMemoryUsageIsQueriedThenPlacementIsReported) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.OverrideNumaNode.set(1);
+
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    MemoryUsageSnapshot snapshot;
+    mm->getMemoryUsage(snapshot);
+    EXPECT_EQ(1, snapshot.numaNode);
+    EXPECT_EQ(mm->getNumaPolicy().getPlacedBytes(), snapshot.numaPlacedBytes);
+    EXPECT_EQ(mm->getNumaPolicy().getFailedPlacementsCount(), snapshot.numaFailedPlacements);
+}
+
 TEST_F(DrmMemoryManagerTest, pinBBisCreated) {
     mock->ioctl_expected.gemUserptr = 1;
     mock->ioctl_expected.gemClose = 1;
@@ -393,6 +525,23 @@ TEST_F(DrmMemoryManagerTest, AllocateThenFree) {
     memoryManager->freeGraphicsMemory(alloc);
 }
 
+TEST_F(DrmMemoryManagerTest, givenAllocationWhenGettingMemoryUsageThenLiveBufferObjectsAreReportedAsOsHandles) {
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto bufferObjectsBefore = memoryManager->getBufferObjectsCount();
+    auto alloc = memoryManager->allocateGraphicsMemory(1024, 1024);
+    ASSERT_NE(nullptr, alloc);
+
+    MemoryUsageSnapshot snapshot;
+    memoryManager->getMemoryUsage(snapshot);
+    EXPECT_EQ(bufferObjectsBefore + 1, snapshot.osHandles);
+
+    memoryManager->freeGraphicsMemory(alloc);
+    EXPECT_EQ(bufferObjectsBefore, memoryManager->getBufferObjectsCount());
+}
+
 TEST_F(DrmMemoryManagerTest, AllocateNewFail) {
     mock->ioctl_expected.total = -1; //don't care
 
@@ -441,6 +590,132 @@ TEST_F(DrmMemoryManagerTest, AllocateUserptrFail) {
     EXPECT_EQ(nullptr, ptr);
 }
 
+TEST_F(DrmMemoryManagerTest, givenHugePagesDisabledWhenLargeAllocationIsCreatedThenItIsNotMmapped) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableHugePageAllocations.set(0);
+    DebugManager.flags.HugePageAllocationThresholdInMegabytes.set(2);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(4 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_EQ(0, madviseMockCallCount);
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+
+    memoryManager->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePagesEnabledWhenAllocationIsBelowThresholdThenItIsNotMmapped) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableHugePageAllocations.set(1);
+    DebugManager.flags.HugePageAllocationThresholdInMegabytes.set(4);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(3 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(0, mmapMockCallCount);
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+
+    memoryManager->freeGraphicsMemory(allocation);
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePagesEnabledWhenLargeAllocationIsCreatedThenItIs2MbAlignedAndAccountedAsHugePageAdvised) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableHugePageAllocations.set(1);
+    DebugManager.flags.HugePageAllocationThresholdInMegabytes.set(2);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(3 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    auto bo = allocation->getBO();
+    ASSERT_NE(nullptr, bo);
+
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(1, madviseMockCallCount);
+    // unaligned head and tail of the over-reserved range are returned
+    EXPECT_EQ(2, munmapMockCallCount);
+    EXPECT_TRUE(isAligned<MemoryConstants::pageSize2Mb>(allocation->getUnderlyingBuffer()));
+    EXPECT_EQ(3 * MemoryConstants::megaByte, allocation->getUnderlyingBufferSize());
+    EXPECT_EQ(4 * MemoryConstants::megaByte, bo->peekSize());
+    EXPECT_EQ(HUGE_PAGE_ALLOCATOR, bo->peekAllocationType());
+    EXPECT_EQ(4 * MemoryConstants::megaByte, memoryManager->getHugePageAdvisedBytes());
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(3, munmapMockCallCount);
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugePagesEnabledWhenMadviseFailsThenAllocationIsNotAccountedAsHugePageAdvised) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableHugePageAllocations.set(1);
+    DebugManager.flags.HugePageAllocationThresholdInMegabytes.set(2);
+    madviseMockReturn = -1;
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(MMAP_ALLOCATOR, allocation->getBO()->peekAllocationType());
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+}
+
+TEST_F(DrmMemoryManagerTest, givenHugetlbfsModeWhenLargeAllocationIsCreatedThenSingleHugetlbMappingIsUsed) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableHugePageAllocations.set(2);
+    DebugManager.flags.HugePageAllocationThresholdInMegabytes.set(2);
+    mock->ioctl_expected.gemUserptr = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    auto allocation = memoryManager->allocateGraphicsMemory(2 * MemoryConstants::megaByte, MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, allocation);
+    EXPECT_EQ(1, mmapMockCallCount);
+    EXPECT_EQ(0, munmapMockCallCount);
+    EXPECT_EQ(0, madviseMockCallCount);
+    EXPECT_EQ(HUGE_PAGE_ALLOCATOR, allocation->getBO()->peekAllocationType());
+    EXPECT_EQ(2 * MemoryConstants::megaByte, memoryManager->getHugePageAdvisedBytes());
+    EXPECT_EQ(2 * MemoryConstants::megaByte, memoryManager->getHugePageBackedBytes());
+
+    MemoryUsageSnapshot snapshot;
+    memoryManager->getMemoryUsage(snapshot);
+    EXPECT_EQ(2 * MemoryConstants::megaByte, snapshot.hugePageAdvisedBytes);
+    EXPECT_EQ(2 * MemoryConstants::megaByte, snapshot.hugePageBackedBytes);
+
+    memoryManager->freeGraphicsMemory(allocation);
+    EXPECT_EQ(1, munmapMockCallCount);
+    EXPECT_EQ(0u, memoryManager->getHugePageAdvisedBytes());
+    EXPECT_EQ(0u, memoryManager->getHugePageBackedBytes());
+}
+
+TEST(DrmMemoryManagerHugePagesTest, givenSmapsWhenTransparentHugePageBytesAreCountedThenOnlyMappingsCoveredByRangesContribute) {
+    std::map<uintptr_t, size_t> ranges = {{0x200000, 4 * MemoryConstants::megaByte},
+                                          {0x1000000, 2 * MemoryConstants::megaByte}};
+    std::stringstream smaps;
+    // mapping of the first range only
+    smaps << "00200000-00600000 rw-p 00000000 00:00 0\n"
+          << "Size:               4096 kB\n"
+          << "AnonHugePages:      2048 kB\n"
+          << "VmFlags: rd wr mr mw me ac hg\n"
+          // unrelated mapping
+          << "00800000-00c00000 rw-p 00000000 00:00 0\n"
+          << "AnonHugePages:      4096 kB\n"
+          // second range merged with a neighbouring mapping, its huge pages can not be attributed beyond the range
+          << "00e00000-01400000 rw-p 00000000 00:00 0\n"
+          << "AnonHugePages:      6144 kB\n";
+
+    EXPECT_EQ(4 * MemoryConstants::megaByte, TestedDrmMemoryManager::countTransparentHugePageBytes(smaps, ranges));
+}
+
 TEST_F(DrmMemoryManagerTest, FreeNullPtr) {
     memoryManager->freeGraphicsMemory(nullptr);
 }
@@ -1139,6 +1414,34 @@ TEST_F(DrmMemoryManagerTest, Given32BitDeviceWithMemoryManagerWhenInternalHeapIs
     EXPECT_TRUE(memoryManager->device->getDeviceInfo().force32BitAddressess);
 }
 
+TEST_F(DrmMemoryManagerTest, givenFreedInternalAllocationInTheMiddleOfTheHeapWhenStatisticsAreQueriedThenInternalHeapIsReportedAsFragmented) {
+    mock->ioctl_expected.gemUserptr = 3;
+    mock->ioctl_expected.gemWait = 3;
+    mock->ioctl_expected.gemClose = 3;
+
+    auto allocationSize = MemoryConstants::pageSize;
+    auto allocation0 = memoryManager->createInternalGraphicsAllocation(nullptr, allocationSize);
+    auto allocation1 = memoryManager->createInternalGraphicsAllocation(nullptr, allocationSize);
+    auto allocation2 = memoryManager->createInternalGraphicsAllocation(nullptr, allocationSize);
+    ASSERT_NE(nullptr, allocation0);
+    ASSERT_NE(nullptr, allocation1);
+    ASSERT_NE(nullptr, allocation2);
+
+    HeapStatistics stats;
+    EXPECT_TRUE(memoryManager->get32BitHeapStatistics(MemoryType::INTERNAL_ALLOCATION, stats));
+    EXPECT_EQ(0u, stats.freeChunksCount);
+    EXPECT_EQ(0.0, stats.getFragmentation());
+
+    memoryManager->freeGraphicsMemory(allocation1);
+
+    EXPECT_TRUE(memoryManager->get32BitHeapStatistics(MemoryType::INTERNAL_ALLOCATION, stats));
+    EXPECT_EQ(1u, stats.freeChunksCount);
+    EXPECT_GT(stats.getFragmentation(), 0.0);
+
+    memoryManager->freeGraphicsMemory(allocation0);
+    memoryManager->freeGraphicsMemory(allocation2);
+}
+
 TEST_F(DrmMemoryManagerTest, GivenMemoryManagerWhenAllocateGraphicsMemoryForImageIsCalledThenProperIoctlsAreCalledAndUnmapSizeIsNonZero) {
     mock->ioctl_expected.gemCreate = 1;
     mock->ioctl_expected.gemSetTiling = 1;
@@ -1514,6 +1817,36 @@ TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerAndOsHandleWhenCreateIsCalledT
     memoryManager->freeGraphicsMemory(graphicsAllocation);
 }
 
+TEST_F(DrmMemoryManagerTest, givenGpuVaManagerEnabledWhenSharedAllocationIsCreatedThenItsAddressComesFromGpuVaRangeWithoutMmap) {
+    mock->ioctl_expected.primeFdToHandle = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.GpuVaManagerRangeInGigabytes.set(1);
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    auto gpuVaManager = mm->getGpuVaManager();
+    ASSERT_NE(nullptr, gpuVaManager);
+    EXPECT_EQ(MemoryConstants::gigaByte, gpuVaManager->getRangeSize());
+
+    osHandle handle = 1u;
+    this->mock->outputHandle = 2u;
+    auto graphicsAllocation = mm->createGraphicsAllocationFromSharedHandle(handle, false);
+    ASSERT_NE(nullptr, graphicsAllocation);
+
+    auto bo = static_cast<DrmAllocation *>(graphicsAllocation)->getBO();
+    EXPECT_EQ(GPU_VA_ALLOCATOR, bo->peekAllocationType());
+    EXPECT_TRUE(gpuVaManager->isInRange(bo->peekAddress()));
+    EXPECT_EQ(0, mmapMockCallCount);
+
+    mm->freeGraphicsMemory(graphicsAllocation);
+    EXPECT_EQ(0, munmapMockCallCount);
+
+    HeapStatistics stats;
+    EXPECT_TRUE(gpuVaManager->getStatistics(stats));
+    EXPECT_EQ(0u, stats.usedSize);
+}
+
 TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerAndOsHandleWhenAllocationFailsThenReturnNullPtr) {
     osHandle handle = 1u;
 
@@ -1727,6 +2060,56 @@ TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerWhenLockUnlockIsCalledOnAlloca
     memoryManager->freeGraphicsMemory(allocation);
 }
 
+TEST_F(DrmMemoryManagerTest, givenCpuMappingCacheEnabledWhenAllocationIsLockedAgainThenCachedMappingIsReusedWithoutMmapAndSetDomain) {
+    mock->ioctl_expected.gemCreate = 1;
+    mock->ioctl_expected.gemMmap = 1;
+    mock->ioctl_expected.gemSetDomain = 1;
+    mock->ioctl_expected.gemSetTiling = 1;
+    mock->ioctl_expected.gemWait = 1;
+    mock->ioctl_expected.gemClose = 1;
+
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.CpuMappingCacheSizeInMegabytes.set(1);
+    std::unique_ptr<TestedDrmMemoryManager> mm(new TestedDrmMemoryManager(this->mock));
+    auto cpuMappingCache = mm->getCpuMappingCache();
+    ASSERT_NE(nullptr, cpuMappingCache);
+
+    cl_image_desc imgDesc = {};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 512;
+    imgDesc.image_height = 512;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    imgInfo.imgDesc = &imgDesc;
+    imgInfo.size = 4096u;
+    imgInfo.rowPitch = 512u;
+
+    auto queryGmm = MockGmm::queryImgParams(imgInfo);
+    auto allocation = mm->allocateGraphicsMemoryForImage(imgInfo, queryGmm.get());
+    queryGmm.release();
+    ASSERT_NE(nullptr, allocation);
+    auto bo = static_cast<DrmAllocation *>(allocation)->getBO();
+    auto munmapCallsAfterCreation = munmapMockCallCount;
+
+    auto ptr = mm->lockResource(allocation);
+    EXPECT_NE(nullptr, ptr);
+    mm->unlockResource(allocation);
+    EXPECT_EQ(nullptr, bo->peekLockedAddress());
+    EXPECT_EQ(munmapCallsAfterCreation, munmapMockCallCount);
+    EXPECT_EQ(1u, cpuMappingCache->peekCachedMappingsCount());
+
+    EXPECT_EQ(ptr, mm->lockResource(allocation));
+    mm->unlockResource(allocation);
+
+    auto stats = cpuMappingCache->getStats();
+    EXPECT_EQ(1u, stats.mappingsCreated);
+    EXPECT_EQ(1u, stats.mmapCallsAvoided);
+    EXPECT_EQ(1u, stats.setDomainCallsAvoided);
+
+    mm->freeGraphicsMemory(allocation);
+    EXPECT_EQ(0u, cpuMappingCache->peekCachedMappingsCount());
+    EXPECT_EQ(1u, cpuMappingCache->getStats().mappingsEvicted);
+}
+
 TEST_F(DrmMemoryManagerTest, givenDrmMemoryManagerWhenLockUnlockIsCalledOnNullAllocationThenReturnNullPtr) {
     GraphicsAllocation *allocation = nullptr;
 
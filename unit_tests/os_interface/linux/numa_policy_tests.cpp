@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/os_interface/linux/numa_policy.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "gtest/gtest.h"
+
+using namespace OCLRT;
+
+namespace {
+struct MbindCall {
+    void *addr = nullptr;
+    unsigned long len = 0;
+    int mode = -1;
+    unsigned long firstMaskWord = 0;
+    unsigned long maxnode = 0;
+    unsigned int flags = 0;
+    int callCount = 0;
+    long returnValue = 0;
+} mbindCall;
+
+long mbindMock(void *addr, unsigned long len, int mode, const unsigned long *nodemask, unsigned long maxnode, unsigned int flags) {
+    mbindCall.addr = addr;
+    mbindCall.len = len;
+    mbindCall.mode = mode;
+    mbindCall.firstMaskWord = nodemask[0];
+    mbindCall.maxnode = maxnode;
+    mbindCall.flags = flags;
+    mbindCall.callCount++;
+    return mbindCall.returnValue;
+}
+
+class MockNumaPolicy : public NumaPolicy {
+  public:
+    MockNumaPolicy() {
+        mbindFunction = mbindMock;
+        mbindCall = MbindCall();
+    }
+};
+} // namespace
+
+TEST(NumaPolicyTest, givenDefaultPolicyThenPlacementIsDisabled) {
+    MockNumaPolicy policy;
+    uint64_t memory[4];
+
+    EXPECT_FALSE(policy.isEnabled());
+    EXPECT_EQ(NumaPolicy::noNode, policy.getPreferredNode());
+    EXPECT_FALSE(policy.applyPreferredPlacement(memory, sizeof(memory)));
+    EXPECT_EQ(0, mbindCall.callCount);
+}
+
+TEST(NumaPolicyTest, givenInvalidNodeWhenSetAsPreferredThenPlacementIsDisabled) {
+    MockNumaPolicy policy;
+    policy.setPreferredNode(-2);
+    EXPECT_FALSE(policy.isEnabled());
+    policy.setPreferredNode(NumaPolicy::maxNodes);
+    EXPECT_FALSE(policy.isEnabled());
+}
+
+TEST(NumaPolicyTest, givenPreferredNodeWhenPlacementIsAppliedThenPageAlignedRangeIsBoundToThatNode) {
+    MockNumaPolicy policy;
+    policy.setPreferredNode(1);
+    auto ptr = reinterpret_cast<void *>(0x10010);
+
+    EXPECT_TRUE(policy.applyPreferredPlacement(ptr, MemoryConstants::pageSize));
+
+    EXPECT_EQ(1, mbindCall.callCount);
+    EXPECT_EQ(reinterpret_cast<void *>(0x10000), mbindCall.addr);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, mbindCall.len);
+    EXPECT_EQ(1, mbindCall.mode);
+    EXPECT_EQ(2ul, mbindCall.firstMaskWord);
+    EXPECT_EQ(static_cast<unsigned long>(NumaPolicy::maxNodes + 1), mbindCall.maxnode);
+    EXPECT_EQ(2u, mbindCall.flags);
+    EXPECT_EQ(2 * MemoryConstants::pageSize, policy.getPlacedBytes());
+    EXPECT_EQ(0u, policy.getFailedPlacementsCount());
+}
+
+TEST(NumaPolicyTest, givenFailingMbindWhenPlacementIsAppliedThenFailureIsCounted) {
+    MockNumaPolicy policy;
+    policy.setPreferredNode(0);
+    mbindCall.returnValue = -1;
+    auto ptr = reinterpret_cast<void *>(0x10000);
+
+    EXPECT_FALSE(policy.applyPreferredPlacement(ptr, MemoryConstants::pageSize));
+    EXPECT_EQ(1u, policy.getFailedPlacementsCount());
+    EXPECT_EQ(0u, policy.getPlacedBytes());
+}
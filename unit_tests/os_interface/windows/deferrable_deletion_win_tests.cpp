@@ -63,3 +63,22 @@ TEST_F(DeferrableDeletionTest, givenDeferrableDeletionWhenApplyIsCalledThenDelet
     deletion->apply();
     EXPECT_EQ(1, wddm.destroyAllocationResult.called);
 }
+
+TEST_F(DeferrableDeletionTest, givenDeferrableDeletionWhenWaitingForFenceThenItWaitsOnItsLastFenceValue) {
+    uint64_t currentFence = 5u;
+    wddm.getMonitoredFence().cpuAddress = &currentFence;
+    MockDeferrableDeletion deletion(&wddm, &handle, allocationCount, 5u, resourceHandle);
+    EXPECT_EQ(5u, deletion.getFenceValue());
+    deletion.waitForFence();
+    EXPECT_EQ(1u, wddm.waitFromCpuResult.called);
+    EXPECT_EQ(5u, wddm.waitFromCpuResult.uint64ParamPassed);
+}
+
+TEST_F(DeferrableDeletionTest, givenSignaledFenceWhenApplyIsCalledThenAllocationsAreDestroyedWithoutWaiting) {
+    wddm.callBaseDestroyAllocations = false;
+    MockDeferrableDeletion deletion(&wddm, &handle, allocationCount, 5u, resourceHandle);
+    deletion.setFenceSignaled();
+    deletion.apply();
+    EXPECT_EQ(1u, wddm.destroyAllocationResult.called);
+    EXPECT_EQ(0u, wddm.destroyAllocationResult.uint64ParamPassed);
+}
@@ -155,6 +155,7 @@ class WddmMock : public Wddm {
     }
     bool destroyAllocations(D3DKMT_HANDLE *handles, uint32_t allocationCount, uint64_t lastFenceValue, D3DKMT_HANDLE resourceHandle) override {
         destroyAllocationResult.called++;
+        destroyAllocationResult.uint64ParamPassed = lastFenceValue;
         if (callBaseDestroyAllocations) {
             return destroyAllocationResult.success = Wddm::destroyAllocations(handles, allocationCount, lastFenceValue, resourceHandle);
         } else {
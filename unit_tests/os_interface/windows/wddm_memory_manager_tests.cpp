@@ -1223,6 +1223,48 @@ HWTEST_F(WddmMemoryManagerResidencyTest, trimToBudgetReturnsFalseWhenNumBytesToT
     EXPECT_FALSE(status);
 }
 
+HWTEST_F(WddmMemoryManagerResidencyTest, givenResidencyBudgetExceededWhenColdAllocationsAreEvictedThenOnlyCompletedAllocationsOutsideOfWorkingSetAreEvicted) {
+    SetUpMm<FamilyType>();
+    auto &lruResidencyManager = memoryManager->getLruResidencyManager();
+    lruResidencyManager.setBudget(0x1000);
+
+    WddmAllocation allocation1((void *)(0x1000), 0x1000, (void *)(0x1000), 0x1000, nullptr),
+        allocation2((void *)(0x2000), 0x1000, (void *)(0x2000), 0x1000, nullptr),
+        allocation3((void *)(0x3000), 0x1000, (void *)(0x3000), 0x1000, nullptr);
+
+    allocation1.getResidencyData().resident = true;
+    allocation1.getResidencyData().lastFence = 1;
+    allocation2.getResidencyData().resident = true;
+    allocation2.getResidencyData().lastFence = 2;
+    allocation3.getResidencyData().resident = true;
+    allocation3.getResidencyData().lastFence = 3;
+
+    lruResidencyManager.markUsed(allocation1, 1);
+    lruResidencyManager.markUsed(allocation2, 2);
+    lruResidencyManager.markUsed(allocation3, 3);
+    EXPECT_TRUE(memoryManager->isMemoryBudgetExhausted());
+
+    *wddm->getMonitoredFence().cpuAddress = 1;
+    mockWddm->makeNonResidentResult.called = 0;
+    memoryManager->evictColdAllocations();
+
+    EXPECT_EQ(1u, mockWddm->makeNonResidentResult.called);
+    EXPECT_FALSE(allocation1.getResidencyData().resident);
+    EXPECT_TRUE(allocation2.getResidencyData().resident);
+    EXPECT_TRUE(lruResidencyManager.isTracked(allocation2));
+
+    *wddm->getMonitoredFence().cpuAddress = 3;
+    memoryManager->evictColdAllocations();
+
+    EXPECT_EQ(2u, mockWddm->makeNonResidentResult.called);
+    EXPECT_FALSE(allocation2.getResidencyData().resident);
+    EXPECT_TRUE(allocation3.getResidencyData().resident);
+    EXPECT_TRUE(lruResidencyManager.isTracked(allocation3));
+    EXPECT_FALSE(memoryManager->isMemoryBudgetExhausted());
+
+    lruResidencyManager.remove(allocation3);
+}
+
 HWTEST_F(WddmMemoryManagerResidencyTest, trimToBudgetStopsEvictingWhenNumBytesToTrimIsZero) {
     SetUpMm<FamilyType>();
     WddmAllocation allocation1((void *)(0x1000), 0x1000, (void *)(0x1000), 0x1000, nullptr),
@@ -1884,6 +1926,15 @@ TEST_F(MockWddmMemoryManagerTest, givenDefaultWddmMemoryManagerWhenItIsCreatedTh
     EXPECT_FALSE(memoryManager.isMemoryBudgetExhausted());
 }
 
+TEST_F(MockWddmMemoryManagerTest, givenResidencyBudgetDebugVariableWhenWddmMemoryManagerIsCreatedThenLruResidencyTrackingIsEnabled) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.ResidencyBudgetInMegabytes.set(16);
+    WddmMock *wddm = new WddmMock;
+    WddmMemoryManager memoryManager(false, wddm);
+    EXPECT_TRUE(memoryManager.getLruResidencyManager().isEnabled());
+    EXPECT_EQ(16 * MemoryConstants::megaByte, memoryManager.getLruResidencyManager().getBudget());
+}
+
 TEST_F(MockWddmMemoryManagerTest, givenEnabledAsyncDeleterFlagWhenMemoryManagerIsCreatedThenAsyncDeleterEnabledIsTrueAndDeleterIsNotNullptr) {
     bool defaultEnableDeferredDeleterFlag = DebugManager.flags.EnableDeferredDeleter.get();
     DebugManager.flags.EnableDeferredDeleter.set(true);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/fast_hash.h"
+#include "runtime/helpers/hash.h"
+#include "unit_tests/perf_tests/perf_test_utils.h"
+
+#include <vector>
+
+using namespace OCLRT;
+
+namespace ULT {
+
+template <typename HashFunction>
+long long measureHashTime(const std::vector<char> &buffer, HashFunction hashFunction, uint64_t &result) {
+    long long times[3] = {0, 0, 0};
+    for (int i = 0; i < 3; i++) {
+        Timer t;
+        t.start();
+        result = hashFunction(buffer.data(), buffer.size());
+        t.end();
+        times[i] = t.get();
+    }
+    return majorityVote(times[0], times[1], times[2]);
+}
+
+TEST(HashPerfTest, givenLargeBufferWhenHashedThenFastHashIsQuickerThanHash) {
+    Timer::setFreq();
+    std::vector<char> buffer(16 * 1024 * 1024);
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<char>(i * 31);
+    }
+
+    uint64_t result = 0;
+    auto hashTime = measureHashTime(buffer, [](const char *data, size_t size) { return Hash::hash(data, size); }, result);
+    auto fastHashTime = measureHashTime(buffer, [](const char *data, size_t size) { return FastHash::hash(data, size); }, result);
+
+    EXPECT_LT(fastHashTime, hashTime) << "Hash: " << hashTime << " FastHash: " << fastHashTime << "\n";
+}
+} // namespace ULT
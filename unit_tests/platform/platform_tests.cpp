@@ -26,6 +26,7 @@
 #include "runtime/sharings/sharing_factory.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/fixtures/platform_fixture.h"
+#include "unit_tests/mocks/mock_async_build_handler.h"
 #include "unit_tests/mocks/mock_async_event_handler.h"
 #include "unit_tests/mocks/mock_csr.h"
 #include "unit_tests/libult/create_command_stream.h"
@@ -119,6 +120,22 @@ TEST(PlatformTestSimple, shutdownClosesAsyncEventHandlerThread) {
     delete platform;
 }
 
+TEST(PlatformTestSimple, shutdownRunsQueuedAsyncBuildsAndClosesWorkers) {
+    Platform *platform = new Platform;
+
+    MockAsyncBuildHandler *mockBuildHandler = new MockAsyncBuildHandler(true);
+    auto oldHandler = platform->setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(mockBuildHandler));
+    EXPECT_EQ(mockBuildHandler, platform->getAsyncBuildHandler());
+
+    bool buildDone = false;
+    mockBuildHandler->submit([&buildDone] { buildDone = true; });
+
+    platform->shutdown();
+    EXPECT_TRUE(buildDone);
+    EXPECT_EQ(0u, mockBuildHandler->peekNumThreads());
+    delete platform;
+}
+
 namespace OCLRT {
 extern CommandStreamReceiverCreateFunc commandStreamReceiverFactory[2 * IGFX_MAX_CORE];
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/program/async_build_handler.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_async_build_handler.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+using namespace OCLRT;
+
+TEST(AsyncBuildHandlerTest, givenThreadCountFlagWhenHandlerIsCreatedThenItBoundsNumberOfWorkers) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.AsyncProgramBuildThreads.set(3);
+    AsyncBuildHandler handler;
+    EXPECT_EQ(3u, handler.getMaxThreads());
+
+    DebugManager.flags.AsyncProgramBuildThreads.set(0);
+    AsyncBuildHandler defaultHandler;
+    EXPECT_LE(1u, defaultHandler.getMaxThreads());
+    EXPECT_EQ(0u, defaultHandler.peekNumThreads());
+}
+
+TEST(AsyncBuildHandlerTest, givenQueuedBuildsWhenThreadsAreClosedThenAllBuildsRunBeforeWorkersExit) {
+    MockAsyncBuildHandler handler(true);
+    handler.maxThreads = 2;
+    std::atomic<uint32_t> buildsDone(0);
+
+    for (uint32_t i = 0; i < 16; i++) {
+        handler.submit([&buildsDone] { buildsDone++; });
+    }
+    EXPECT_LE(handler.peekNumThreads(), 2u);
+    handler.closeThreads();
+    EXPECT_EQ(16u, buildsDone);
+    EXPECT_EQ(0u, handler.peekNumThreads());
+
+    handler.submit([&buildsDone] { buildsDone++; });
+    handler.closeThreads();
+    EXPECT_EQ(17u, buildsDone);
+}
+
+TEST(AsyncBuildHandlerTest, givenBusyWorkersWhenBuildsAreSubmittedThenWorkersAreOpenedUpToLimit) {
+    MockAsyncBuildHandler handler(true);
+    handler.maxThreads = 2;
+    std::atomic<bool> release(false);
+    std::atomic<uint32_t> buildsDone(0);
+    auto blockingBuild = [&] {
+        while (!release) {
+            std::this_thread::yield();
+        }
+        buildsDone++;
+    };
+
+    handler.submit(blockingBuild);
+    handler.submit(blockingBuild);
+    handler.submit(blockingBuild);
+    EXPECT_EQ(2u, handler.peekNumThreads());
+    EXPECT_EQ(2u, handler.openThreadCalled);
+
+    release = true;
+    handler.closeThreads();
+    EXPECT_EQ(3u, buildsDone);
+}
+
+TEST(AsyncBuildHandlerTest, givenHandlerWithoutWorkersWhenClosingThenNothingHappens) {
+    MockAsyncBuildHandler handler;
+    handler.closeThreads();
+    handler.submit([] {});
+    EXPECT_EQ(1u, handler.openThreadCalled);
+    EXPECT_EQ(0u, handler.peekNumThreads());
+    EXPECT_EQ(1u, handler.runPendingTasks());
+}
@@ -35,7 +35,9 @@
 #include "program_tests.h"
 #include "unit_tests/fixtures/program_fixture.inl"
 #include "unit_tests/global_environment.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/helpers/kernel_binary_helper.h"
+#include "unit_tests/mocks/mock_async_build_handler.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/program/program_from_binary.h"
 #include "unit_tests/program/program_with_source.h"
@@ -105,6 +107,118 @@ TEST_P(ProgramFromBinaryTest, BuildProgram) {
     EXPECT_EQ(CL_SUCCESS, retVal);
 }
 
+TEST_P(ProgramFromBinaryTest, givenLazyKernelInfoParsingWhenProgramIsBuiltThenPatchListIsParsedOnFirstKernelInfoRequest) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableLazyKernelInfoParsing.set(true);
+
+    cl_device_id device = pDevice;
+    CreateProgramFromBinary<MockProgram>(pContext, &device, BinaryFileName);
+    auto mockProgram = static_cast<MockProgram *>(pProgram);
+    retVal = mockProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    auto &kernelInfos = mockProgram->getKernelInfoArray();
+    ASSERT_NE(0u, kernelInfos.size());
+    for (auto kernelInfo : kernelInfos) {
+        EXPECT_TRUE(kernelInfo->patchListParsingPending);
+        EXPECT_EQ(nullptr, kernelInfo->kernelAllocation);
+        EXPECT_EQ(nullptr, kernelInfo->patchInfo.executionEnvironment);
+    }
+
+    std::unique_ptr<MockProgram> eagerProgram(Program::create<MockProgram>(pContext, 1, &device, &knownSourceSize,
+                                                                           (const unsigned char **)&knownSource, nullptr, retVal));
+    ASSERT_NE(nullptr, eagerProgram);
+    DebugManager.flags.EnableLazyKernelInfoParsing.set(false);
+    ASSERT_EQ(CL_SUCCESS, eagerProgram->build(1, &device, nullptr, nullptr, nullptr, false));
+    auto eagerKernelInfo = eagerProgram->getKernelInfo(KernelName);
+    ASSERT_NE(nullptr, eagerKernelInfo);
+
+    auto kernelInfo = mockProgram->getKernelInfo(KernelName);
+    ASSERT_NE(nullptr, kernelInfo);
+    EXPECT_FALSE(kernelInfo->patchListParsingPending);
+    EXPECT_NE(nullptr, kernelInfo->patchInfo.executionEnvironment);
+    EXPECT_NE(nullptr, kernelInfo->kernelAllocation);
+    EXPECT_EQ(eagerKernelInfo->isValid, kernelInfo->isValid);
+    EXPECT_EQ(eagerKernelInfo->heapInfo.blobSize, kernelInfo->heapInfo.blobSize);
+    EXPECT_EQ(eagerKernelInfo->kernelArgInfo.size(), kernelInfo->kernelArgInfo.size());
+    EXPECT_EQ(eagerKernelInfo->gpuPointerSize, kernelInfo->gpuPointerSize);
+    EXPECT_EQ(kernelInfo, mockProgram->getKernelInfo(KernelName));
+}
+
+TEST_P(ProgramFromBinaryTest, givenLazyKernelInfoParsingWhenPatchListOfKernelIsCorruptedThenKernelsAreNotCreated) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableLazyKernelInfoParsing.set(true);
+
+    cl_device_id device = pDevice;
+    CreateProgramFromBinary<MockProgram>(pContext, &device, BinaryFileName);
+    auto mockProgram = static_cast<MockProgram *>(pProgram);
+    retVal = mockProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    // the first patch token keeps its size, so the kernel headers still walk, but the parser rejects it
+    auto &kernelInfos = mockProgram->getKernelInfoArray();
+    ASSERT_NE(0u, kernelInfos.size());
+    ASSERT_NE(0u, kernelInfos[0]->heapInfo.pKernelHeader->PatchListSize);
+    auto pPatch = const_cast<SPatchItemHeader *>(reinterpret_cast<const SPatchItemHeader *>(kernelInfos[0]->heapInfo.pPatchList));
+    pPatch->Token = 0xFFFF;
+    EXPECT_FALSE(mockProgram->hasKernelInfoParsingFailed());
+
+    cl_kernel kernels[16] = {};
+    ASSERT_LE(pProgram->getNumKernels(), 16u);
+    retVal = clCreateKernelsInProgram(pProgram, 16, kernels, nullptr);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+    EXPECT_EQ(nullptr, kernels[0]);
+    EXPECT_TRUE(mockProgram->hasKernelInfoParsingFailed());
+
+    auto kernel = clCreateKernel(pProgram, kernelInfos[0]->name.c_str(), &retVal);
+    EXPECT_EQ(nullptr, kernel);
+    EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+}
+
+TEST_P(ProgramFromBinaryTest, givenGenBinaryWhenKernelInfoIndexIsSerializedThenItRoundTripsAndDetectsCorruption) {
+    cl_device_id device = pDevice;
+    retVal = pProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    size_t genBinarySize = 0;
+    auto genBinary = pProgram->getGenBinary(genBinarySize);
+    std::vector<KernelInfoIndexEntry> index;
+    ASSERT_TRUE(KernelInfoIndex::build(genBinary, genBinarySize, index));
+    EXPECT_EQ(pProgram->getNumKernels(), index.size());
+    EXPECT_TRUE(KernelInfoIndex::validate(genBinary, genBinarySize, index));
+    EXPECT_FALSE(KernelInfoIndex::requiresEagerParsing(index));
+
+    auto serialized = KernelInfoIndex::serialize(index);
+    std::vector<KernelInfoIndexEntry> deserialized;
+    ASSERT_TRUE(KernelInfoIndex::deserialize(serialized.data(), serialized.size(), deserialized));
+    ASSERT_EQ(index.size(), deserialized.size());
+    EXPECT_EQ(0, memcmp(index.data(), deserialized.data(), index.size() * sizeof(KernelInfoIndexEntry)));
+
+    EXPECT_FALSE(KernelInfoIndex::deserialize(serialized.data(), serialized.size() - 1, deserialized));
+    serialized.back() ^= 0x1;
+    EXPECT_FALSE(KernelInfoIndex::deserialize(serialized.data(), serialized.size(), deserialized));
+
+    index[0].blobSize++;
+    EXPECT_FALSE(KernelInfoIndex::validate(genBinary, genBinarySize, index));
+    EXPECT_FALSE(KernelInfoIndex::build(genBinary, sizeof(SProgramBinaryHeader), index));
+    EXPECT_EQ(0u, index.size());
+}
+
+TEST_P(ProgramFromBinaryTest, givenStaleKernelInfoIndexWhenProgramIsBuiltLazilyThenIndexIsRebuiltFromBinary) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableLazyKernelInfoParsing.set(true);
+
+    cl_device_id device = pDevice;
+    std::vector<KernelInfoIndexEntry> staleIndex = {{0u, 1u, 0u}};
+    pProgram->setKernelInfoIndex(staleIndex);
+    retVal = pProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    ASSERT_EQ(pProgram->getNumKernels(), pProgram->getKernelInfoIndex().size());
+    EXPECT_NE(0u, pProgram->getKernelInfoIndex()[0].blobOffset);
+    EXPECT_NE(nullptr, pProgram->getKernelInfo(KernelName));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Program::getInfo( context )
 ////////////////////////////////////////////////////////////////////////////////
@@ -789,6 +903,130 @@ TEST_P(ProgramFromSourceTest, CreateWithSource_Build) {
 ////////////////////////////////////////////////////////////////////////////////
 // Program::Build (duplicate)
 ////////////////////////////////////////////////////////////////////////////////
+TEST_P(ProgramFromSourceTest, givenAsyncProgramBuildWhenBuildWithNotifyIsCalledThenBuildIsQueuedAndCompletedByWorker) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableAsyncProgramBuild.set(true);
+    auto mockBuildHandler = new MockAsyncBuildHandler();
+    auto oldHandler = pPlatform->setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(mockBuildHandler));
+
+    cl_device_id device = pPlatform->getDevice(0);
+    char data[4] = {0};
+    retVal = pProgram->build(0, nullptr, nullptr, notifyFunc, &data[0], false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(1u, mockBuildHandler->taskQueue.size());
+
+    cl_build_status buildStatus = CL_BUILD_NONE;
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BUILD_STATUS, sizeof(buildStatus), &buildStatus, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(CL_BUILD_IN_PROGRESS, buildStatus);
+
+    // rejected request must not disturb the queued build
+    retVal = pProgram->build(0, nullptr, nullptr, nullptr, nullptr, false);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    EXPECT_EQ(1u, mockBuildHandler->taskQueue.size());
+
+    EXPECT_EQ(1u, mockBuildHandler->runPendingTasks());
+    EXPECT_EQ('a', data[0]);
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BUILD_STATUS, sizeof(buildStatus), &buildStatus, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(CL_BUILD_SUCCESS, buildStatus);
+    EXPECT_EQ(static_cast<cl_uint>(CL_PROGRAM_BINARY_TYPE_EXECUTABLE), pProgram->getProgramBinaryType());
+    EXPECT_NE(nullptr, pProgram->getKernelInfo(KernelName));
+
+    pPlatform->setAsyncBuildHandler(std::move(oldHandler));
+}
+
+TEST_P(ProgramFromSourceTest, givenQueuedAsyncProgramBuildWhenProgramIsQueriedCompiledOrLinkedThenBuildInProgressIsNotTouched) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableAsyncProgramBuild.set(true);
+    auto mockBuildHandler = new MockAsyncBuildHandler();
+    auto oldHandler = pPlatform->setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(mockBuildHandler));
+
+    char data[4] = {0};
+    retVal = pProgram->build(0, nullptr, nullptr, notifyFunc, &data[0], false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    size_t paramValue[4] = {};
+    cl_program_info queries[] = {CL_PROGRAM_BINARIES, CL_PROGRAM_BINARY_SIZES, CL_PROGRAM_KERNEL_NAMES, CL_PROGRAM_NUM_KERNELS};
+    for (auto query : queries) {
+        retVal = pProgram->getInfo(query, sizeof(paramValue), paramValue, nullptr);
+        EXPECT_EQ(CL_INVALID_PROGRAM_EXECUTABLE, retVal);
+    }
+
+    retVal = pProgram->compile(0, nullptr, nullptr, 0, nullptr, nullptr, nullptr, nullptr);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    cl_program program = pProgram;
+    retVal = pProgram->link(0, nullptr, nullptr, 1, &program, nullptr, nullptr);
+    EXPECT_EQ(CL_INVALID_OPERATION, retVal);
+    EXPECT_EQ(CL_BUILD_IN_PROGRESS, pProgram->getBuildStatus());
+
+    EXPECT_EQ(1u, mockBuildHandler->runPendingTasks());
+    EXPECT_EQ(CL_BUILD_SUCCESS, pProgram->getBuildStatus());
+
+    size_t numKernels = 0;
+    retVal = pProgram->getInfo(CL_PROGRAM_NUM_KERNELS, sizeof(numKernels), &numKernels, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(0u, numKernels);
+
+    pPlatform->setAsyncBuildHandler(std::move(oldHandler));
+}
+
+TEST_P(ProgramFromSourceTest, givenQueuedAsyncProgramBuildWhenBuildInfoIsQueriedThenResultsOfPreviousBuildAreNotReturned) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableAsyncProgramBuild.set(true);
+    auto mockBuildHandler = new MockAsyncBuildHandler();
+    auto oldHandler = pPlatform->setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(mockBuildHandler));
+
+    cl_device_id device = pPlatform->getDevice(0);
+    retVal = pProgram->build(0, nullptr, nullptr, nullptr, nullptr, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    pProgram->updateBuildLog(pPlatform->getDevice(0), "previous build", sizeof("previous build"));
+
+    char data[4] = {0};
+    retVal = pProgram->build(0, nullptr, nullptr, notifyFunc, &data[0], false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    cl_program_binary_type binaryType = CL_PROGRAM_BINARY_TYPE_EXECUTABLE;
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BINARY_TYPE, sizeof(binaryType), &binaryType, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(static_cast<cl_program_binary_type>(CL_PROGRAM_BINARY_TYPE_NONE), binaryType);
+
+    size_t globalVarTotalSize = 1;
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BUILD_GLOBAL_VARIABLE_TOTAL_SIZE, sizeof(globalVarTotalSize), &globalVarTotalSize, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(0u, globalVarTotalSize);
+
+    char buildLog[64] = {'x'};
+    size_t buildLogSize = 0;
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BUILD_LOG, sizeof(buildLog), buildLog, &buildLogSize);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, buildLogSize);
+    EXPECT_STREQ("", buildLog);
+
+    EXPECT_EQ(1u, mockBuildHandler->runPendingTasks());
+    retVal = pProgram->getBuildInfo(device, CL_PROGRAM_BINARY_TYPE, sizeof(binaryType), &binaryType, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(static_cast<cl_program_binary_type>(CL_PROGRAM_BINARY_TYPE_EXECUTABLE), binaryType);
+
+    pPlatform->setAsyncBuildHandler(std::move(oldHandler));
+}
+
+TEST_P(ProgramFromSourceTest, givenAsyncProgramBuildWhenBuildIsCalledWithoutNotifyThenBuildCompletesSynchronously) {
+    DebugManagerStateRestore restorer;
+    DebugManager.flags.EnableAsyncProgramBuild.set(true);
+    auto mockBuildHandler = new MockAsyncBuildHandler();
+    auto oldHandler = pPlatform->setAsyncBuildHandler(std::unique_ptr<AsyncBuildHandler>(mockBuildHandler));
+
+    retVal = pProgram->build(0, nullptr, nullptr, nullptr, nullptr, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_TRUE(mockBuildHandler->taskQueue.empty());
+    EXPECT_EQ(0u, mockBuildHandler->openThreadCalled);
+    EXPECT_NE(nullptr, pProgram->getKernelInfo(KernelName));
+
+    pPlatform->setAsyncBuildHandler(std::move(oldHandler));
+}
+
 TEST_P(ProgramFromSourceTest, CreateWithSource_Build_Options_Duplicate) {
     KernelBinaryHelper kbHelper(BinaryFileName, false);
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/concurrency_limiter.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(ConcurrencyLimiterTest, givenNoLimitWhenManyCallersEnterThenAllEnterAndAreCounted) {
+    ConcurrencyLimiter limiter;
+    EXPECT_EQ(0u, limiter.getLimit());
+    EXPECT_TRUE(limiter.try_lock());
+    EXPECT_TRUE(limiter.try_lock());
+    limiter.lock();
+    EXPECT_EQ(3u, limiter.peekActive());
+    EXPECT_EQ(3u, limiter.peekPeakActive());
+    limiter.unlock();
+    limiter.unlock();
+    limiter.unlock();
+    EXPECT_EQ(0u, limiter.peekActive());
+    EXPECT_EQ(3u, limiter.peekPeakActive());
+    EXPECT_EQ(3u, limiter.peekTotalEntries());
+}
+
+TEST(ConcurrencyLimiterTest, givenLimitReachedWhenTryLockIsCalledThenItFailsUntilSlotIsFreed) {
+    ConcurrencyLimiter limiter(2);
+    EXPECT_TRUE(limiter.try_lock());
+    EXPECT_TRUE(limiter.try_lock());
+    EXPECT_FALSE(limiter.try_lock());
+    limiter.unlock();
+    EXPECT_TRUE(limiter.try_lock());
+    limiter.unlock();
+    limiter.unlock();
+    EXPECT_EQ(3u, limiter.peekTotalEntries());
+}
+
+TEST(ConcurrencyLimiterTest, givenLimitRaisedWhenCallerWaitsForSlotThenCallerEnters) {
+    ConcurrencyLimiter limiter(1);
+    limiter.lock();
+    std::atomic<bool> entered(false);
+    std::thread waiter([&] {
+        std::lock_guard<ConcurrencyLimiter> slot(limiter);
+        entered = true;
+    });
+    limiter.setLimit(2);
+    waiter.join();
+    EXPECT_TRUE(entered);
+    limiter.unlock();
+    EXPECT_EQ(0u, limiter.peekActive());
+}
+
+TEST(ConcurrencyLimiterTest, givenLimitWhenManyThreadsEnterConcurrentlyThenLimitIsNeverExceeded) {
+    const uint32_t limit = 2;
+    const uint32_t numThreads = 8;
+    const uint32_t iterations = 100;
+    ConcurrencyLimiter limiter(limit);
+    std::atomic<uint32_t> inside(0);
+    std::atomic<bool> limitExceeded(false);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        threads.push_back(std::thread([&] {
+            for (uint32_t i = 0; i < iterations; ++i) {
+                std::lock_guard<ConcurrencyLimiter> slot(limiter);
+                if (++inside > limit) {
+                    limitExceeded = true;
+                }
+                std::this_thread::yield();
+                --inside;
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(limitExceeded);
+    EXPECT_LE(limiter.peekPeakActive(), limit);
+    EXPECT_EQ(numThreads * iterations, limiter.peekTotalEntries());
+    EXPECT_EQ(0u, limiter.peekActive());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -42,3 +42,20 @@ TEST(Directory, GetFiles) {
     EXPECT_LT(0u, files.size());
     remove("temp_file_that_does_not_exist.tmp");
 }
+
+TEST(Directory, givenExistingFileWhenFileInfoIsQueriedThenSizeIsReturnedAndFileCanBeTouched) {
+    ofstream tempfile("temp_file_info.tmp");
+    tempfile << "data";
+    tempfile.close();
+
+    size_t size = 0;
+    uint64_t lastModificationTime = 0;
+    EXPECT_TRUE(Directory::getFileInfo("temp_file_info.tmp", size, lastModificationTime));
+    EXPECT_EQ(4u, size);
+    EXPECT_NE(0u, lastModificationTime);
+    EXPECT_TRUE(Directory::touchFile("temp_file_info.tmp"));
+    remove("temp_file_info.tmp");
+
+    EXPECT_FALSE(Directory::getFileInfo("temp_file_info.tmp", size, lastModificationTime));
+    EXPECT_FALSE(Directory::touchFile("temp_file_info.tmp"));
+}
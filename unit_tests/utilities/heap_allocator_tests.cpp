@@ -1084,3 +1084,37 @@ TEST(HeapAllocatorTest, Given10SmallAllocationsWhenMergedToBigAllocatedAsSmallNo
 
     delete heapAllocator;
 }
+
+TEST(HeapAllocatorTest, givenFragmentedHeapWhenStatisticsAreQueriedThenLargestFreeBlockAndFragmentationAreReported) {
+    void *ptrBase = reinterpret_cast<void *>(0x100000);
+    size_t size = 1024 * 4096;
+    HeapAllocatorUnderTest heapAllocator(ptrBase, size, sizeThreshold);
+
+    HeapStatistics stats;
+    heapAllocator.getStatistics(stats);
+    EXPECT_EQ(size, stats.totalSize);
+    EXPECT_EQ(size, stats.freeSize);
+    EXPECT_EQ(size, stats.largestFreeBlockSize);
+    EXPECT_EQ(0u, stats.freeChunksCount);
+    EXPECT_EQ(0.0, stats.getFragmentation());
+
+    void *ptrs[4];
+    for (auto &ptr : ptrs) {
+        size_t ptrSize = 4096;
+        ptr = heapAllocator.allocate(ptrSize);
+        ASSERT_NE(nullptr, ptr);
+    }
+    // free two non adjacent small chunks above the right bound, they can't merge with the middle block
+    heapAllocator.free(ptrs[0], 4096);
+    heapAllocator.free(ptrs[2], 4096);
+
+    heapAllocator.getStatistics(stats);
+    EXPECT_EQ(2 * 4096u, stats.usedSize);
+    EXPECT_EQ(size - 2 * 4096u, stats.freeSize);
+    EXPECT_EQ(2u, stats.freeChunksCount);
+    EXPECT_EQ(size - 4 * 4096u, stats.largestFreeBlockSize);
+    EXPECT_GT(stats.getFragmentation(), 0.0);
+
+    heapAllocator.free(ptrs[1], 4096);
+    heapAllocator.free(ptrs[3], 4096);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/intrusive_mpsc_queue.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+struct QueueNode {
+    QueueNode *next = nullptr;
+    int producer = 0;
+    int value = 0;
+};
+using TestedQueue = IntrusiveMpscQueue<QueueNode, &QueueNode::next>;
+} // namespace
+
+TEST(IntrusiveMpscQueueTest, givenEmptyQueueWhenNodeIsPushedThenPushReportsTransitionFromEmpty) {
+    TestedQueue queue;
+    QueueNode first, second;
+
+    EXPECT_TRUE(queue.peekIsEmpty());
+    EXPECT_TRUE(queue.push(first));
+    EXPECT_FALSE(queue.push(second));
+    EXPECT_FALSE(queue.peekIsEmpty());
+}
+
+TEST(IntrusiveMpscQueueTest, givenPushedNodesWhenPopAllIsCalledThenNodesAreReturnedInPushOrderAndQueueIsEmpty) {
+    TestedQueue queue;
+    QueueNode nodes[3];
+    for (auto &node : nodes) {
+        queue.push(node);
+    }
+
+    auto list = queue.popAll();
+    EXPECT_TRUE(queue.peekIsEmpty());
+    EXPECT_EQ(&nodes[0], list);
+    EXPECT_EQ(&nodes[1], list->next);
+    EXPECT_EQ(&nodes[2], list->next->next);
+    EXPECT_EQ(nullptr, list->next->next->next);
+    EXPECT_EQ(nullptr, queue.popAll());
+}
+
+TEST(IntrusiveMpscQueueTest, givenConcurrentProducersWhenConsumerPopsThenEveryNodeIsReceivedOnceInPerProducerOrder) {
+    const int producersCount = 4;
+    const int nodesPerProducer = 10000;
+    TestedQueue queue;
+    std::vector<QueueNode> nodes(producersCount * nodesPerProducer);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producersCount; p++) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < nodesPerProducer; i++) {
+                auto &node = nodes[p * nodesPerProducer + i];
+                node.producer = p;
+                node.value = i;
+                queue.push(node);
+            }
+        });
+    }
+
+    std::vector<int> lastValue(producersCount, -1);
+    int received = 0;
+    while (received < producersCount * nodesPerProducer) {
+        for (auto node = queue.popAll(); node != nullptr; node = node->next) {
+            EXPECT_EQ(lastValue[node->producer] + 1, node->value);
+            lastValue[node->producer] = node->value;
+            received++;
+        }
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.peekIsEmpty());
+}
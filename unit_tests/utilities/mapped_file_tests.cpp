@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/mapped_file.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace OCLRT;
+
+TEST(MappedFile, givenExistingFileWhenItIsMappedThenContentIsAccessibleAndWritesDoNotReachTheFile) {
+    {
+        std::ofstream file("temp_mapped_file.tmp", std::ios::binary);
+        file << "mapped";
+    }
+
+    {
+        auto mappedFile = MappedFile::open("temp_mapped_file.tmp");
+        ASSERT_NE(nullptr, mappedFile);
+        ASSERT_EQ(6u, mappedFile->size());
+        EXPECT_EQ(0, memcmp("mapped", mappedFile->data(), 6));
+
+        mappedFile->data()[0] = 'M';
+        EXPECT_EQ('M', mappedFile->data()[0]);
+    }
+
+    auto mappedFile = MappedFile::open("temp_mapped_file.tmp");
+    ASSERT_NE(nullptr, mappedFile);
+    EXPECT_EQ('m', mappedFile->data()[0]);
+    mappedFile.reset();
+
+    remove("temp_mapped_file.tmp");
+}
+
+TEST(MappedFile, givenMissingOrEmptyFileWhenItIsMappedThenNullptrIsReturned) {
+    EXPECT_EQ(nullptr, MappedFile::open("temp_mapped_file_that_does_not_exist.tmp"));
+
+    { std::ofstream file("temp_mapped_file_empty.tmp"); }
+    EXPECT_EQ(nullptr, MappedFile::open("temp_mapped_file_empty.tmp"));
+    remove("temp_mapped_file_empty.tmp");
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/read_write_lock.h"
+#include "gtest/gtest.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace OCLRT;
+
+TEST(ReadWriteLockTest, givenMultipleReadersWhenLockIsTakenSharedThenAllReadersEnter) {
+    ReadWriteLock rwLock;
+    rwLock.lock_shared();
+    rwLock.lock_shared();
+    EXPECT_EQ(2u, rwLock.peekReadersCount());
+    EXPECT_FALSE(rwLock.peekWriterActive());
+    rwLock.unlock_shared();
+    rwLock.unlock_shared();
+    EXPECT_EQ(0u, rwLock.peekReadersCount());
+}
+
+TEST(ReadWriteLockTest, givenWriterWhenLockIsTakenThenWriterIsActiveAndNoReadersAreCounted) {
+    ReadWriteLock rwLock;
+    {
+        std::unique_lock<ReadWriteLock> lock(rwLock);
+        EXPECT_TRUE(rwLock.peekWriterActive());
+        EXPECT_EQ(0u, rwLock.peekReadersCount());
+    }
+    EXPECT_FALSE(rwLock.peekWriterActive());
+    {
+        ReadLock lock(rwLock);
+        EXPECT_EQ(1u, rwLock.peekReadersCount());
+    }
+    EXPECT_EQ(0u, rwLock.peekReadersCount());
+}
+
+TEST(ReadWriteLockTest, givenActiveReaderWhenWriterTriesToLockThenWriterWaitsUntilReaderLeaves) {
+    ReadWriteLock rwLock;
+    std::atomic<bool> writerEntered(false);
+
+    rwLock.lock_shared();
+    std::thread writer([&]() {
+        std::unique_lock<ReadWriteLock> lock(rwLock);
+        writerEntered = true;
+    });
+
+    while (!rwLock.peekWriterActive()) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(writerEntered);
+
+    rwLock.unlock_shared();
+    writer.join();
+    EXPECT_TRUE(writerEntered);
+    EXPECT_FALSE(rwLock.peekWriterActive());
+}
+
+TEST(ReadWriteLockTest, givenConcurrentReadersAndWritersThenWritesAreNotLost) {
+    ReadWriteLock rwLock;
+    const int iterations = 1000;
+    const int writersCount = 4;
+    int sharedCount = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < writersCount; i++) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterations; j++) {
+                std::unique_lock<ReadWriteLock> lock(rwLock);
+                sharedCount++;
+            }
+        });
+        threads.emplace_back([&]() {
+            for (int j = 0; j < iterations; j++) {
+                ReadLock lock(rwLock);
+                EXPECT_GE(sharedCount, 0);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(writersCount * iterations, sharedCount);
+}
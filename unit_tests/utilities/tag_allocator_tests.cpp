@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, Intel Corporation
+ * Copyright (c) 2017 - 2018, Intel Corporation
  *
  * Permission is hereby granted, free of charge, to any person obtaining a
  * copy of this software and associated documentation files (the "Software"),
@@ -26,10 +26,30 @@
 #include "unit_tests/fixtures/memory_allocator_fixture.h"
 
 #include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
 
 using namespace OCLRT;
 
-typedef Test<MemoryAllocatorFixture> TagAllocatorTest;
+template <typename NodeType>
+class TagListView {
+  public:
+    using ContainsFunction = std::function<bool(NodeType &)>;
+    TagListView(ContainsFunction contains) : contains(contains) {}
+    bool peekContains(NodeType &node) {
+        return contains(node);
+    }
+
+  protected:
+    ContainsFunction contains;
+};
+
+struct TagAllocatorTest : public Test<MemoryAllocatorFixture> {
+    // free tags are kept on a lock-free stack instead of IDLists, list checks go through views of that stack
+    template <typename NodeType>
+    using IDList = TagListView<NodeType>;
+};
 
 struct timeStamps {
     uint64_t start;
@@ -47,19 +67,35 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     }
 
     TagNode<timeStamps> *getFreeTagsHead() {
-        return TagAllocator<timeStamps>::freeTags.peekHead();
+        return TagAllocator<timeStamps>::peekFreeTagsHead();
     }
 
     TagNode<timeStamps> *getUsedTagsHead() {
-        return TagAllocator<timeStamps>::usedTags.peekHead();
+        for (auto pool : tagPoolMemory) {
+            for (size_t i = 0; i < nodesPerPool; i++) {
+                if (!isOnFreeList(&pool[i])) {
+                    return &pool[i];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    TagListView<TagNode<timeStamps>> &getFreeTags() {
+        return freeTags;
     }
 
-    IDList<TagNode<timeStamps>> &getFreeTags() {
-        return TagAllocator<timeStamps>::freeTags;
+    TagListView<TagNode<timeStamps>> &getUsedTags() {
+        return usedTags;
     }
 
-    IDList<TagNode<timeStamps>> &getUsedTags() {
-        return TagAllocator<timeStamps>::usedTags;
+    bool isOnFreeList(TagNode<timeStamps> *node) {
+        for (auto current = getFreeTagsHead(); current != nullptr; current = peekNextFreeTag(current)) {
+            if (current == node) {
+                return true;
+            }
+        }
+        return false;
     }
 
     size_t getGraphicsAllocationsCount() {
@@ -69,6 +105,10 @@ class MockTagAllocator : public TagAllocator<timeStamps> {
     size_t getTagPoolCount() {
         return tagPoolMemory.size();
     }
+
+  protected:
+    TagListView<TagNode<timeStamps>> freeTags{[this](TagNode<timeStamps> &node) { return isOnFreeList(&node); }};
+    TagListView<TagNode<timeStamps>> usedTags{[this](TagNode<timeStamps> &node) { return !isOnFreeList(&node); }};
 };
 
 TEST_F(TagAllocatorTest, Initialize) {
@@ -245,3 +285,87 @@ TEST_F(TagAllocatorTest, CleanupResources) {
     EXPECT_EQ(0u, tagAllocator.getGraphicsAllocationsCount());
     EXPECT_EQ(0u, tagAllocator.getTagPoolCount());
 }
+
+TEST_F(TagAllocatorTest, givenTagPoolsToPreallocateWhenPreallocatingThenPoolsAreAllocatedUpToMaxTagPoolCount) {
+    size_t alignment = 4096;
+    MockTagAllocator<3> tagAllocator(memoryManager, 1, alignment);
+    EXPECT_EQ(1u, tagAllocator.peekTagPoolCount());
+
+    tagAllocator.preallocateTagPools(2);
+    EXPECT_EQ(2u, tagAllocator.peekTagPoolCount());
+    EXPECT_EQ(2u, tagAllocator.getGraphicsAllocationsCount());
+
+    tagAllocator.preallocateTagPools(10);
+    EXPECT_EQ(3u, tagAllocator.peekTagPoolCount());
+
+    TagNode<timeStamps> *tagNodes[3];
+    for (auto &tagNode : tagNodes) {
+        tagNode = tagAllocator.getTag();
+        ASSERT_NE(nullptr, tagNode);
+    }
+    EXPECT_EQ(nullptr, tagAllocator.getTag());
+    EXPECT_EQ(3u, tagAllocator.getGraphicsAllocationsCount());
+
+    for (auto &tagNode : tagNodes) {
+        tagAllocator.returnTag(tagNode);
+    }
+}
+
+TEST_F(TagAllocatorTest, givenMultipleThreadsWhenGettingAndReturningTagsConcurrentlyThenEachTagIsHandedOutOnce) {
+    const size_t tagsPerThread = 64;
+    const size_t threadsCount = 4;
+    MockTagAllocator<threadsCount> tagAllocator(memoryManager, tagsPerThread, 64);
+
+    std::vector<std::vector<TagNode<timeStamps> *>> tagsPerThreadNodes(threadsCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; i++) {
+        threads.push_back(std::thread([&tagAllocator, &tagsPerThreadNodes, i, tagsPerThread]() {
+            for (int iteration = 0; iteration < 100; iteration++) {
+                auto &nodes = tagsPerThreadNodes[i];
+                for (size_t j = 0; j < tagsPerThread; j++) {
+                    auto node = tagAllocator.getTag();
+                    if (node) {
+                        node->tag->start = i;
+                        nodes.push_back(node);
+                    }
+                }
+                for (auto node : nodes) {
+                    EXPECT_EQ(i, node->tag->start);
+                    tagAllocator.returnTag(node);
+                }
+                nodes.clear();
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0u, tagAllocator.peekUsedTagsCount());
+    EXPECT_LE(tagAllocator.peekTagPoolCount(), threadsCount);
+}
+
+TEST_F(TagAllocatorTest, givenUnlimitedTagAllocatorWhenAllTagsAreTakenThenNewPoolsKeepBeingAdded) {
+    // Big alignment to force only 1 tag per pool, enough pools to span several pool segments
+    size_t alignment = 4096;
+    const size_t tagsCount = 200;
+    MockTagAllocator<UnlimitedProfilingCount> tagAllocator(memoryManager, 1, alignment);
+
+    std::vector<TagNode<timeStamps> *> tagNodes;
+    for (size_t i = 0; i < tagsCount; i++) {
+        auto tagNode = tagAllocator.getTag();
+        ASSERT_NE(nullptr, tagNode);
+        tagNode->tag->start = i;
+        tagNodes.push_back(tagNode);
+    }
+    EXPECT_EQ(tagsCount, tagAllocator.peekTagPoolCount());
+    EXPECT_EQ(tagsCount, tagAllocator.peekUsedTagsCount());
+
+    for (size_t i = 0; i < tagsCount; i++) {
+        EXPECT_EQ(i, tagNodes[i]->tag->start);
+        tagAllocator.returnTag(tagNodes[i]);
+    }
+    for (size_t i = 0; i < tagsCount; i++) {
+        EXPECT_TRUE(tagAllocator.isOnFreeList(tagNodes[i]));
+    }
+}